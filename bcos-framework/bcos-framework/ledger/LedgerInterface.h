@@ -23,6 +23,7 @@
 
 #include "../protocol/Block.h"
 #include "../protocol/BlockHeader.h"
+#include "../protocol/LogBloom.h"
 #include "../protocol/Transaction.h"
 #include "../protocol/TransactionReceipt.h"
 #include "../storage/StorageInterface.h"
@@ -165,6 +166,47 @@ public:
             Error::Ptr, std::shared_ptr<std::map<protocol::BlockNumber, protocol::NonceListPtr>>)>
             _onGetList) = 0;
 
+    /**
+     * @brief async get the log bloom of a block
+     * @param _blockNumber the number of the block
+     * @param _onGetBloom callback nullopt if the ledger has no bloom of the block
+     */
+    virtual void asyncGetBlockLogBloom(protocol::BlockNumber /*_blockNumber*/,
+        std::function<void(Error::Ptr, std::optional<protocol::LogBloom>)> _onGetBloom)
+    {
+        _onGetBloom(nullptr, std::nullopt);
+    }
+
+    /**
+     * @brief async get the log blooms of the receipts of a block, to be read only for the blocks
+     * their bloom may match
+     * @param _blockNumber the number of the block
+     * @param _onGetBlooms callback nullopt if the ledger has no bloom of the receipts
+     */
+    virtual void asyncGetReceiptLogBlooms(protocol::BlockNumber /*_blockNumber*/,
+        std::function<void(Error::Ptr, std::optional<protocol::BlockLogBloom>)> _onGetBlooms)
+    {
+        _onGetBlooms(nullptr, std::nullopt);
+    }
+
+    /**
+     * @brief async get the numbers of the blocks with the logs of an address and a first topic,
+     * from the log index
+     * @param _address the address of the logs
+     * @param _topic0 the hex of the first topic of the logs, empty for the logs of any topic
+     * @param _limit the most block numbers returned, the index after them is not read
+     * @param _onGetBlocks callback the last indexed block number, -1 if the ledger has no log
+     * index, and the ascending numbers of the blocks in [_fromBlock, min(_toBlock, indexed)]
+     */
+    virtual void asyncGetIndexedLogBlocks(std::string_view /*_address*/,
+        std::string_view /*_topic0*/, protocol::BlockNumber /*_fromBlock*/,
+        protocol::BlockNumber /*_toBlock*/, size_t /*_limit*/,
+        std::function<void(Error::Ptr, protocol::BlockNumber, std::vector<protocol::BlockNumber>)>
+            _onGetBlocks)
+    {
+        _onGetBlocks(nullptr, -1, {});
+    }
+
     virtual void asyncPreStoreBlockTxs(bcos::protocol::TransactionsPtr _blockTxs,
         bcos::protocol::Block::ConstPtr block,
         std::function<void(Error::UniquePtr&&)> _callback) = 0;
@@ -67,6 +67,7 @@ constexpr static std::string_view CONSENSUS_CANDIDATE_SEALER = "consensus_candid
 constexpr static std::string_view SYS_KEY_CURRENT_NUMBER = "current_number";
 constexpr static std::string_view SYS_KEY_TOTAL_TRANSACTION_COUNT = "total_transaction_count";
 constexpr static std::string_view SYS_KEY_ARCHIVED_NUMBER = "archived_block_number";
+constexpr static std::string_view SYS_KEY_LOG_INDEXED_NUMBER = "log_indexed_block_number";
 constexpr static std::string_view SYS_KEY_TOTAL_FAILED_TRANSACTION =
     "total_failed_transaction_count";
 
@@ -81,6 +82,9 @@ constexpr static std::string_view SYS_NUMBER_2_BLOCK_HEADER{"s_number_2_header"}
 constexpr static std::string_view SYS_NUMBER_2_TXS{"s_number_2_txs"};
 constexpr static std::string_view SYS_HASH_2_TX{"s_hash_2_tx"};
 constexpr static std::string_view SYS_HASH_2_RECEIPT{"s_hash_2_receipt"};
+constexpr static std::string_view SYS_NUMBER_2_MERKLE{"s_number_2_merkle"};
+constexpr static std::string_view SYS_NUMBER_2_LOG_BLOOM{"s_number_2_log_bloom"};
+constexpr static std::string_view SYS_LOG_INDEX{"s_log_index"};
 constexpr static std::string_view DAG_TRANSFER{"/tables/dag_transfer"};
 constexpr static std::string_view SMALLBANK_TRANSFER{"/tables/smallbank_transfer"};
 constexpr static std::string_view SYS_CODE_BINARY{"s_code_binary"};
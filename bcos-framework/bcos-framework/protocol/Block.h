@@ -55,6 +55,10 @@ public:
 
     virtual bcos::crypto::HashType calculateTransactionRoot(const crypto::Hash& hashImpl) const = 0;
     virtual bcos::crypto::HashType calculateReceiptRoot(const crypto::Hash& hashImpl) const = 0;
+    // the merkle trees kept by calculateTransactionRoot and calculateReceiptRoot, in the layout of
+    // Merkle::generateMerkle, empty if not calculated
+    virtual std::vector<bcos::crypto::HashType> transactionsMerkle() const { return {}; }
+    virtual std::vector<bcos::crypto::HashType> receiptsMerkle() const { return {}; }
 
     virtual int32_t version() const = 0;
     virtual void setVersion(int32_t _version) = 0;
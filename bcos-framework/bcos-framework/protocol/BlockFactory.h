@@ -49,6 +49,11 @@ public:
 
     virtual Block::Ptr createBlock(
         bytesConstRef _data, bool _calculateHash = true, bool _checkSig = true) = 0;
+    // decode only the header and the hash list of the txs of the proposal
+    virtual Block::Ptr createBlockHeaderAndTxsHash(bytesConstRef _data)
+    {
+        return createBlock(_data, true, false);
+    }
 
     virtual TransactionMetaData::Ptr createTransactionMetaData() = 0;
     virtual TransactionMetaData::Ptr createTransactionMetaData(
@@ -0,0 +1,186 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief bloom filters over the log addresses and topics of the receipts and the blocks
+ * @file LogBloom.h
+ */
+#pragma once
+#include "LogEntry.h"
+#include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-utilities/FixedBytes.h>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bcos::protocol
+{
+
+// 2048 bits bloom, each item sets the 3 bits addressed by the first 3 pairs of bytes of its
+// keccak256 hash, the same as ethereum. The hash is keccak256 whatever the hash of the chain, the
+// bloom is a local index and not part of the consensus data
+class LogBloom
+{
+public:
+    constexpr static size_t SIZE = 256;
+    constexpr static size_t BITS_PER_ITEM = 3;
+
+    LogBloom() = default;
+    explicit LogBloom(std::string_view item)
+    {
+        bcos::crypto::hasher::openssl::OpenSSL_Keccak256_Hasher hasher;
+        hasher.update(item);
+        h256 hash;
+        hasher.final(hash);
+        for (size_t i = 0; i < BITS_PER_ITEM * 2; i += 2)
+        {
+            auto bit = (((size_t)hash[i] << 8) | hash[i + 1]) % (SIZE * 8);
+            m_bits[SIZE - 1 - bit / 8] |= (bcos::byte)(1 << (bit % 8));
+        }
+    }
+
+    // The address as it is in the log entry, the topics as their raw bytes
+    void add(LogEntry const& logEntry)
+    {
+        merge(LogBloom(logEntry.address()));
+        for (auto const& topic : logEntry.topics())
+        {
+            merge(LogBloom(std::string_view((const char*)topic.data(), topic.size())));
+        }
+    }
+    void merge(LogBloom const& other)
+    {
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            m_bits[i] |= other.m_bits[i];
+        }
+    }
+
+    // True if all the bits of the other are set, false if an item of the other is surely absent
+    bool contains(LogBloom const& other) const
+    {
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            if ((m_bits[i] & other.m_bits[i]) != other.m_bits[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool empty() const
+    {
+        return std::all_of(m_bits.begin(), m_bits.end(), [](auto bits) { return bits == 0; });
+    }
+
+    const std::array<bcos::byte, SIZE>& bits() const { return m_bits; }
+    std::array<bcos::byte, SIZE>& bits() { return m_bits; }
+
+    static std::optional<LogBloom> decode(std::string_view buffer)
+    {
+        if (buffer.size() != SIZE)
+        {
+            return {};
+        }
+        LogBloom bloom;
+        std::memcpy(bloom.m_bits.data(), buffer.data(), SIZE);
+        return bloom;
+    }
+
+private:
+    std::array<bcos::byte, SIZE> m_bits{};
+};
+
+// The bloom of a block and the blooms of its receipts which have logs, the receipts without logs
+// match nothing. Encoded as the big endian index and the bloom of each receipt with logs, in the
+// order of the receipts. The bloom of the block is stored apart, so the blocks it tells to skip
+// never load the blooms of the receipts
+class BlockLogBloom
+{
+public:
+    void addReceipt(uint32_t index, gsl::span<const LogEntry> logEntries)
+    {
+        if (logEntries.empty())
+        {
+            return;
+        }
+        LogBloom bloom;
+        for (auto const& logEntry : logEntries)
+        {
+            bloom.add(logEntry);
+        }
+        m_bloom.merge(bloom);
+        m_receipts.emplace_back(index, bloom);
+    }
+
+    const LogBloom& bloom() const { return m_bloom; }
+    // Null if the receipt has no log, the receipts must have been added in order
+    const LogBloom* receiptBloom(uint32_t index) const
+    {
+        auto it = std::lower_bound(m_receipts.begin(), m_receipts.end(), index,
+            [](auto const& receipt, uint32_t value) { return receipt.first < value; });
+        if (it == m_receipts.end() || it->first != index)
+        {
+            return nullptr;
+        }
+        return std::addressof(it->second);
+    }
+
+    bcos::bytes encode() const
+    {
+        constexpr static size_t RECEIPT_SIZE = sizeof(uint32_t) + LogBloom::SIZE;
+        bcos::bytes buffer(m_receipts.size() * RECEIPT_SIZE);
+        auto* output = buffer.data();
+        for (auto const& [index, bloom] : m_receipts)
+        {
+            auto bigEndianIndex = boost::endian::native_to_big(index);
+            std::memcpy(output, &bigEndianIndex, sizeof(bigEndianIndex));
+            std::memcpy(output + sizeof(uint32_t), bloom.bits().data(), LogBloom::SIZE);
+            output += RECEIPT_SIZE;
+        }
+        return buffer;
+    }
+
+    // The bloom of the block is merged back from the blooms of the receipts
+    static std::optional<BlockLogBloom> decode(std::string_view buffer)
+    {
+        constexpr static size_t RECEIPT_SIZE = sizeof(uint32_t) + LogBloom::SIZE;
+        if (buffer.size() % RECEIPT_SIZE != 0)
+        {
+            return {};
+        }
+        BlockLogBloom blockLogBloom;
+        auto const* input = buffer.data();
+        blockLogBloom.m_receipts.resize(buffer.size() / RECEIPT_SIZE);
+        for (auto& [index, bloom] : blockLogBloom.m_receipts)
+        {
+            std::memcpy(&index, input, sizeof(index));
+            index = boost::endian::big_to_native(index);
+            std::memcpy(bloom.bits().data(), input + sizeof(uint32_t), LogBloom::SIZE);
+            blockLogBloom.m_bloom.merge(bloom);
+            input += RECEIPT_SIZE;
+        }
+        return blockLogBloom;
+    }
+
+private:
+    LogBloom m_bloom;
+    std::vector<std::pair<uint32_t, LogBloom>> m_receipts;
+};
+}  // namespace bcos::protocol
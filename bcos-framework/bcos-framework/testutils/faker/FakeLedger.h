@@ -152,9 +152,15 @@ public:
         callback(nullptr);
     }
 
-    void asyncPreStoreBlockTxs(bcos::protocol::TransactionsPtr, bcos::protocol::Block::ConstPtr,
+    void asyncPreStoreBlockTxs(bcos::protocol::TransactionsPtr _txs,
+        bcos::protocol::Block::ConstPtr _block,
         std::function<void(Error::UniquePtr&&)> _callback) override
     {
+        if (_block && _block->blockHeaderConst())
+        {
+            WriteGuard l(x_txsHashToData);
+            m_preStoredTxs[_block->blockHeaderConst()->number()] = std::move(_txs);
+        }
         if (!_callback)
         {
             return;
@@ -346,6 +352,14 @@ public:
         return m_txsHashToData;
     }
 
+    // Note thread-safe, the txs pre-stored by the txpool for the verified proposal
+    bcos::protocol::TransactionsPtr preStoredTxs(BlockNumber _number)
+    {
+        ReadGuard l(x_txsHashToData);
+        auto it = m_preStoredTxs.find(_number);
+        return it == m_preStoredTxs.end() ? nullptr : it->second;
+    }
+
     std::vector<bytes> sealerList() { return m_sealerList; }
 
     // Consensus and block-sync module use this interface to commit block
@@ -387,6 +401,7 @@ private:
     SharedMutex x_ledger;
 
     std::map<HashType, bytesConstPtr> m_txsHashToData;
+    std::map<BlockNumber, bcos::protocol::TransactionsPtr> m_preStoredTxs;
     SharedMutex x_txsHashToData;
 
     std::map<std::string, std::string, std::less<>> m_systemConfig;
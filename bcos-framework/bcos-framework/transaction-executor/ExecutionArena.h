@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace bcos::transaction_executor
+{
+
+// Monotonic memory for the temporaries of one transaction execution at a time: the rollback
+// records, the coroutine frames of the host context and the storage wrappers. The deallocations are
+// no-ops, the memory is reclaimed at once by reset(), which must only be called when nothing
+// allocated from the arena is alive. Steady state executions fit in the initial buffer and never
+// reach the heap
+class ExecutionArena
+{
+private:
+    std::unique_ptr<std::byte[]> m_buffer;
+    std::pmr::monotonic_buffer_resource m_resource;
+
+public:
+    constexpr static size_t DEFAULT_SIZE = 256 * 1024;
+
+    explicit ExecutionArena(size_t size = DEFAULT_SIZE)
+      : m_buffer(new std::byte[size]),
+        m_resource(m_buffer.get(), size, std::pmr::new_delete_resource())
+    {}
+    ExecutionArena(const ExecutionArena&) = delete;
+    ExecutionArena(ExecutionArena&&) = delete;
+    ExecutionArena& operator=(const ExecutionArena&) = delete;
+    ExecutionArena& operator=(ExecutionArena&&) = delete;
+    ~ExecutionArena() noexcept = default;
+
+    std::pmr::memory_resource* resource() & { return std::addressof(m_resource); }
+    // Drop everything allocated, keep the initial buffer and free the overflow blocks
+    void reset() { m_resource.release(); }
+};
+
+// Arenas reused across the chunks and the blocks, so the initial buffers are allocated once per
+// concurrent chunk
+class ExecutionArenaPool
+{
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<ExecutionArena>> m_arenas;
+
+    struct Release
+    {
+        ExecutionArenaPool* m_pool;
+        void operator()(ExecutionArena* arena) const
+        {
+            arena->reset();
+            std::unique_lock lock(m_pool->m_mutex);
+            m_pool->m_arenas.emplace_back(arena);
+        }
+    };
+
+public:
+    using Arena = std::unique_ptr<ExecutionArena, Release>;
+
+    // The arena returns to the pool when released, the pool must outlive it
+    Arena acquire()
+    {
+        std::unique_lock lock(m_mutex);
+        if (m_arenas.empty())
+        {
+            lock.unlock();
+            return Arena(new ExecutionArena(), Release{this});
+        }
+        auto arena = std::move(m_arenas.back());
+        m_arenas.pop_back();
+        return Arena(arena.release(), Release{this});
+    }
+};
+}  // namespace bcos::transaction_executor
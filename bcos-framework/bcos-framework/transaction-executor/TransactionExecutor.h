@@ -12,9 +12,11 @@
 #include <bcos-task/Trait.h>
 #include <boost/container/small_vector.hpp>
 #include <compare>
+#include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace bcos::transaction_executor
 {
@@ -46,11 +48,17 @@ using StateKeyView = std::tuple<std::string_view, std::string_view>;
 using StateKey = std::tuple<SmallString, SmallString>;
 using StateValue = storage::Entry;
 
+// The executors may take a std::pmr::memory_resource* after the context id for the temporaries
+// of the execution, see ExecutionArena
 struct Execute
 {
     auto operator()(auto& executor, auto& storage, const protocol::BlockHeader& blockHeader,
         const protocol::Transaction& transaction, auto&&... args) const
         -> task::Task<protocol::TransactionReceipt::Ptr>
+        requires requires {
+            tag_invoke(*this, executor, storage, blockHeader, transaction,
+                std::forward<decltype(args)>(args)...);
+        }
     {
         co_return co_await tag_invoke(*this, executor, storage, blockHeader, transaction,
             std::forward<decltype(args)>(args)...);
@@ -58,6 +66,20 @@ struct Execute
 };
 inline constexpr Execute execute{};
 
+// Predict the keys a transaction may conflict on from its calldata, return nullopt if the touched
+// keys can't be derived without executing it
+struct PredictConflictKeys
+{
+    auto operator()(auto& executor, const protocol::Transaction& transaction) const
+        -> decltype(tag_invoke(*this, executor, transaction))
+        requires std::same_as<decltype(tag_invoke(*this, executor, transaction)),
+            std::optional<std::vector<StateKey>>>
+    {
+        return tag_invoke(*this, executor, transaction);
+    }
+};
+inline constexpr PredictConflictKeys predictConflictKeys{};
+
 template <auto& Tag>
 using tag_t = std::decay_t<decltype(Tag)>;
 }  // namespace bcos::transaction_executor
@@ -0,0 +1,84 @@
+#include <bcos-framework/protocol/LogBloom.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::protocol;
+
+struct LogBloomTestFixture
+{
+};
+
+BOOST_FIXTURE_TEST_SUITE(LogBloomTest, LogBloomTestFixture)
+
+BOOST_AUTO_TEST_CASE(bloom)
+{
+    LogBloom empty;
+    BOOST_CHECK(empty.empty());
+
+    std::string address = "e0e794ca86d198042b64285c5ce667aee747509b";
+    auto topic = h256::generateRandomFixedBytes();
+    LogEntry logEntry(bytes(address.begin(), address.end()), {topic}, {});
+    LogBloom bloom;
+    bloom.add(logEntry);
+    BOOST_CHECK(!bloom.empty());
+    BOOST_CHECK(bloom.contains(LogBloom(address)));
+    BOOST_CHECK(
+        bloom.contains(LogBloom(std::string_view((const char*)topic.data(), topic.size()))));
+    BOOST_CHECK(bloom.contains(empty));
+    BOOST_CHECK(!empty.contains(LogBloom(address)));
+
+    // At most 3 bits per item
+    LogBloom addressBloom(address);
+    size_t bits = 0;
+    for (auto byte : addressBloom.bits())
+    {
+        bits += __builtin_popcount(byte);
+    }
+    BOOST_CHECK_GE(bits, 1);
+    BOOST_CHECK_LE(bits, LogBloom::BITS_PER_ITEM);
+}
+
+BOOST_AUTO_TEST_CASE(blockBloom)
+{
+    std::string address1 = "e0e794ca86d198042b64285c5ce667aee747509b";
+    std::string address2 = "0102e8b6fc8cdf9626fddc1c3ea8c1e79b3fce94";
+    LogEntries logEntries1{LogEntry(bytes(address1.begin(), address1.end()), {}, {})};
+    LogEntries logEntries2{LogEntry(bytes(address2.begin(), address2.end()), {}, {})};
+
+    BlockLogBloom blockLogBloom;
+    blockLogBloom.addReceipt(0, {});
+    blockLogBloom.addReceipt(1, logEntries1);
+    blockLogBloom.addReceipt(2, {});
+    blockLogBloom.addReceipt(3, logEntries2);
+
+    auto buffer = blockLogBloom.encode();
+    BOOST_CHECK_EQUAL(buffer.size(), 2 * (sizeof(uint32_t) + LogBloom::SIZE));
+    auto decoded =
+        BlockLogBloom::decode(std::string_view((const char*)buffer.data(), buffer.size()));
+    BOOST_REQUIRE(decoded);
+    BOOST_CHECK(decoded->bloom().bits() == blockLogBloom.bloom().bits());
+    BOOST_CHECK(decoded->bloom().contains(LogBloom(address1)));
+    BOOST_CHECK(decoded->bloom().contains(LogBloom(address2)));
+
+    BOOST_CHECK(!decoded->receiptBloom(0));
+    BOOST_CHECK(!decoded->receiptBloom(2));
+    BOOST_CHECK(!decoded->receiptBloom(4));
+    BOOST_REQUIRE(decoded->receiptBloom(1));
+    BOOST_REQUIRE(decoded->receiptBloom(3));
+    BOOST_CHECK(decoded->receiptBloom(1)->contains(LogBloom(address1)));
+    BOOST_CHECK(decoded->receiptBloom(3)->contains(LogBloom(address2)));
+
+    BOOST_CHECK(!BlockLogBloom::decode(
+        std::string_view((const char*)buffer.data(), buffer.size() - 1)));
+    BOOST_REQUIRE(BlockLogBloom::decode({}));
+    BOOST_CHECK(BlockLogBloom::decode({})->bloom().empty());
+
+    // the bloom of the block is stored apart
+    auto const& bits = blockLogBloom.bloom().bits();
+    auto bloom = LogBloom::decode(std::string_view((const char*)bits.data(), bits.size()));
+    BOOST_REQUIRE(bloom);
+    BOOST_CHECK(bloom->bits() == bits);
+    BOOST_CHECK(!LogBloom::decode(std::string_view((const char*)bits.data(), bits.size() - 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
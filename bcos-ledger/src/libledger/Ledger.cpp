@@ -22,11 +22,13 @@
  */
 
 #include "Ledger.h"
+#include "LogIndexer.h"
 #include "bcos-framework/ledger/Features.h"
 #include "bcos-framework/storage/StorageInvokes.h"
 #include "bcos-tool/VersionConverter.h"
 #include "bcos-utilities/Common.h"
 #include "utilities/Common.h"
+#include "utilities/MerkleTree.h"
 #include <bcos-codec/scale/Scale.h>
 #include <bcos-concepts/Basic.h>
 #include <bcos-concepts/ByteBuffer.h>
@@ -52,6 +54,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/lexical_cast/bad_lexical_cast.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <cstddef>
 #include <future>
 #include <memory>
@@ -152,10 +155,10 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     auto blockNumberStr = boost::lexical_cast<std::string>(header->number());
 
 
-    size_t TOTAL_CALLBACK = 8;
+    size_t TOTAL_CALLBACK = 12;
     if (writeTxsAndReceipts)
-    {  // 9 storage callbacks and write hash=>tx
-        TOTAL_CALLBACK = 9;
+    {  // 13 storage callbacks and write hash=>tx
+        TOTAL_CALLBACK = 13;
     }
     auto setRowCallback = [total = std::make_shared<std::atomic<size_t>>(TOTAL_CALLBACK),
                               failed = std::make_shared<bool>(false),
@@ -275,6 +278,84 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     storage->asyncSetRow(SYS_NUMBER_2_TXS, blockNumberStr, std::move(number2TransactionHashesEntry),
         [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
 
+    // number 2 merkle trees, for the transaction and receipt proofs. The trees kept by the block
+    // when the scheduler calculated its roots are reused
+    auto setMerkleTree = [&](bool isTransaction, auto const& leaves, std::vector<h256> tree,
+                             const h256& root) {
+        auto rows = encodeMerkleTree(header->number(), isTransaction, leaves, tree, root);
+        if (rows.empty() && !RANGES::empty(leaves))
+        {
+            auto hasher = m_blockFactory->cryptoSuite()->hashImpl()->hasher();
+            bcos::crypto::merkle::Merkle<decltype(hasher)> merkle(std::move(hasher));
+            merkle.generateMerkle(leaves, tree);
+            rows = encodeMerkleTree(header->number(), isTransaction, leaves, tree, root);
+        }
+        if (rows.empty())
+        {
+            setRowCallback({});
+            return;
+        }
+        // counted as one callback when all the rows of the tree are written
+        auto pending = std::make_shared<std::atomic<size_t>>(rows.size());
+        for (auto& [key, value] : rows)
+        {
+            Entry merkleTreeEntry;
+            merkleTreeEntry.set(std::move(value));
+            storage->asyncSetRow(SYS_NUMBER_2_MERKLE, key, std::move(merkleTreeEntry),
+                [setRowCallback, pending](auto&& error) {
+                    if (error)
+                    {
+                        setRowCallback(std::forward<decltype(error)>(error), 0);
+                    }
+                    if (--(*pending) == 0)
+                    {
+                        setRowCallback({});
+                    }
+                });
+        }
+    };
+    setMerkleTree(true,
+        RANGES::iota_view<size_t, size_t>(0LU, transactionsBlock->transactionsMetaDataSize()) |
+            RANGES::views::transform([&transactionsBlock](size_t index) {
+                return transactionsBlock->transactionHash(index);
+            }),
+        block->transactionsMerkle(), header->txsRoot());
+    std::vector<h256> receiptHashes(block->receiptsSize());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, block->receiptsSize(), 256),
+        [&block, &receiptHashes](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i)
+            {
+                receiptHashes[i] = block->receipt(i)->hash();
+            }
+        });
+    setMerkleTree(false, receiptHashes, block->receiptsMerkle(), header->receiptsRoot());
+
+    // number 2 log bloom, for the event subscriptions and the log queries to skip the blocks
+    protocol::BlockLogBloom blockLogBloom;
+    for (size_t i = 0; i < block->receiptsSize(); ++i)
+    {
+        blockLogBloom.addReceipt(i, block->receipt(i)->logEntries());
+    }
+    Entry logBloomEntry;
+    auto const& bloomBits = blockLogBloom.bloom().bits();
+    logBloomEntry.set(std::string_view((const char*)bloomBits.data(), bloomBits.size()));
+    storage->asyncSetRow(SYS_NUMBER_2_LOG_BLOOM, blockNumberStr, std::move(logBloomEntry),
+        [setRowCallback](auto&& error) { setRowCallback(std::forward<decltype(error)>(error)); });
+    // the blocks without log are skipped by their empty bloom, no receipt bloom is stored
+    if (blockLogBloom.bloom().empty())
+    {
+        setRowCallback({});
+    }
+    else
+    {
+        Entry receiptLogBloomEntry;
+        receiptLogBloomEntry.set(blockLogBloom.encode());
+        storage->asyncSetRow(SYS_NUMBER_2_LOG_BLOOM, receiptLogBloomKey(blockNumberStr),
+            std::move(receiptLogBloomEntry), [setRowCallback](auto&& error) {
+                setRowCallback(std::forward<decltype(error)>(error));
+            });
+    }
+
     std::atomic_int64_t totalCount = 0;
     std::atomic_int64_t failedCount = 0;
     if (writeTxsAndReceipts)
@@ -1486,7 +1567,7 @@ static std::vector<h256> getMerkleTreeFromCache(int64_t blockNumber, Ledger::Cac
 void Ledger::getTxProof(
     const HashType& _txHash, std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
-    // txHash->receipt receipt->number number->txHash
+    // txHash->receipt receipt->number number->merkle tree
     asyncGetTransactionReceiptByHash(_txHash, false,
         [this, _txHash, _onGetProof = std::move(_onGetProof)](
             Error::Ptr _error, TransactionReceipt::ConstPtr _receipt, const MerkleProofPtr&) {
@@ -1499,51 +1580,66 @@ void Ledger::getTxProof(
                 return;
             }
             auto blockNumber = _receipt->blockNumber();
-            asyncGetBlockTransactionHashes(
-                blockNumber, [this, _onGetProof, _txHash = std::move(_txHash), blockNumber](
-                                 Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
-                    if (_error || _hashList.empty())
+            asyncGetStoredMerkleProof(blockNumber, true, _txHash,
+                [this, _txHash, blockNumber, _onGetProof](MerkleProofPtr&& proof) {
+                    if (proof)
+                    {
+                        _onGetProof(nullptr, std::move(proof));
+                        return;
+                    }
+                    getTxProofFromTransactions(blockNumber, _txHash, _onGetProof);
+                });
+        });
+}
+
+void Ledger::getTxProofFromTransactions(protocol::BlockNumber blockNumber,
+    const HashType& _txHash, std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
+{
+    // number->txHash txHash->txs, for the blocks committed without a stored merkle tree
+    asyncGetBlockTransactionHashes(
+        blockNumber, [this, _onGetProof, _txHash = std::move(_txHash), blockNumber](
+                         Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
+            if (_error || _hashList.empty())
+            {
+                LEDGER_LOG(DEBUG)
+                    << LOG_BADGE("getTxProof")
+                    << LOG_DESC("asyncGetBlockTransactionHashes from storage failed")
+                    << LOG_KV("txHash", _txHash.hex());
+                _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
+                return;
+            }
+            asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
+                [this, cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
+                    _txHash = std::move(_txHash), blockNumber](
+                    Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
+                    if (_error || _txList.empty())
                     {
                         LEDGER_LOG(DEBUG)
-                            << LOG_BADGE("getTxProof")
-                            << LOG_DESC("asyncGetBlockTransactionHashes from storage failed")
-                            << LOG_KV("txHash", _txHash.hex());
+                            << LOG_BADGE("getTxProof") << LOG_DESC("getTxs callback failed")
+                            << LOG_KV("code", _error->errorCode())
+                            << LOG_KV("msg", _error->errorMessage());
                         _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                         return;
                     }
-                    asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
-                        [this, cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
-                            _txHash = std::move(_txHash), blockNumber](
-                            Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
-                            if (_error || _txList.empty())
-                            {
-                                LEDGER_LOG(DEBUG)
-                                    << LOG_BADGE("getTxProof") << LOG_DESC("getTxs callback failed")
-                                    << LOG_KV("code", _error->errorCode())
-                                    << LOG_KV("msg", _error->errorMessage());
-                                _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
-                                return;
-                            }
-                            auto merkleProofPtr = std::make_shared<MerkleProof>();
-                            bcos::crypto::merkle::Merkle merkle(cryptoSuite->hashImpl()->hasher());
-                            auto hashesRange =
-                                _txList |
-                                RANGES::views::transform([](const Transaction::Ptr& transaction) {
-                                    return transaction->hash();
-                                });
-
-                            auto merkleTree =
-                                getMerkleTreeFromCache(blockNumber, m_txProofMerkleCache,
-                                    m_txMerkleMtx, "getTxProof", merkle, hashesRange);
-                            merkle.template generateMerkleProof(
-                                hashesRange, merkleTree, _txHash, *merkleProofPtr);
-
-                            LEDGER_LOG(TRACE)
-                                << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
-                                << LOG_KV("txHash", _txHash.hex());
-
-                            _onGetProof(nullptr, std::move(merkleProofPtr));
+                    auto merkleProofPtr = std::make_shared<MerkleProof>();
+                    bcos::crypto::merkle::Merkle merkle(cryptoSuite->hashImpl()->hasher());
+                    auto hashesRange =
+                        _txList |
+                        RANGES::views::transform([](const Transaction::Ptr& transaction) {
+                            return transaction->hash();
                         });
+
+                    auto merkleTree =
+                        getMerkleTreeFromCache(blockNumber, m_txProofMerkleCache,
+                            m_txMerkleMtx, "getTxProof", merkle, hashesRange);
+                    merkle.template generateMerkleProof(
+                        hashesRange, merkleTree, _txHash, *merkleProofPtr);
+
+                    LEDGER_LOG(TRACE)
+                        << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
+                        << LOG_KV("txHash", _txHash.hex());
+
+                    _onGetProof(nullptr, std::move(merkleProofPtr));
                 });
         });
 }
@@ -1551,10 +1647,27 @@ void Ledger::getTxProof(
 void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
     std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
-    // receipt->number number->txs txs->receipts
+    // receipt->number number->merkle tree
     auto blockNumber = _receipt->blockNumber();
+    auto receiptHash = _receipt->hash();
+    asyncGetStoredMerkleProof(blockNumber, false, receiptHash,
+        [this, blockNumber, receiptHash, _onGetProof = std::move(_onGetProof)](
+            MerkleProofPtr&& proof) {
+            if (proof)
+            {
+                _onGetProof(nullptr, std::move(proof));
+                return;
+            }
+            getReceiptProofFromReceipts(blockNumber, receiptHash, _onGetProof);
+        });
+}
+
+void Ledger::getReceiptProofFromReceipts(protocol::BlockNumber blockNumber,
+    const HashType& receiptHash, std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
+{
+    // number->txs txs->receipts, for the blocks committed without a stored merkle tree
     asyncGetBlockTransactionHashes(blockNumber,
-        [this, _onGetProof = std::move(_onGetProof), receiptHash = _receipt->hash(), blockNumber](
+        [this, _onGetProof = std::move(_onGetProof), receiptHash, blockNumber](
             Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
             if (_error)
             {
@@ -1594,6 +1707,158 @@ void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
         });
 }
 
+void Ledger::asyncGetStoredMerkleProof(protocol::BlockNumber blockNumber, bool isTransaction,
+    const HashType& hash, std::function<void(MerkleProofPtr&&)> callback)
+{
+    // the count of the leaves, the index of the leaf in its bucket, then a chunk per level
+    m_storage->asyncGetRow(SYS_NUMBER_2_MERKLE, merkleTreeKey(blockNumber, isTransaction),
+        [this, blockNumber, isTransaction, hash, callback = std::move(callback)](
+            Error::UniquePtr error, std::optional<Entry> entry) mutable {
+            std::optional<uint32_t> leafCount;
+            if (error || !entry || !(leafCount = decodeMerkleLeafCount(entry->get())))
+            {
+                callback(nullptr);
+                return;
+            }
+            m_storage->asyncGetRow(SYS_NUMBER_2_MERKLE,
+                merkleIndexKey(blockNumber, isTransaction, merkleBucket(hash, *leafCount)),
+                [this, blockNumber, isTransaction, hash, leafCount = *leafCount,
+                    callback = std::move(callback)](
+                    Error::UniquePtr error, std::optional<Entry> entry) mutable {
+                    std::optional<uint32_t> index;
+                    if (error || !entry || !(index = findMerkleLeafIndex(entry->get(), hash)))
+                    {
+                        LEDGER_LOG(WARNING) << LOG_BADGE("asyncGetStoredMerkleProof")
+                                            << LOG_DESC("Not found in the stored merkle tree")
+                                            << LOG_KV("hash", hash.hex());
+                        callback(nullptr);
+                        return;
+                    }
+                    auto keys = std::make_shared<std::vector<std::string>>(
+                        merkleProofKeys(blockNumber, isTransaction, leafCount, *index));
+                    std::vector<std::string_view> keysView(keys->begin(), keys->end());
+                    m_storage->asyncGetRows(SYS_NUMBER_2_MERKLE, keysView,
+                        [keys, leafCount, index = *index, callback = std::move(callback)](
+                            Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+                            if (error)
+                            {
+                                callback(nullptr);
+                                return;
+                            }
+                            auto rows = entries |
+                                        RANGES::views::transform(
+                                            [](std::optional<Entry> const& entry)
+                                                -> std::optional<std::string_view> {
+                                                if (!entry)
+                                                {
+                                                    return {};
+                                                }
+                                                return entry->get();
+                                            }) |
+                                        RANGES::to<std::vector>();
+                            callback(generateMerkleProof(leafCount, index, rows));
+                        });
+                });
+        });
+}
+
+template <class Bloom>
+static void asyncGetLogBloomRow(bcos::storage::StorageInterface& storage,
+    protocol::BlockNumber blockNumber, std::string key,
+    std::function<void(Error::Ptr, std::optional<Bloom>)> callback)
+{
+    storage.asyncGetRow(SYS_NUMBER_2_LOG_BLOOM, key,
+        [blockNumber, callback = std::move(callback)](
+            Error::UniquePtr error, std::optional<Entry> entry) {
+            if (error)
+            {
+                LEDGER_LOG(WARNING) << LOG_BADGE("asyncGetLogBloom")
+                                    << LOG_KV("blockNumber", blockNumber)
+                                    << LOG_KV("message", error->errorMessage());
+                callback(BCOS_ERROR_WITH_PREV_PTR(
+                             LedgerError::GetStorageError, "Get log bloom failed", *error),
+                    std::nullopt);
+                return;
+            }
+            // The blocks committed before the blooms were stored have none
+            if (!entry)
+            {
+                callback(nullptr, std::nullopt);
+                return;
+            }
+            callback(nullptr, Bloom::decode(entry->get()));
+        });
+}
+
+void Ledger::asyncGetBlockLogBloom(protocol::BlockNumber _blockNumber,
+    std::function<void(Error::Ptr, std::optional<protocol::LogBloom>)> _onGetBloom)
+{
+    asyncGetLogBloomRow<protocol::LogBloom>(*m_storage, _blockNumber,
+        boost::lexical_cast<std::string>(_blockNumber), std::move(_onGetBloom));
+}
+
+void Ledger::asyncGetReceiptLogBlooms(protocol::BlockNumber _blockNumber,
+    std::function<void(Error::Ptr, std::optional<protocol::BlockLogBloom>)> _onGetBlooms)
+{
+    asyncGetLogBloomRow<protocol::BlockLogBloom>(*m_storage, _blockNumber,
+        receiptLogBloomKey(boost::lexical_cast<std::string>(_blockNumber)),
+        std::move(_onGetBlooms));
+}
+
+void Ledger::asyncGetIndexedLogBlocks(std::string_view _address, std::string_view _topic0,
+    protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock, size_t _limit,
+    std::function<void(Error::Ptr, protocol::BlockNumber, std::vector<protocol::BlockNumber>)>
+        _onGetBlocks)
+{
+    asyncGetCurrentStateByKey(SYS_KEY_LOG_INDEXED_NUMBER,
+        [this, address = std::string(_address), topic0 = std::string(_topic0), _fromBlock,
+            _toBlock, _limit, callback = std::move(_onGetBlocks)](
+            Error::Ptr&& error, std::optional<bcos::storage::Entry>&& entry) mutable {
+            if (error)
+            {
+                callback(std::move(error), -1, {});
+                return;
+            }
+            // The logs are not indexed
+            if (!entry)
+            {
+                callback(nullptr, -1, {});
+                return;
+            }
+            protocol::BlockNumber indexedNumber = -1;
+            try
+            {
+                indexedNumber = boost::lexical_cast<protocol::BlockNumber>(entry->get());
+            }
+            catch (boost::bad_lexical_cast const&)
+            {
+                LEDGER_LOG(WARNING) << LOG_BADGE("asyncGetIndexedLogBlocks")
+                                    << LOG_DESC("invalid log indexed number")
+                                    << LOG_KV("value", entry->get());
+                callback(nullptr, -1, {});
+                return;
+            }
+            auto toBlock = std::min(_toBlock, indexedNumber);
+            if (_fromBlock > toBlock)
+            {
+                callback(nullptr, indexedNumber, {});
+                return;
+            }
+            auto [getError, blockNumbers] = LogIndexer::getBlockNumbers(
+                *m_storage, address, topic0, _fromBlock, toBlock, _limit);
+            if (getError)
+            {
+                LEDGER_LOG(WARNING) << LOG_BADGE("asyncGetIndexedLogBlocks")
+                                    << LOG_KV("message", getError->errorMessage());
+                callback(BCOS_ERROR_WITH_PREV_PTR(
+                             LedgerError::GetStorageError, "Get log index failed", *getError),
+                    indexedNumber, {});
+                return;
+            }
+            callback(nullptr, indexedNumber, std::move(blockNumbers));
+        });
+}
+
 // sync method
 bool Ledger::buildGenesisBlock(LedgerConfig::Ptr _ledgerConfig, size_t _gasLimit,
     const std::string_view& _genesisData, std::string const& _compatibilityVersion,
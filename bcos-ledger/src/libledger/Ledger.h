@@ -107,6 +107,18 @@ public:
         std::function<void(Error::Ptr&&, std::optional<bcos::storage::Entry>&&)> _callback)
         override;
 
+    void asyncGetBlockLogBloom(protocol::BlockNumber _blockNumber,
+        std::function<void(Error::Ptr, std::optional<protocol::LogBloom>)> _onGetBloom) override;
+
+    void asyncGetReceiptLogBlooms(protocol::BlockNumber _blockNumber,
+        std::function<void(Error::Ptr, std::optional<protocol::BlockLogBloom>)> _onGetBlooms)
+        override;
+
+    void asyncGetIndexedLogBlocks(std::string_view _address, std::string_view _topic0,
+        protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock, size_t _limit,
+        std::function<void(Error::Ptr, protocol::BlockNumber, std::vector<protocol::BlockNumber>)>
+            _onGetBlocks) override;
+
     /****** init ledger ******/
     bool buildGenesisBlock(LedgerConfig::Ptr _ledgerConfig, size_t _gasLimit,
         const std::string_view& _genesisData, std::string const& _compatibilityVersion,
@@ -137,9 +149,22 @@ private:
     void getTxProof(const crypto::HashType& _txHash,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
+    void getTxProofFromTransactions(protocol::BlockNumber blockNumber,
+        const crypto::HashType& _txHash,
+        std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
+
     void getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
+    void getReceiptProofFromReceipts(protocol::BlockNumber blockNumber,
+        const crypto::HashType& receiptHash,
+        std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
+
+    // The proof from the merkle tree stored when the block was committed, null if the block has no
+    // stored tree
+    void asyncGetStoredMerkleProof(protocol::BlockNumber blockNumber, bool isTransaction,
+        const crypto::HashType& hash, std::function<void(MerkleProofPtr&&)> callback);
+
     void asyncGetSystemTableEntry(const std::string_view& table, const std::string_view& key,
         std::function<void(Error::Ptr&&, std::optional<bcos::storage::Entry>&&)> callback);
 
@@ -167,7 +192,7 @@ private:
     mutable RecursiveMutex m_mutex;
     std::shared_ptr<bcos::ThreadPool> m_threadPool;
 
-    // Maintain merkle trees of 100 blocks
+    // Maintain merkle trees of 100 blocks, for the blocks without a stored merkle tree
     int m_merkleTreeCacheSize;
     RecursiveMutex m_txMerkleMtx;
     RecursiveMutex m_receiptMerkleMtx;
@@ -5,7 +5,9 @@
 #include "bcos-framework/protocol/ProtocolTypeDef.h"
 #include "bcos-tool/ConsensusNode.h"
 #include "bcos-utilities/Common.h"
+#include "utilities/MerkleTree.h"
 #include <bcos-framework/ledger/LedgerConfig.h>
+#include <bcos-framework/protocol/LogBloom.h>
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <boost/container/small_vector.hpp>
 #include <boost/throw_exception.hpp>
@@ -132,7 +134,45 @@ private:
             transaction_executor::StateKey{SYS_NUMBER_2_TXS, blockNumberKey},
             std::move(number2TransactionHashesEntry));
 
-        co_return;
+        co_await setMerkleTree(storage, block.blockHeaderConst()->number(), true,
+            RANGES::iota_view<size_t, size_t>(0LU, transactionsBlock->transactionsMetaDataSize()) |
+                RANGES::views::transform([&transactionsBlock](uint64_t index) {
+                    return transactionsBlock->transactionHash(index);
+                }),
+            block.transactionsMerkle(), block.blockHeaderConst()->txsRoot());
+    }
+
+    // Persist a merkle tree of the block for the transaction and receipt proofs, the tree kept
+    // by the block when its root was calculated is reused
+    task::Task<void> setMerkleTree(auto& storage, protocol::BlockNumber blockNumber,
+        bool isTransaction, RANGES::random_access_range auto const& leaves,
+        std::vector<h256> tree, const h256& root)
+    {
+        auto rows = encodeMerkleTree(blockNumber, isTransaction, leaves, tree, root);
+        if (rows.empty() && !RANGES::empty(leaves))
+        {
+            auto hasher = m_blockFactory.cryptoSuite()->hashImpl()->hasher();
+            bcos::crypto::merkle::Merkle<decltype(hasher)> merkle(std::move(hasher));
+            merkle.generateMerkle(leaves, tree);
+            rows = encodeMerkleTree(blockNumber, isTransaction, leaves, tree, root);
+        }
+        if (rows.empty())
+        {
+            LEDGER2_LOG(DEBUG) << "Merkle tree not stored, empty or mismatched root"
+                               << LOG_KV("number", blockNumber)
+                               << LOG_KV("isTransaction", isTransaction);
+            co_return;
+        }
+
+        co_await storage2::writeSome(storage,
+            rows | RANGES::views::transform([](auto const& row) {
+                return transaction_executor::StateKey{SYS_NUMBER_2_MERKLE, std::get<0>(row)};
+            }),
+            rows | RANGES::views::transform([](auto& row) {
+                bcos::storage::Entry entry;
+                entry.set(std::move(std::get<1>(row)));
+                return entry;
+            }));
     }
 
     template <std::same_as<concepts::ledger::TRANSACTIONS>>
@@ -170,6 +210,7 @@ private:
         std::atomic_size_t failedTransactionCount = 0;
         std::vector<bcos::h256> hashes(block.receiptsSize());
         std::vector<std::vector<bcos::byte>> buffers(block.receiptsSize());
+        std::vector<bcos::h256> receiptHashes(block.receiptsSize());
 
         auto setData = [&](auto getHashFunc) {
             tbb::parallel_for(
@@ -179,6 +220,7 @@ private:
                         hashes[i] = getHashFunc(i);
                         auto receipt = block.receipt(i);
                         bcos::concepts::serialize::encode(*receipt, buffers[i]);
+                        receiptHashes[i] = receipt->hash();
 
                         if (receipt->status() != 0)
                         {
@@ -197,6 +239,30 @@ private:
             setData([&](size_t index) { return block.transaction(index)->hash(); });
         }
         co_await setTransactions<false>(storage, hashes, buffers);
+        co_await setMerkleTree(storage, block.blockHeaderConst()->number(), false, receiptHashes,
+            block.receiptsMerkle(), block.blockHeaderConst()->receiptsRoot());
+
+        protocol::BlockLogBloom blockLogBloom;
+        for (size_t i = 0; i < block.receiptsSize(); ++i)
+        {
+            blockLogBloom.addReceipt(i, block.receipt(i)->logEntries());
+        }
+        bcos::storage::Entry logBloomEntry;
+        auto const& bloomBits = blockLogBloom.bloom().bits();
+        logBloomEntry.set(std::string_view((const char*)bloomBits.data(), bloomBits.size()));
+        co_await storage2::writeOne(storage,
+            transaction_executor::StateKey{SYS_NUMBER_2_LOG_BLOOM, blockNumberKey},
+            std::move(logBloomEntry));
+        // the blocks without log are skipped by their empty bloom, no receipt bloom is stored
+        if (!blockLogBloom.bloom().empty())
+        {
+            bcos::storage::Entry receiptLogBloomEntry;
+            receiptLogBloomEntry.set(blockLogBloom.encode());
+            co_await storage2::writeOne(storage,
+                transaction_executor::StateKey{
+                    SYS_NUMBER_2_LOG_BLOOM, receiptLogBloomKey(blockNumberKey)},
+                std::move(receiptLogBloomEntry));
+        }
 
         LEDGER2_LOG(DEBUG) << LOG_DESC("Calculate tx counts in block")
                            << LOG_KV("number", blockNumberKey)
@@ -399,6 +465,23 @@ public:
         co_return status;
     }
 
+    // Header of the block, nullptr if the block is not in the ledger
+    task::Task<protocol::BlockHeader::Ptr> getBlockHeader(protocol::BlockNumber blockNumber)
+    {
+        LEDGER2_LOG(TRACE) << "getBlockHeader: " << blockNumber;
+        auto blockNumberStr = boost::lexical_cast<std::string>(blockNumber);
+        auto entry = co_await storage2::readOne(m_storage,
+            transaction_executor::StateKey{SYS_NUMBER_2_BLOCK_HEADER, blockNumberStr});
+        if (!entry)
+        {
+            co_return nullptr;
+        }
+
+        auto view = entry->get();
+        co_return m_blockFactory.blockHeaderFactory()->createBlockHeader(
+            bytesConstRef((const bcos::byte*)view.data(), view.size()));
+    }
+
     template <bool isTransaction>
     task::Task<std::vector<decltype(m_transactionFactory->createTransaction(
         std::declval<bytesConstRef>(), false, false))>>
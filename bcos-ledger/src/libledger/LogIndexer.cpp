@@ -0,0 +1,343 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LogIndexer.cpp
+ */
+
+#include "LogIndexer.h"
+#include "utilities/Common.h"
+#include <bcos-framework/ledger/LedgerTypeDef.h>
+#include <bcos-utilities/BoostLog.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <charconv>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::ledger;
+using namespace bcos::protocol;
+using namespace bcos::storage;
+
+namespace
+{
+constexpr static char c_keySplit = '|';
+constexpr static size_t c_blockNumberWidth = 16;
+constexpr static size_t c_indexWidth = 8;
+// the suffix of a key after its topic0: |blockNumber|txIndex|logIndex
+constexpr static size_t c_keySuffixSize =
+    1 + c_blockNumberWidth + 1 + c_indexWidth + 1 + c_indexWidth;
+// the wait of the worker when there is no block to index or indexing failed
+constexpr static unsigned c_idleWaitMs = 1000;
+
+void appendHex(std::string& _out, uint64_t _value, size_t _width)
+{
+    constexpr static std::string_view digits = "0123456789abcdef";
+    for (auto i = _width; i > 0; --i)
+    {
+        _out.push_back(digits[(_value >> ((i - 1) * 4)) & 0xf]);
+    }
+}
+}  // namespace
+
+void LogIndexer::start()
+{
+    if (m_running.exchange(true))
+    {
+        LEDGER_LOG(INFO) << LOG_BADGE("LogIndexer") << LOG_DESC("log indexer is running");
+        return;
+    }
+    auto error = init();
+    if (error)
+    {
+        // the indexing restarts from the genesis block, which writes the same keys
+        LEDGER_LOG(WARNING) << LOG_BADGE("LogIndexer") << LOG_DESC("get indexed number failed")
+                            << LOG_KV("message", error->errorMessage());
+    }
+    m_ledger->asyncGetBlockNumber([this](Error::Ptr _error, BlockNumber _blockNumber) {
+        if (!_error)
+        {
+            notifyBlockNumber(_blockNumber);
+        }
+    });
+    startWorking();
+    LEDGER_LOG(INFO) << LOG_BADGE("LogIndexer") << LOG_DESC("start log indexer")
+                     << LOG_KV("indexedNumber", m_indexedNumber.load())
+                     << LOG_KV("blockNumber", m_blockNumber.load());
+}
+
+void LogIndexer::stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+    finishWorker();
+    stopWorking();
+    // will not restart worker, so terminate it
+    terminate();
+    LEDGER_LOG(INFO) << LOG_BADGE("LogIndexer") << LOG_DESC("stop log indexer")
+                     << LOG_KV("indexedNumber", m_indexedNumber.load());
+}
+
+void LogIndexer::notifyBlockNumber(BlockNumber _blockNumber)
+{
+    auto blockNumber = m_blockNumber.load();
+    while (_blockNumber > blockNumber &&
+           !m_blockNumber.compare_exchange_weak(blockNumber, _blockNumber))
+    {
+    }
+    m_signalled.notify_all();
+}
+
+Error::Ptr LogIndexer::init()
+{
+    std::promise<std::pair<Error::Ptr, std::optional<Entry>>> promise;
+    m_ledger->asyncGetCurrentStateByKey(SYS_KEY_LOG_INDEXED_NUMBER,
+        [&promise](Error::Ptr&& _error, std::optional<Entry>&& _entry) {
+            promise.set_value({std::move(_error), std::move(_entry)});
+        });
+    auto [error, entry] = promise.get_future().get();
+    if (error)
+    {
+        return error;
+    }
+    if (entry)
+    {
+        try
+        {
+            m_indexedNumber = boost::lexical_cast<BlockNumber>(entry->get());
+        }
+        catch (boost::bad_lexical_cast const&)
+        {
+            return BCOS_ERROR_PTR(LedgerError::CallbackError,
+                "Invalid log indexed number: " + std::string(entry->get()));
+        }
+    }
+    return nullptr;
+}
+
+Error::Ptr LogIndexer::indexBlocks(BlockNumber _toBlock)
+{
+    auto fromBlock = m_indexedNumber + 1;
+    std::vector<std::string> keys;
+    for (auto number = fromBlock; number <= _toBlock; ++number)
+    {
+        std::promise<std::pair<Error::Ptr, Block::Ptr>> promise;
+        m_ledger->asyncGetBlockDataByNumber(
+            number, RECEIPTS, [&promise](Error::Ptr _error, Block::Ptr _block) {
+                promise.set_value({std::move(_error), std::move(_block)});
+            });
+        auto [error, block] = promise.get_future().get();
+        if (error)
+        {
+            return error;
+        }
+        appendKeys(*block, number, keys);
+    }
+
+    if (!keys.empty())
+    {
+        // the keys are the index, the values are empty
+        std::vector<std::string> values(keys.size());
+        auto error = m_storage->setRows(SYS_LOG_INDEX, keys, values);
+        if (error)
+        {
+            return error;
+        }
+    }
+
+    Entry indexedNumber;
+    indexedNumber.importFields({std::to_string(_toBlock)});
+    std::promise<Error::UniquePtr> promise;
+    m_storage->asyncSetRow(SYS_CURRENT_STATE, SYS_KEY_LOG_INDEXED_NUMBER,
+        std::move(indexedNumber),
+        [&promise](Error::UniquePtr _error) { promise.set_value(std::move(_error)); });
+    auto error = promise.get_future().get();
+    if (error)
+    {
+        return BCOS_ERROR_WITH_PREV_PTR(
+            LedgerError::CallbackError, "Set log indexed number failed", *error);
+    }
+    m_indexedNumber = _toBlock;
+
+    LEDGER_LOG(DEBUG) << LOG_BADGE("LogIndexer") << LOG_DESC("indexBlocks")
+                      << LOG_KV("fromBlock", fromBlock) << LOG_KV("toBlock", _toBlock)
+                      << LOG_KV("keys", keys.size());
+    return nullptr;
+}
+
+void LogIndexer::workerProcessLoop()
+{
+    while (workerState() == WorkerState::Started)
+    {
+        try
+        {
+            auto indexedNumber = m_indexedNumber.load();
+            auto blockNumber = m_blockNumber.load();
+            if (blockNumber > indexedNumber)
+            {
+                auto error =
+                    indexBlocks(std::min(blockNumber, indexedNumber + BATCH_BLOCKS));
+                if (!error)
+                {
+                    continue;
+                }
+                LEDGER_LOG(WARNING) << LOG_BADGE("LogIndexer") << LOG_DESC("indexBlocks failed")
+                                    << LOG_KV("indexedNumber", indexedNumber)
+                                    << LOG_KV("code", error->errorCode())
+                                    << LOG_KV("message", error->errorMessage());
+            }
+        }
+        catch (std::exception const& e)
+        {
+            LEDGER_LOG(ERROR) << LOG_BADGE("LogIndexer") << LOG_DESC("indexBlocks exception")
+                              << LOG_KV("message", boost::diagnostic_information(e));
+        }
+        boost::unique_lock<boost::mutex> lock(x_signalled);
+        m_signalled.wait_for(lock, boost::chrono::milliseconds(c_idleWaitMs));
+    }
+}
+
+std::string LogIndexer::keyPrefix(std::string_view _address, std::string_view _topic0)
+{
+    std::string prefix;
+    prefix.reserve(_address.size() + _topic0.size() + 2);
+    prefix.append(_address);
+    prefix.push_back(c_keySplit);
+    prefix.append(_topic0);
+    prefix.push_back(c_keySplit);
+    return prefix;
+}
+
+std::string LogIndexer::key(std::string_view _address, std::string_view _topic0,
+    BlockNumber _blockNumber, uint32_t _txIndex, uint32_t _logIndex)
+{
+    auto key = keyPrefix(_address, _topic0);
+    key.reserve(key.size() + c_keySuffixSize - 1);
+    appendHex(key, _blockNumber, c_blockNumberWidth);
+    key.push_back(c_keySplit);
+    appendHex(key, _txIndex, c_indexWidth);
+    key.push_back(c_keySplit);
+    appendHex(key, _logIndex, c_indexWidth);
+    return key;
+}
+
+void LogIndexer::appendKeys(
+    const Block& _block, BlockNumber _blockNumber, std::vector<std::string>& _keys)
+{
+    for (uint32_t txIndex = 0; txIndex < _block.receiptsSize(); ++txIndex)
+    {
+        auto receipt = _block.receipt(txIndex);
+        auto logEntries = receipt->logEntries();
+        for (uint32_t logIndex = 0; logIndex < logEntries.size(); ++logIndex)
+        {
+            const auto& logEntry = logEntries[logIndex];
+            _keys.emplace_back(key(logEntry.address(), {}, _blockNumber, txIndex, logIndex));
+            if (!logEntry.topics().empty())
+            {
+                _keys.emplace_back(key(logEntry.address(), logEntry.topics()[0].hex(),
+                    _blockNumber, txIndex, logIndex));
+            }
+        }
+    }
+}
+
+Condition LogIndexer::condition(std::string_view _address, std::string_view _topic0,
+    BlockNumber _fromBlock, BlockNumber _toBlock)
+{
+    auto prefix = keyPrefix(_address, _topic0);
+    auto lowerBound = prefix;
+    appendHex(lowerBound, std::max<BlockNumber>(_fromBlock, 0), c_blockNumberWidth);
+    auto upperBound = std::move(prefix);
+    appendHex(upperBound, _toBlock + 1, c_blockNumberWidth);
+
+    Condition condition;
+    condition.GE(lowerBound);
+    condition.LT(upperBound);
+    return condition;
+}
+
+std::optional<BlockNumber> LogIndexer::blockNumber(std::string_view _key)
+{
+    if (_key.size() < c_keySuffixSize)
+    {
+        return {};
+    }
+    auto hex = _key.substr(_key.size() - c_keySuffixSize + 1, c_blockNumberWidth);
+    uint64_t blockNumber = 0;
+    auto [end, errorCode] = std::from_chars(hex.data(), hex.data() + hex.size(), blockNumber, 16);
+    if (errorCode != std::errc() || end != hex.data() + hex.size())
+    {
+        return {};
+    }
+    return (BlockNumber)blockNumber;
+}
+
+std::tuple<Error::UniquePtr, std::vector<BlockNumber>> LogIndexer::getBlockNumbers(
+    StorageInterface& _storage, std::string_view _address, std::string_view _topic0,
+    BlockNumber _fromBlock, BlockNumber _toBlock, size_t _limit)
+{
+    std::vector<BlockNumber> blockNumbers;
+    _fromBlock = std::max<BlockNumber>(_fromBlock, 0);
+    auto batchBlocks = READ_BATCH_BLOCKS;
+    while (_fromBlock <= _toBlock && blockNumbers.size() < _limit)
+    {
+        auto batchToBlock = std::min(_toBlock, _fromBlock + batchBlocks - 1);
+        auto batchCondition = condition(_address, _topic0, _fromBlock, batchToBlock);
+        batchCondition.limit(0, READ_BATCH_KEYS);
+        std::promise<std::tuple<Error::UniquePtr, std::vector<std::string>>> promise;
+        _storage.asyncGetPrimaryKeys(SYS_LOG_INDEX, batchCondition,
+            [&promise](Error::UniquePtr _error, std::vector<std::string> _keys) {
+                promise.set_value({std::move(_error), std::move(_keys)});
+            });
+        auto [error, keys] = promise.get_future().get();
+        if (error)
+        {
+            return {std::move(error), {}};
+        }
+
+        // A key per log, not every storage honors the limit or returns the keys in order, so the
+        // keys of a batch cut by the limit may be any of the batch and skip some of its blocks. A
+        // cut batch is read again with half of the blocks, a block with keys has logs anyway
+        auto cut = keys.size() == READ_BATCH_KEYS;
+        if (cut && batchToBlock > _fromBlock)
+        {
+            batchBlocks = (batchToBlock - _fromBlock + 1) / 2;
+            continue;
+        }
+        auto batchBegin = blockNumbers.size();
+        for (const auto& key : keys)
+        {
+            if (auto number = blockNumber(key))
+            {
+                blockNumbers.push_back(*number);
+            }
+        }
+        std::sort(blockNumbers.begin() + batchBegin, blockNumbers.end());
+        blockNumbers.erase(
+            std::unique(blockNumbers.begin() + batchBegin, blockNumbers.end()), blockNumbers.end());
+        _fromBlock = batchToBlock + 1;
+        if (!cut)
+        {
+            batchBlocks = std::min(batchBlocks * 2, READ_BATCH_BLOCKS);
+        }
+    }
+    if (blockNumbers.size() > _limit)
+    {
+        blockNumbers.resize(_limit);
+    }
+    return {nullptr, std::move(blockNumbers)};
+}
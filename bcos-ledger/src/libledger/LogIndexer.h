@@ -0,0 +1,104 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LogIndexer.h
+ * @brief the index of the logs of the committed blocks by address and first topic
+ */
+#pragma once
+#include "bcos-framework/ledger/LedgerInterface.h"
+#include "bcos-framework/protocol/Block.h"
+#include "bcos-framework/protocol/ProtocolTypeDef.h"
+#include "bcos-framework/storage/Common.h"
+#include "bcos-framework/storage/StorageInterface.h"
+#include <bcos-utilities/Worker.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace bcos::ledger
+{
+/**
+ * @brief index the logs of the committed blocks into s_log_index, in background of the commit
+ *
+ * The keys are address|topic0|blockNumber|txIndex|logIndex with fixed width hex numbers, so the
+ * logs of an address and a first topic in a block range are one range of keys. Each log is also
+ * indexed with an empty topic0 for the queries by address only. The blocks up to the number saved
+ * in s_current_state are indexed, indexing a block again writes the same keys
+ */
+class LogIndexer : public Worker
+{
+public:
+    using Ptr = std::shared_ptr<LogIndexer>;
+    // the most blocks indexed by one write
+    constexpr static protocol::BlockNumber BATCH_BLOCKS = 100;
+    // the most blocks and keys read by one query of the blocks with logs
+    constexpr static protocol::BlockNumber READ_BATCH_BLOCKS = 1000;
+    constexpr static size_t READ_BATCH_KEYS = 1024;
+
+    LogIndexer(LedgerInterface::Ptr _ledger, storage::StorageInterface::Ptr _storage)
+      : Worker("logIndexer", 0), m_ledger(std::move(_ledger)), m_storage(std::move(_storage))
+    {}
+    ~LogIndexer() override { stop(); }
+
+    void start();
+    void stop();
+
+    // the blocks up to the committed block are indexed by the worker
+    void notifyBlockNumber(protocol::BlockNumber _blockNumber);
+
+    // read the last indexed block number from the storage
+    Error::Ptr init();
+    // index the blocks in (indexedNumber(), _toBlock] with one write, only called by one thread
+    Error::Ptr indexBlocks(protocol::BlockNumber _toBlock);
+    // -1 if no block is indexed
+    protocol::BlockNumber indexedNumber() const { return m_indexedNumber; }
+
+    static std::string keyPrefix(std::string_view _address, std::string_view _topic0);
+    static std::string key(std::string_view _address, std::string_view _topic0,
+        protocol::BlockNumber _blockNumber, uint32_t _txIndex, uint32_t _logIndex);
+    static void appendKeys(const protocol::Block& _block, protocol::BlockNumber _blockNumber,
+        std::vector<std::string>& _keys);
+    // the keys of the logs of an address and a first topic in [_fromBlock, _toBlock]
+    static storage::Condition condition(std::string_view _address, std::string_view _topic0,
+        protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock);
+    static std::optional<protocol::BlockNumber> blockNumber(std::string_view _key);
+    // the ascending numbers of the first _limit blocks with the logs of an address and a first
+    // topic in [_fromBlock, _toBlock]. The keys are read by batches of blocks, a batch cut by the
+    // limit of keys is read again with fewer blocks, and the reads stop once _limit blocks are
+    // found
+    static std::tuple<Error::UniquePtr, std::vector<protocol::BlockNumber>> getBlockNumbers(
+        storage::StorageInterface& _storage, std::string_view _address, std::string_view _topic0,
+        protocol::BlockNumber _fromBlock, protocol::BlockNumber _toBlock, size_t _limit);
+
+protected:
+    void workerProcessLoop() override;
+
+private:
+    LedgerInterface::Ptr m_ledger;
+    storage::StorageInterface::Ptr m_storage;
+
+    std::atomic_bool m_running = false;
+    std::atomic<protocol::BlockNumber> m_blockNumber = -1;
+    std::atomic<protocol::BlockNumber> m_indexedNumber = -1;
+
+    boost::condition_variable m_signalled;
+    boost::mutex x_signalled;
+};
+}  // namespace bcos::ledger
@@ -22,6 +22,8 @@
 #include <bcos-framework/protocol/Block.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <map>
+#include <string>
+#include <string_view>
 
 #define LEDGER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("LEDGER")
 
@@ -36,6 +38,13 @@ constexpr static const char* const SYS_VALUE = "value";
 constexpr static const char* const SYS_CONFIG_ENABLE_BLOCK_NUMBER = "enable_number";
 constexpr static const char* const SYS_VALUE_AND_ENABLE_BLOCK_NUMBER = "value,enable_number";
 
+// The log blooms of the receipts of a block, in SYS_NUMBER_2_LOG_BLOOM beside the bloom of the
+// block under its number
+inline std::string receiptLogBloomKey(std::string_view blockNumberKey)
+{
+    return std::string(blockNumberKey) + "_receipts";
+}
+
 enum LedgerError : int32_t
 {
     SUCCESS = 0,
@@ -0,0 +1,256 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the transaction and receipt merkle trees of the blocks, persisted at commit by chunks
+ * @file MerkleTree.h
+ */
+#pragma once
+#include <bcos-crypto/merkle/Merkle.h>
+#include <bcos-framework/ledger/LedgerTypeDef.h>
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <bcos-utilities/FixedBytes.h>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace bcos::ledger
+{
+
+// The trees of a block are stored in SYS_NUMBER_2_MERKLE by chunks, so a proof reads a bounded
+// number of rows whatever the size of the block:
+//  - merkleTreeKey(): the big endian count of the leaves
+//  - merkleIndexKey(): the leaves bucketed by their hash, each followed by its big endian index
+//  - merkleNodesKey(): MERKLE_CHUNK_SIZE nodes of a level, from the leaves up to the level below
+//    the root, which is in the header
+// A proof reads the count, the bucket of the leaf, then one chunk per level
+constexpr static uint32_t MERKLE_CHUNK_SIZE = 256;
+constexpr static uint32_t MERKLE_WIDTH = 2;
+static_assert(MERKLE_CHUNK_SIZE % MERKLE_WIDTH == 0);
+
+inline std::string merkleTreeKey(protocol::BlockNumber blockNumber, bool isTransaction)
+{
+    return (isTransaction ? "tx_" : "receipt_") + std::to_string(blockNumber);
+}
+
+inline std::string merkleIndexKey(
+    protocol::BlockNumber blockNumber, bool isTransaction, uint32_t bucket)
+{
+    return merkleTreeKey(blockNumber, isTransaction) + "_i" + std::to_string(bucket);
+}
+
+inline std::string merkleNodesKey(
+    protocol::BlockNumber blockNumber, bool isTransaction, uint32_t level, uint32_t chunk)
+{
+    return merkleTreeKey(blockNumber, isTransaction) + "_" + std::to_string(level) + "_" +
+           std::to_string(chunk);
+}
+
+inline uint32_t merkleBucket(h256 const& leaf, uint32_t leafCount)
+{
+    auto bucketCount = (leafCount + MERKLE_CHUNK_SIZE - 1) / MERKLE_CHUNK_SIZE;
+    uint64_t prefix = 0;
+    std::memcpy(&prefix, leaf.data(), sizeof(prefix));
+    return static_cast<uint32_t>(prefix % bucketCount);
+}
+
+// The lengths of the levels stored, the root level excluded unless it is the only leaf
+inline std::vector<uint32_t> merkleLevelLengths(uint32_t leafCount)
+{
+    std::vector<uint32_t> lengths{leafCount};
+    while (lengths.back() > MERKLE_WIDTH)
+    {
+        lengths.push_back((lengths.back() + MERKLE_WIDTH - 1) / MERKLE_WIDTH);
+    }
+    return lengths;
+}
+
+inline std::optional<uint32_t> decodeMerkleLeafCount(std::string_view row)
+{
+    uint32_t leafCount = 0;
+    if (row.size() != sizeof(leafCount))
+    {
+        return {};
+    }
+    std::memcpy(&leafCount, row.data(), sizeof(leafCount));
+    leafCount = boost::endian::big_to_native(leafCount);
+    if (leafCount == 0)
+    {
+        return {};
+    }
+    return leafCount;
+}
+
+using MerkleTreeRows = std::vector<std::tuple<std::string, bcos::bytes>>;
+
+// The rows of the tree generated by Merkle::generateMerkle from the leaves, the tree calculated
+// with the roots of the block is reused. Empty if there is no leaf or the tree is not the one of
+// the leaves and the root, the block is then left to the proof generation from its transactions or
+// receipts
+inline MerkleTreeRows encodeMerkleTree(protocol::BlockNumber blockNumber, bool isTransaction,
+    RANGES::random_access_range auto const& leaves, RANGES::random_access_range auto const& tree,
+    h256 const& root)
+{
+    auto leafCount = static_cast<uint32_t>(RANGES::size(leaves));
+    if (leafCount == 0 || RANGES::empty(tree) || *RANGES::rbegin(tree) != root)
+    {
+        return {};
+    }
+
+    // The start of each level in the tree, each level is led by its length record
+    auto lengths = merkleLevelLengths(leafCount);
+    std::vector<size_t> levelStarts{0};
+    size_t nodeCount = 0;
+    for (auto length : lengths | RANGES::views::drop(1))
+    {
+        levelStarts.push_back(nodeCount + 1);
+        nodeCount += length + 1;
+    }
+    // the root level, with its length record when there are more than one leaf
+    nodeCount += leafCount > 1 ? 2 : 1;
+    if (static_cast<size_t>(RANGES::size(tree)) != nodeCount)
+    {
+        return {};
+    }
+
+    MerkleTreeRows rows;
+    auto bigEndianCount = boost::endian::native_to_big(leafCount);
+    bcos::bytes countRow(sizeof(bigEndianCount));
+    std::memcpy(countRow.data(), &bigEndianCount, sizeof(bigEndianCount));
+    rows.emplace_back(merkleTreeKey(blockNumber, isTransaction), std::move(countRow));
+
+    auto bucketCount = (leafCount + MERKLE_CHUNK_SIZE - 1) / MERKLE_CHUNK_SIZE;
+    std::vector<bcos::bytes> buckets(bucketCount);
+    uint32_t index = 0;
+    for (auto const& leaf : leaves)
+    {
+        auto& bucket = buckets[merkleBucket(leaf, leafCount)];
+        auto bigEndianIndex = boost::endian::native_to_big(index++);
+        bucket.insert(bucket.end(), leaf.begin(), leaf.end());
+        bucket.insert(bucket.end(), (const bcos::byte*)&bigEndianIndex,
+            (const bcos::byte*)&bigEndianIndex + sizeof(bigEndianIndex));
+    }
+    for (uint32_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        rows.emplace_back(
+            merkleIndexKey(blockNumber, isTransaction, bucket), std::move(buckets[bucket]));
+    }
+
+    for (uint32_t level = 0; level < lengths.size(); ++level)
+    {
+        for (uint32_t chunk = 0; chunk * MERKLE_CHUNK_SIZE < lengths[level]; ++chunk)
+        {
+            auto begin = chunk * MERKLE_CHUNK_SIZE;
+            auto end = std::min(begin + MERKLE_CHUNK_SIZE, lengths[level]);
+            bcos::bytes row;
+            row.reserve((end - begin) * h256::SIZE);
+            for (auto i = begin; i < end; ++i)
+            {
+                auto const& node = level == 0 ? leaves[i] : tree[levelStarts[level] + i];
+                row.insert(row.end(), node.begin(), node.end());
+            }
+            rows.emplace_back(
+                merkleNodesKey(blockNumber, isTransaction, level, chunk), std::move(row));
+        }
+    }
+    return rows;
+}
+
+// The index of the leaf in the bucket row, empty if not found
+inline std::optional<uint32_t> findMerkleLeafIndex(std::string_view row, h256 const& leaf)
+{
+    constexpr static size_t recordSize = h256::SIZE + sizeof(uint32_t);
+    if (row.size() % recordSize != 0)
+    {
+        return {};
+    }
+    for (size_t offset = 0; offset < row.size(); offset += recordSize)
+    {
+        if (std::memcmp(row.data() + offset, leaf.data(), h256::SIZE) == 0)
+        {
+            uint32_t index = 0;
+            std::memcpy(&index, row.data() + offset + h256::SIZE, sizeof(index));
+            return boost::endian::big_to_native(index);
+        }
+    }
+    return {};
+}
+
+// The keys of the chunks holding the proof of the leaf, one per level
+inline std::vector<std::string> merkleProofKeys(
+    protocol::BlockNumber blockNumber, bool isTransaction, uint32_t leafCount, uint32_t index)
+{
+    std::vector<std::string> keys;
+    auto lengths = merkleLevelLengths(leafCount);
+    for (uint32_t level = 0; level < lengths.size(); ++level, index /= MERKLE_WIDTH)
+    {
+        keys.emplace_back(
+            merkleNodesKey(blockNumber, isTransaction, level, index / MERKLE_CHUNK_SIZE));
+    }
+    return keys;
+}
+
+// The proof of the leaf from the rows of merkleProofKeys(), in the layout of
+// Merkle::generateMerkleProof. Null if the rows are missing or malformed
+template <class Rows>
+MerkleProofPtr generateMerkleProof(uint32_t leafCount, uint32_t index, Rows const& rows)
+{
+    auto lengths = merkleLevelLengths(leafCount);
+    if (index >= leafCount || static_cast<size_t>(RANGES::size(rows)) != lengths.size())
+    {
+        return nullptr;
+    }
+
+    auto proof = std::make_shared<MerkleProof>();
+    for (uint32_t level = 0; level < lengths.size(); ++level, index /= MERKLE_WIDTH)
+    {
+        auto const& row = rows[level];
+        if (!row)
+        {
+            return nullptr;
+        }
+        auto chunk = index / MERKLE_CHUNK_SIZE;
+        auto chunkLength =
+            std::min(MERKLE_CHUNK_SIZE, lengths[level] - chunk * MERKLE_CHUNK_SIZE);
+        std::string_view nodes = *row;
+        if (nodes.size() != chunkLength * h256::SIZE)
+        {
+            return nullptr;
+        }
+
+        auto alignedIndex = index - index % MERKLE_WIDTH;
+        auto count = std::min(lengths[level] - alignedIndex, MERKLE_WIDTH);
+        if (leafCount > 1)
+        {
+            auto bigEndianCount = boost::endian::native_to_big(count);
+            std::memcpy(proof->emplace_back().data(), &bigEndianCount, sizeof(bigEndianCount));
+        }
+        else
+        {
+            count = 1;
+        }
+        auto offset = (alignedIndex - chunk * MERKLE_CHUNK_SIZE) * h256::SIZE;
+        for (uint32_t i = 0; i < count; ++i, offset += h256::SIZE)
+        {
+            proof->emplace_back(
+                bytesConstRef((const bcos::byte*)nodes.data() + offset, h256::SIZE));
+        }
+    }
+    return proof;
+}
+}  // namespace bcos::ledger
@@ -22,6 +22,7 @@
  */
 
 #include "bcos-ledger/src/libledger/Ledger.h"
+#include "bcos-ledger/src/libledger/LogIndexer.h"
 #include "../../mock/MockKeyFactor.h"
 #include "bcos-crypto/interfaces/crypto/KeyPairInterface.h"
 #include "bcos-crypto/merkle/Merkle.h"
@@ -46,6 +47,7 @@
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/test/unit_test.hpp>
+#include <limits>
 #include <memory>
 
 using namespace bcos;
@@ -102,6 +104,31 @@ public:
         return nullptr;
     }
 };
+// honors the limit of the keys but returns them in descending order, the first keys found by a
+// storage without order may be any of the range
+class LimitedKeysStorage : public MockStorage
+{
+public:
+    LimitedKeysStorage(std::shared_ptr<StorageInterface> prev)
+      : storage::StateStorageInterface(prev), StateStorage(prev), MockStorage(prev)
+    {}
+    void asyncGetPrimaryKeys(std::string_view table,
+        const std::optional<storage::Condition const>& condition,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> callback) override
+    {
+        MockStorage::asyncGetPrimaryKeys(table, condition,
+            [condition, callback = std::move(callback)](
+                Error::UniquePtr error, std::vector<std::string> keys) {
+                std::reverse(keys.begin(), keys.end());
+                auto count = condition ? condition->getLimit().second : 0;
+                if (count > 0 && keys.size() > count)
+                {
+                    keys.resize(count);
+                }
+                callback(std::move(error), std::move(keys));
+            });
+    }
+};
 class LedgerFixture : public TestPromptFixture
 {
 public:
@@ -1288,5 +1315,113 @@ BOOST_AUTO_TEST_CASE(testSyncBlock)
             BOOST_CHECK_EQUAL(block->transaction(0)->hash().hex(), tx->hash().hex());
         });
 }
+
+BOOST_AUTO_TEST_CASE(testLogIndex)
+{
+    initFixture();
+    initChain(5);
+
+    auto key = LogIndexer::key("address", "topic", 0x1234, 1, 2);
+    BOOST_CHECK_EQUAL(key, "address|topic|0000000000001234|00000001|00000002");
+    BOOST_CHECK_EQUAL(LogIndexer::blockNumber(key).value(), 0x1234);
+    BOOST_CHECK(!LogIndexer::blockNumber("address||1234"));
+    auto condition = LogIndexer::condition("address", "topic", 0x1234, 0x1234);
+    BOOST_CHECK(condition.isValid(key));
+    BOOST_CHECK(!condition.isValid(LogIndexer::key("address", "topic", 0x1235, 0, 0)));
+    BOOST_CHECK(!condition.isValid(LogIndexer::key("address", "", 0x1234, 0, 0)));
+
+    auto getIndexedLogBlocks = [this](std::string_view address, std::string_view topic0,
+                                   BlockNumber fromBlock, BlockNumber toBlock,
+                                   size_t limit = std::numeric_limits<size_t>::max()) {
+        std::promise<std::pair<BlockNumber, std::vector<BlockNumber>>> promise;
+        m_ledger->asyncGetIndexedLogBlocks(address, topic0, fromBlock, toBlock, limit,
+            [&promise](Error::Ptr error, BlockNumber indexedNumber,
+                std::vector<BlockNumber> blockNumbers) {
+                BOOST_CHECK(!error);
+                promise.set_value({indexedNumber, std::move(blockNumbers)});
+            });
+        return promise.get_future().get();
+    };
+
+    // Every receipt of the fake blocks has the same two logs
+    auto receipt = m_fakeBlocks->at(0)->receipt(0);
+    auto logEntries = receipt->logEntries();
+    BOOST_REQUIRE_EQUAL(logEntries.size(), 2);
+    std::string address(logEntries[0].address());
+    std::string otherAddress(logEntries[1].address());
+    auto topic0 = logEntries[0].topics()[0].hex();
+    auto firstBlock = m_fakeBlocks->at(0)->blockHeaderConst()->number();
+    auto lastBlock = m_fakeBlocks->at(4)->blockHeaderConst()->number();
+
+    // Not indexed
+    BOOST_CHECK_EQUAL(getIndexedLogBlocks(address, "", 0, lastBlock).first, -1);
+
+    LogIndexer logIndexer(m_ledger, m_storage);
+    BOOST_CHECK(!logIndexer.init());
+    BOOST_CHECK_EQUAL(logIndexer.indexedNumber(), -1);
+    BOOST_CHECK(!logIndexer.indexBlocks(firstBlock + 1));
+    BOOST_CHECK_EQUAL(logIndexer.indexedNumber(), firstBlock + 1);
+
+    // Indexed up to the second block
+    auto [indexedNumber, blockNumbers] = getIndexedLogBlocks(address, "", 0, lastBlock);
+    BOOST_CHECK_EQUAL(indexedNumber, firstBlock + 1);
+    BOOST_CHECK(blockNumbers == std::vector<BlockNumber>({firstBlock, firstBlock + 1}));
+
+    BOOST_CHECK(!logIndexer.indexBlocks(lastBlock));
+    LogIndexer restarted(m_ledger, m_storage);
+    BOOST_CHECK(!restarted.init());
+    BOOST_CHECK_EQUAL(restarted.indexedNumber(), lastBlock);
+
+    std::tie(indexedNumber, blockNumbers) = getIndexedLogBlocks(address, topic0, 0, lastBlock);
+    BOOST_CHECK_EQUAL(indexedNumber, lastBlock);
+    BOOST_CHECK_EQUAL(blockNumbers.size(), 5);
+    std::tie(indexedNumber, blockNumbers) =
+        getIndexedLogBlocks(address, topic0, firstBlock + 1, firstBlock + 2);
+    BOOST_CHECK(blockNumbers == std::vector<BlockNumber>({firstBlock + 1, firstBlock + 2}));
+    // The first blocks up to the limit
+    std::tie(indexedNumber, blockNumbers) = getIndexedLogBlocks(address, topic0, 0, lastBlock, 2);
+    BOOST_CHECK(blockNumbers == std::vector<BlockNumber>({firstBlock, firstBlock + 1}));
+    // The topic of another log
+    std::tie(indexedNumber, blockNumbers) = getIndexedLogBlocks(otherAddress, topic0, 0, lastBlock);
+    BOOST_CHECK(blockNumbers.empty());
+    std::tie(indexedNumber, blockNumbers) = getIndexedLogBlocks("unknown", "", 0, lastBlock);
+    BOOST_CHECK(blockNumbers.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testLogIndexCutBatch)
+{
+    auto memoryStorage = std::make_shared<StateStorage>(nullptr);
+    memoryStorage->setEnableTraverse(true);
+    auto storage = std::make_shared<LimitedKeysStorage>(memoryStorage);
+    storage->setEnableTraverse(true);
+
+    // The block 20 alone has more logs than a batch reads, the blocks around it are in the same
+    // batch of blocks
+    std::vector<std::pair<BlockNumber, uint32_t>> logCounts = {
+        {10, 1}, {20, LogIndexer::READ_BATCH_KEYS + 500}, {30, 1}, {1200, 1}};
+    std::vector<std::string> keys;
+    for (auto [blockNumber, logCount] : logCounts)
+    {
+        for (uint32_t txIndex = 0; txIndex < logCount; ++txIndex)
+        {
+            keys.emplace_back(LogIndexer::key("address", "", blockNumber, txIndex, 0));
+        }
+    }
+    std::vector<std::string> values(keys.size());
+    BOOST_CHECK(!storage->setRows(SYS_LOG_INDEX, keys, values));
+
+    auto [error, blockNumbers] = LogIndexer::getBlockNumbers(
+        *storage, "address", "", 0, 2000, std::numeric_limits<size_t>::max());
+    BOOST_CHECK(!error);
+    BOOST_CHECK(blockNumbers == std::vector<BlockNumber>({10, 20, 30, 1200}));
+    std::tie(error, blockNumbers) =
+        LogIndexer::getBlockNumbers(*storage, "address", "", 0, 2000, 2);
+    BOOST_CHECK(!error);
+    BOOST_CHECK(blockNumbers == std::vector<BlockNumber>({10, 20}));
+    std::tie(error, blockNumbers) =
+        LogIndexer::getBlockNumbers(*storage, "address", "", 21, 2000, 2);
+    BOOST_CHECK(!error);
+    BOOST_CHECK(blockNumbers == std::vector<BlockNumber>({30, 1200}));
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
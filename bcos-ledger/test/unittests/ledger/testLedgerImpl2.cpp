@@ -12,6 +12,7 @@
 #include <boost/algorithm/hex.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/throw_exception.hpp>
+#include <map>
 
 using namespace bcos;
 using namespace bcos::ledger;
@@ -62,4 +63,64 @@ BOOST_AUTO_TEST_CASE(commitBlock)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(merkleTree)
+{
+    using Hasher = crypto::hasher::openssl::OpenSSL_Keccak256_Hasher;
+    crypto::merkle::Merkle<Hasher> merkle(Hasher{});
+    for (auto count : {1, 2, 3, 7, 64, 1000})
+    {
+        std::vector<h256> leaves;
+        for (int i = 0; i < count; ++i)
+        {
+            leaves.emplace_back(h256::generateRandomFixedBytes());
+        }
+        std::vector<h256> tree;
+        merkle.generateMerkle(leaves, tree);
+        auto root = *RANGES::rbegin(tree);
+
+        BOOST_CHECK(encodeMerkleTree(1, true, leaves, tree, h256{}).empty());
+        std::map<std::string, bcos::bytes, std::less<>> rows;
+        for (auto& [key, value] : encodeMerkleTree(1, true, leaves, tree, root))
+        {
+            rows.emplace(std::move(key), std::move(value));
+        }
+        auto rowView = [&rows](std::string_view key) -> std::optional<std::string_view> {
+            auto it = rows.find(key);
+            if (it == rows.end())
+            {
+                return {};
+            }
+            return std::string_view((const char*)it->second.data(), it->second.size());
+        };
+
+        auto leafCount = decodeMerkleLeafCount(*rowView(merkleTreeKey(1, true)));
+        BOOST_REQUIRE(leafCount);
+        BOOST_CHECK_EQUAL(*leafCount, count);
+        for (auto index : {0, count / 2, count - 1})
+        {
+            auto bucket = rowView(merkleIndexKey(1, true, merkleBucket(leaves[index], count)));
+            BOOST_REQUIRE(bucket);
+            auto foundIndex = findMerkleLeafIndex(*bucket, leaves[index]);
+            BOOST_REQUIRE(foundIndex);
+            BOOST_CHECK_EQUAL(*foundIndex, index);
+
+            // the same proof as from all the leaves
+            auto proofRows = merkleProofKeys(1, true, count, index) |
+                             RANGES::views::transform(rowView) | RANGES::to<std::vector>();
+            auto proof = generateMerkleProof(count, index, proofRows);
+            BOOST_REQUIRE(proof);
+            std::vector<h256> expected;
+            merkle.generateMerkleProof(leaves, tree, index, expected);
+            BOOST_CHECK(*proof == expected);
+            BOOST_CHECK(merkle.verifyMerkleProof(*proof, leaves[index], root));
+
+            proofRows.back().reset();
+            BOOST_CHECK(!generateMerkleProof(count, index, proofRows));
+        }
+        BOOST_CHECK(!findMerkleLeafIndex(*rowView(merkleIndexKey(1, true, 0)), h256{}));
+    }
+    BOOST_CHECK(
+        encodeMerkleTree(1, true, std::vector<h256>{}, std::vector<h256>{}, h256{}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
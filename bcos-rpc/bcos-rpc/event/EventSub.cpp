@@ -27,8 +27,11 @@
 #include <bcos-rpc/event/EventSubRequest.h>
 #include <bcos-rpc/event/EventSubResponse.h>
 #include <bcos-rpc/event/EventSubTask.h>
+#include <bcos-rpc/jsonrpc/JsonWriter.h>
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <thread>
 
@@ -36,7 +39,12 @@ using namespace bcos;
 using namespace bcos::event;
 
 EventSub::EventSub(std::shared_ptr<boostssl::ws::WsService> _wsService)
-  : bcos::Worker("t_event_sub"), m_wsService(_wsService)
+  : bcos::Worker("t_event_sub"),
+    m_wsService(_wsService),
+    m_logBloomCache(
+        std::make_shared<EventSubCache<std::optional<protocol::LogBloom>>>(RECENT_BLOCK_COUNT)),
+    m_blockCache(
+        std::make_shared<EventSubCache<std::shared_ptr<const EventSubBlock>>>(RECENT_BLOCK_COUNT))
 {
     m_wsService->registerMsgHandler(bcos::protocol::MessageType::EVENT_SUBSCRIBE,
         boost::bind(&EventSub::onRecvSubscribeEvent, this, boost::placeholders::_1,
@@ -108,6 +116,7 @@ void EventSub::onRecvSubscribeEvent(std::shared_ptr<bcos::boostssl::MessageFace>
     task->setGroup(eventSubRequest->group());
     task->setId(eventSubRequest->id());
     task->setParams(eventSubRequest->params());
+    task->setBloomFilter(std::make_shared<EventSubBloomFilter>(*eventSubRequest->params()));
     task->setState(state);
 
     auto eventSubWeakPtr = std::weak_ptr<EventSub>(shared_from_this());
@@ -212,17 +221,17 @@ bool EventSub::sendEvents(std::shared_ptr<bcos::boostssl::ws::WsSession> _sessio
         return true;
     }
 
-    auto esResp = std::make_shared<EventSubResponse>();
-    esResp->setId(_id);
-    esResp->setStatus(EP_STATUS_CODE::SUCCESS);
-    esResp->generateJson();
-
-    auto jResp = esResp->jResp();
-    jResp["result"] = _result;
-
-    Json::FastWriter writer;
-    std::string strEventInfo = writer.write(jResp);
-    auto data = std::make_shared<bcos::bytes>(strEventInfo.begin(), strEventInfo.end());
+    // the same json as EventSubResponse with the result, written without copying the events
+    auto data = std::make_shared<bcos::bytes>();
+    rpc::JsonWriter writer(*data);
+    writer.startObject();
+    writer.key("id");
+    writer.value(_id);
+    writer.key("status");
+    writer.value((int)EP_STATUS_CODE::SUCCESS);
+    writer.key("result");
+    writer.value(_result);
+    writer.endObject();
 
     auto msg = m_messageFactory->buildMessage();
     msg->setPacketType(bcos::protocol::MessageType::EVENT_LOG_PUSH);
@@ -231,7 +240,7 @@ bool EventSub::sendEvents(std::shared_ptr<bcos::boostssl::ws::WsSession> _sessio
 
     EVENT_SUB(TRACE) << LOG_BADGE("sendEvents") << LOG_DESC("send events to client")
                      << LOG_KV("endpoint", _session->endPoint()) << LOG_KV("id", _id)
-                     << LOG_KV("events", strEventInfo);
+                     << LOG_KV("events", std::string_view((const char*)data->data(), data->size()));
 
     return true;
 }
@@ -359,7 +368,8 @@ void EventSub::onTaskComplete(EventSubTask::Ptr _task)
                     << LOG_KV("currentBlock", _task->state()->currentBlockNumber());
 }
 
-int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task, int64_t _blockNumber)
+std::optional<EventSubBlockRange> EventSub::executeEventSubTask(
+    EventSubTask::Ptr _task, int64_t _blockNumber)
 {
     bcos::protocol::BlockNumber currentBlockNumber = _task->state()->currentBlockNumber();
     if (currentBlockNumber < 0)
@@ -372,18 +382,9 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task, int64_t _blockNum
     {
         _task->freeWork();
         // waiting for block to be sealed
-        return 0;
+        return std::nullopt;
     }
 
-    /*
-    EVENT_SUB(TRACE) << LOG_BADGE("executeEventSubTask") << LOG_DESC("running")
-                     << LOG_KV("id", _task->id())
-                     << LOG_KV("fromBlock", _task->params()->fromBlock())
-                     << LOG_KV("toBlock", _task->params()->toBlock())
-                     << LOG_KV("blockNumber", _blockNumber)
-                     << LOG_KV("currentBlockNumber", _task->state()->currentBlockNumber());
-     */
-
     int64_t toBlockNumber = _task->params()->toBlock();
     if (toBlockNumber > 0 && toBlockNumber < _blockNumber)
     {
@@ -395,70 +396,26 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task, int64_t _blockNum
     blockCanProcess =
         (blockCanProcess > maxBlockProcessPerLoop ? maxBlockProcessPerLoop : blockCanProcess);
 
-    class RecursiveProcess : public std::enable_shared_from_this<RecursiveProcess>
-    {
-    public:
-        void process(int64_t _blockNumber)
-        {
-            if (_blockNumber > m_endBlockNumber)
-            {  // all block has been proccessed
-                m_task->freeWork();
-                return;
-            }
-
-            EVENT_SUB(TRACE) << LOG_BADGE("executeEventSubTask:process")
-                             << LOG_KV("id", m_task->id())
-                             << LOG_KV("fromBlock", m_task->params()->fromBlock())
-                             << LOG_KV("toBlock", m_task->params()->toBlock())
-                             << LOG_KV("blockNumber", _blockNumber);
-
-            auto eventSub = m_eventSub;
-            auto task = m_task;
-            auto p = shared_from_this();
-            eventSub->processNextBlock(
-                _blockNumber, task, [task, _blockNumber, p](Error::Ptr _error) {
-                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
-                    {
-                        // error occur, wait for the next loop ???
-                        task->freeWork();
-                        return;
-                    }
-                    // next block
-                    task->state()->setCurrentBlockNumber(_blockNumber + 1);
-                    p->process(_blockNumber + 1);
-                });
-        }
-
-    public:
-        bcos::protocol::BlockNumber m_endBlockNumber;
-        std::shared_ptr<EventSub> m_eventSub;
-        EventSubTask::Ptr m_task;
-    };
-
-    auto p = std::make_shared<RecursiveProcess>();
-    p->m_endBlockNumber = currentBlockNumber + blockCanProcess - 1;
-    p->m_eventSub = shared_from_this();
-    p->m_task = _task;
-    p->process(currentBlockNumber);
-
-    return blockCanProcess;
+    return EventSubBlockRange{.task = std::move(_task),
+        .fromBlock = currentBlockNumber,
+        .toBlock = currentBlockNumber + blockCanProcess - 1};
 }
 
-int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
+std::optional<EventSubBlockRange> EventSub::executeEventSubTask(EventSubTask::Ptr _task)
 {
     // tests whether the connection of the session is available first
     auto connAvailable = checkConnAvailable(_task);
     if (!connAvailable)
     {
         unsubscribeEventSub(_task->id());
-        return -1;
+        return std::nullopt;
     }
 
     if (_task->isCompleted())
     {
         unsubscribeEventSub(_task->id());
         onTaskComplete(_task);
-        return 0;
+        return std::nullopt;
     }
 
     // task is working, waiting for done
@@ -467,7 +424,7 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
         EVENT_SUB(DEBUG) << LOG_BADGE("executeEventSubTask")
                          << LOG_DESC("tryWork false, the previous is still going on")
                          << LOG_KV("id", _task->id()) << LOG_KV("group", _task->group());
-        return 0;
+        return std::nullopt;
     }
 
     std::string group = _task->group();
@@ -479,71 +436,160 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
             << LOG_DESC("Cannot getBlockNumber from groupManager, maybe the group has been removed")
             << LOG_KV("group", group);
         unsubscribeEventSub(_task->id());
-        return -1;
+        _task->freeWork();
+        return std::nullopt;
     }
 
-    executeEventSubTask(_task, blockNumber);
-
-    return 0;
+    return executeEventSubTask(_task, blockNumber);
 }
 
-void EventSub::processNextBlock(
-    int64_t _blockNumber, EventSubTask::Ptr _task, std::function<void(Error::Ptr _error)> _callback)
+void EventSub::processBlock(
+    const std::string& _group, int64_t _blockNumber, std::vector<EventSubBlockRange> _ranges)
 {
-    auto self = std::weak_ptr<EventSub>(shared_from_this());
-    auto matcher = m_matcher;
-
-    std::string group = _task->group();
-    auto nodeService = m_groupManager->getNodeService(group, "");
+    auto nodeService = m_groupManager->getNodeService(_group, "");
     if (!nodeService)
     {
         // group not exist???
         EVENT_SUB(ERROR)
-            << LOG_BADGE("processNextBlock")
+            << LOG_BADGE("processBlock")
             << LOG_DESC("cannot get node service of the group maybe the group has been removed")
-            << LOG_KV("id", _task->id()) << LOG_KV("group", _task->group());
-        unsubscribeEventSub(_task->id());
+            << LOG_KV("group", _group) << LOG_KV("tasks", _ranges.size());
+        for (auto& range : _ranges)
+        {
+            range.task->freeWork();
+            unsubscribeEventSub(range.task->id());
+        }
         return;
     }
 
     auto ledger = nodeService->ledger();
-    ledger->asyncGetBlockDataByNumber(_blockNumber,
-        bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS,
-        [matcher, _task, _blockNumber, _callback, self](
-            Error::Ptr _error, protocol::Block::Ptr _block) {
-            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+    auto self = shared_from_this();
+    // The block is only loaded if its log bloom may match a task, or if it has no bloom. The
+    // blooms of the receipts are not needed, the logs of a loaded block are matched by the index
+    m_logBloomCache->asyncGet(
+        _group, _blockNumber,
+        [ledger, _blockNumber](auto _callback) {
+            ledger->asyncGetBlockLogBloom(_blockNumber,
+                [callback = std::move(_callback)](
+                    Error::Ptr, std::optional<protocol::LogBloom> _blockBloom) {
+                    // without bloom the block is matched log by log
+                    callback(nullptr, std::move(_blockBloom));
+                });
+        },
+        [self, ledger, _group, _blockNumber, ranges = std::move(_ranges)](
+            Error::Ptr, const std::optional<protocol::LogBloom>& _blockBloom) mutable {
+            if (_blockBloom &&
+                (_blockBloom->empty() ||
+                    std::none_of(ranges.begin(), ranges.end(), [&_blockBloom](const auto& range) {
+                        const auto& bloomFilter = range.task->bloomFilter();
+                        return !bloomFilter || bloomFilter->mayMatch(*_blockBloom);
+                    })))
             {
-                // Note: wait for next time
-                EVENT_SUB(ERROR) << LOG_BADGE("processNextBlock")
-                                 << LOG_DESC("asyncGetBlockDataByNumber")
-                                 << LOG_KV("id", _task->id()) << LOG_KV("blockNumber", _blockNumber)
-                                 << LOG_KV("code", _error->errorCode())
-                                 << LOG_KV("message", _error->errorMessage());
-                _callback(_error);
+                self->dispatchBlock(_group, _blockNumber, std::move(ranges), nullptr);
                 return;
             }
 
-            Json::Value jResp(Json::arrayValue);
-            auto count = matcher->matches(_task->params(), _block, jResp);
-            if (count)
-            {
-                EVENT_SUB(TRACE) << LOG_BADGE("processNextBlock")
-                                 << LOG_DESC("asyncGetBlockDataByNumber")
-                                 << LOG_KV("blockNumber", _blockNumber) << LOG_KV("id", _task->id())
-                                 << LOG_KV("count", count);
+            self->m_blockCache->asyncGet(
+                _group, _blockNumber,
+                [ledger, _blockNumber](auto _callback) {
+                    ledger->asyncGetBlockDataByNumber(_blockNumber,
+                        bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS,
+                        [callback = std::move(_callback)](
+                            Error::Ptr _error, protocol::Block::Ptr _block) {
+                            if (_error &&
+                                _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+                            {
+                                callback(std::move(_error), nullptr);
+                                return;
+                            }
+                            callback(nullptr, EventSubMatcher::decode(std::move(_block)));
+                        });
+                },
+                [self, _group, _blockNumber, ranges = std::move(ranges)](
+                    Error::Ptr _error, const EventSubBlock::ConstPtr& _block) mutable {
+                    if (_error)
+                    {
+                        // Note: wait for next time
+                        EVENT_SUB(ERROR)
+                            << LOG_BADGE("processBlock") << LOG_DESC("asyncGetBlockDataByNumber")
+                            << LOG_KV("group", _group) << LOG_KV("blockNumber", _blockNumber)
+                            << LOG_KV("code", _error->errorCode())
+                            << LOG_KV("message", _error->errorMessage());
+                        for (auto& range : ranges)
+                        {
+                            range.task->freeWork();
+                        }
+                        return;
+                    }
+                    self->dispatchBlock(_group, _blockNumber, std::move(ranges), _block.get());
+                });
+        });
+}
 
-                _task->callback()(_task->id(), false, jResp);
+void EventSub::dispatchBlock(const std::string& _group, int64_t _blockNumber,
+    std::vector<EventSubBlockRange> _ranges, const EventSubBlock* _block)
+{
+    if (_block && !_block->logs.empty())
+    {
+        std::vector<EventSubParams::ConstPtr> params;
+        params.reserve(_ranges.size());
+        for (const auto& range : _ranges)
+        {
+            params.push_back(range.task->params());
+        }
+        auto results = EventSubIndex(params).matches(*m_matcher, *_block);
+        for (std::size_t index = 0; index < _ranges.size(); ++index)
+        {
+            if (results[index].empty())
+            {
+                continue;
             }
+            const auto& task = _ranges[index].task;
+            EVENT_SUB(TRACE) << LOG_BADGE("dispatchBlock") << LOG_KV("blockNumber", _blockNumber)
+                             << LOG_KV("id", task->id()) << LOG_KV("count", results[index].size());
+            task->callback()(task->id(), false, results[index]);
+        }
+    }
 
-            _callback(nullptr);
-        });
+    std::vector<EventSubBlockRange> nextRanges;
+    for (auto& range : _ranges)
+    {
+        range.task->state()->setCurrentBlockNumber(_blockNumber + 1);
+        if (range.toBlock > _blockNumber)
+        {
+            nextRanges.push_back(std::move(range));
+        }
+        else
+        {
+            // all block has been proccessed
+            range.task->freeWork();
+        }
+    }
+    if (!nextRanges.empty())
+    {
+        processBlock(_group, _blockNumber + 1, std::move(nextRanges));
+    }
 }
 
 void EventSub::executeEventSubTasks()
 {
+    // The tasks starting from the same block of a group are processed together, each block is then
+    // fetched, decoded and matched once for all of them
+    std::map<std::pair<std::string, int64_t>, std::vector<EventSubBlockRange>> batches;
     for (auto& task : m_tasks)
     {
-        executeEventSubTask(task.second);
+        auto range = executeEventSubTask(task.second);
+        if (range)
+        {
+            auto& batch = batches[std::make_pair(range->task->group(), range->fromBlock)];
+            batch.push_back(std::move(*range));
+        }
+    }
+    for (auto& [key, ranges] : batches)
+    {
+        EVENT_SUB(TRACE) << LOG_BADGE("executeEventSubTasks") << LOG_KV("group", key.first)
+                         << LOG_KV("blockNumber", key.second) << LOG_KV("tasks", ranges.size());
+        processBlock(key.first, key.second, std::move(ranges));
     }
 
     // limiting speed
@@ -22,12 +22,14 @@
 
 #include <bcos-framework/ledger/LedgerInterface.h>
 #include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <bcos-rpc/event/EventSubCache.h>
 #include <bcos-rpc/event/EventSubTask.h>
 #include <bcos-rpc/groupmgr/GroupManager.h>
 #include <bcos-utilities/Worker.h>
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -47,6 +49,16 @@ class MessageFace;
 namespace event
 {
 class EventSubMatcher;
+struct EventSubBlock;
+
+// The blocks [fromBlock, toBlock] an event sub task processes in a loop of the worker
+struct EventSubBlockRange
+{
+    EventSubTask::Ptr task;
+    int64_t fromBlock;
+    int64_t toBlock;
+};
+
 class EventSub : bcos::Worker, public std::enable_shared_from_this<EventSub>
 {
 public:
@@ -97,21 +109,32 @@ public:
     void reportEventSubTasks();
 
 public:
-    int64_t executeEventSubTask(EventSubTask::Ptr _task);
+    std::optional<EventSubBlockRange> executeEventSubTask(EventSubTask::Ptr _task);
     void subscribeEventSub(EventSubTask::Ptr _task);
     void unsubscribeEventSub(const std::string& _id);
 
 public:
-    int64_t executeEventSubTask(EventSubTask::Ptr _task, int64_t _currentBlockNumber);
+    std::optional<EventSubBlockRange> executeEventSubTask(
+        EventSubTask::Ptr _task, int64_t _currentBlockNumber);
     void onTaskComplete(bcos::event::EventSubTask::Ptr _task);
     bool checkConnAvailable(bcos::event::EventSubTask::Ptr _task);
-    void processNextBlock(int64_t _blockNumber, bcos::event::EventSubTask::Ptr _task,
-        std::function<void(Error::Ptr _error)> _callback);
+    /**
+     * @brief: fetch and match a block once for all the tasks whose range starts with it, then go on
+     * with the next block for the tasks whose range goes on
+     * @param _group: the group of the tasks
+     * @param _blockNumber: the block to process
+     * @param _ranges: the ranges of the tasks, all starting from _blockNumber
+     */
+    void processBlock(
+        const std::string& _group, int64_t _blockNumber, std::vector<EventSubBlockRange> _ranges);
 
 public:
     std::shared_ptr<EventSubMatcher> matcher() const { return m_matcher; }
     void setMatcher(std::shared_ptr<EventSubMatcher> _matcher) { m_matcher = _matcher; }
 
+    // the number of recent blocks kept decoded for the tasks catching up
+    constexpr static size_t RECENT_BLOCK_COUNT = 128;
+
     int64_t maxBlockProcessPerLoop() const { return m_maxBlockProcessPerLoop; }
     void setMaxBlockProcessPerLoop(int64_t _maxBlockProcessPerLoop)
     {
@@ -142,8 +165,15 @@ private:
     std::shared_ptr<bcos::boostssl::MessageFaceFactory> m_messageFactory;
 
 private:
+    void dispatchBlock(const std::string& _group, int64_t _blockNumber,
+        std::vector<EventSubBlockRange> _ranges, const EventSubBlock* _block);
+
     std::shared_ptr<boostssl::ws::WsService> m_wsService;
 
+    // the log blooms and the decoded logs of the recent blocks
+    EventSubCache<std::optional<protocol::LogBloom>>::Ptr m_logBloomCache;
+    EventSubCache<std::shared_ptr<const EventSubBlock>>::Ptr m_blockCache;
+
     std::atomic<bool> m_running{false};
 
     // lock for m_addTasks
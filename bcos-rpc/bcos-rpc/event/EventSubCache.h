@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubCache.h
+ * @brief the values of the recent blocks shared by all the event sub tasks
+ */
+
+#pragma once
+
+#include <bcos-utilities/Error.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace event
+{
+/**
+ * @brief ring buffer of a value of the last blocks of the groups, a value is fetched once however
+ * many tasks get it: the tasks getting a value being fetched wait for the same fetch
+ */
+template <class Value>
+class EventSubCache : public std::enable_shared_from_this<EventSubCache<Value>>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubCache<Value>>;
+    using Callback = std::function<void(Error::Ptr, const Value&)>;
+    using Fetcher = std::function<void(std::function<void(Error::Ptr, Value)>)>;
+
+    explicit EventSubCache(size_t _capacity) : m_capacity(_capacity) {}
+
+    void asyncGet(const std::string& _group, int64_t _blockNumber, const Fetcher& _fetcher,
+        Callback _callback)
+    {
+        auto key = std::make_pair(_group, _blockNumber);
+        {
+            std::unique_lock lock(x_values);
+            auto it = m_values.find(key);
+            if (it != m_values.end())
+            {
+                auto value = it->second;
+                lock.unlock();
+                _callback(nullptr, value);
+                return;
+            }
+
+            auto& callbacks = m_fetching[key];
+            callbacks.push_back(std::move(_callback));
+            if (callbacks.size() > 1)
+            {
+                return;
+            }
+        }
+
+        _fetcher([self = this->shared_from_this(), key](Error::Ptr _error, Value _value) {
+            std::vector<Callback> callbacks;
+            {
+                std::unique_lock lock(self->x_values);
+                callbacks = std::move(self->m_fetching[key]);
+                self->m_fetching.erase(key);
+                // the failed fetches are retried by the next tasks
+                if (!_error && self->m_capacity > 0)
+                {
+                    self->insert(key, _value);
+                }
+            }
+            for (auto& callback : callbacks)
+            {
+                callback(_error, _value);
+            }
+        });
+    }
+
+    size_t size() const
+    {
+        std::unique_lock lock(x_values);
+        return m_values.size();
+    }
+
+private:
+    using Key = std::pair<std::string, int64_t>;
+
+    void insert(const Key& _key, const Value& _value)
+    {
+        if (!m_values.emplace(_key, _value).second)
+        {
+            return;
+        }
+        m_order.push_back(_key);
+        if (m_order.size() > m_capacity)
+        {
+            m_values.erase(m_order.front());
+            m_order.pop_front();
+        }
+    }
+
+    size_t m_capacity;
+    mutable std::mutex x_values;
+    std::map<Key, Value> m_values;
+    // the keys of m_values, the oldest first
+    std::deque<Key> m_order;
+    std::map<Key, std::vector<Callback>> m_fetching;
+};
+
+}  // namespace event
+}  // namespace bcos
@@ -21,16 +21,90 @@
 #include <bcos-rpc/event/Common.h>
 #include <bcos-rpc/event/EventSubMatcher.h>
 #include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <algorithm>
+#include <optional>
 
 using namespace bcos;
 using namespace bcos::event;
 
+EventSubBloomFilter::EventSubBloomFilter(const EventSubParams& _params)
+{
+    if (!_params.addresses().empty())
+    {
+        auto& group = m_groups.emplace_back();
+        for (const auto& address : _params.addresses())
+        {
+            group.emplace_back(address);
+        }
+    }
+
+    for (const auto& topics : _params.topics())
+    {
+        if (topics.empty())
+        {
+            continue;
+        }
+        std::vector<bcos::protocol::LogBloom> group;
+        for (const auto& topic : topics)
+        {
+            bcos::bytes topicBytes;
+            try
+            {
+                topicBytes = fromHex(topic);
+            }
+            catch (std::exception const&)
+            {}
+            if (topicBytes.size() != bcos::h256::SIZE)
+            {
+                // not a topic the bloom can tell, keep the position unfiltered
+                group.clear();
+                break;
+            }
+            group.emplace_back(std::string_view((const char*)topicBytes.data(), topicBytes.size()));
+        }
+        if (!group.empty())
+        {
+            m_groups.emplace_back(std::move(group));
+        }
+    }
+}
+
+bool EventSubBloomFilter::mayMatch(const bcos::protocol::LogBloom& _bloom) const
+{
+    return std::all_of(m_groups.begin(), m_groups.end(), [&_bloom](const auto& group) {
+        return std::any_of(group.begin(), group.end(),
+            [&_bloom](const auto& itemBloom) { return _bloom.contains(itemBloom); });
+    });
+}
+
 uint32_t EventSubMatcher::matches(
     EventSubParams::ConstPtr _params, bcos::protocol::Block::ConstPtr _block, Json::Value& _result)
 {
+    return matches(std::move(_params), std::move(_block), nullptr, _result);
+}
+
+uint32_t EventSubMatcher::matches(EventSubParams::ConstPtr _params,
+    bcos::protocol::Block::ConstPtr _block, const bcos::protocol::BlockLogBloom* _blockLogBloom,
+    Json::Value& _result)
+{
+    std::optional<EventSubBloomFilter> bloomFilter;
+    if (_blockLogBloom)
+    {
+        bloomFilter.emplace(*_params);
+    }
+
     uint32_t count = 0;
     for (std::size_t index = 0; index < _block->transactionsSize(); index++)
     {
+        if (bloomFilter)
+        {
+            const auto* receiptBloom = _blockLogBloom->receiptBloom(index);
+            if (!receiptBloom || !bloomFilter->mayMatch(*receiptBloom))
+            {
+                continue;
+            }
+        }
         count +=
             matches(_params, _block->receipt(index), _block->transaction(index), index, _result);
     }
@@ -50,20 +124,7 @@ uint32_t EventSubMatcher::matches(EventSubParams::ConstPtr _params,
         if (matches(_params, logEntry))
         {
             count++;
-
-            Json::Value jResp;
-            jResp["blockNumber"] = _receipt->blockNumber();
-            jResp["address"] = std::string(logEntry.address());
-            jResp["data"] = toHexStringWithPrefix(logEntry.data());
-            jResp["logIndex"] = (uint64_t)logIndex;
-            jResp["transactionHash"] = _tx->hash().hexPrefixed();
-            jResp["transactionIndex"] = (uint64_t)_txIndex;
-            jResp["topics"] = Json::Value(Json::arrayValue);
-            for (const auto& topic : logEntry.topics())
-            {
-                jResp["topics"].append(topic.hexPrefixed());
-            }
-            _result.append(jResp);
+            _result.append(toJson(*_receipt, *_tx, _txIndex, logEntry, logIndex));
         }
 
         logIndex += 1;
@@ -72,6 +133,121 @@ uint32_t EventSubMatcher::matches(EventSubParams::ConstPtr _params,
     return count;
 }
 
+Json::Value EventSubMatcher::toJson(const bcos::protocol::TransactionReceipt& _receipt,
+    const bcos::protocol::Transaction& _tx, std::size_t _txIndex,
+    const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex)
+{
+    Json::Value jResp;
+    jResp["blockNumber"] = _receipt.blockNumber();
+    jResp["address"] = std::string(_logEntry.address());
+    jResp["data"] = toHexStringWithPrefix(_logEntry.data());
+    jResp["logIndex"] = (uint64_t)_logIndex;
+    jResp["transactionHash"] = _tx.hash().hexPrefixed();
+    jResp["transactionIndex"] = (uint64_t)_txIndex;
+    jResp["topics"] = Json::Value(Json::arrayValue);
+    for (const auto& topic : _logEntry.topics())
+    {
+        jResp["topics"].append(topic.hexPrefixed());
+    }
+    return jResp;
+}
+
+EventSubBlock::ConstPtr EventSubMatcher::decode(bcos::protocol::Block::ConstPtr _block)
+{
+    auto eventSubBlock = std::make_shared<EventSubBlock>();
+    eventSubBlock->blockNumber = _block->blockHeaderConst()->number();
+    for (std::size_t index = 0; index < _block->transactionsSize(); index++)
+    {
+        auto receipt = _block->receipt(index);
+        const auto& logEntries = receipt->logEntries();
+        if (logEntries.empty())
+        {
+            continue;
+        }
+        auto tx = _block->transaction(index);
+        std::size_t logIndex = 0;
+        for (const auto& logEntry : logEntries)
+        {
+            eventSubBlock->logs.push_back(
+                {logEntry, toJson(*receipt, *tx, index, logEntry, logIndex)});
+            logIndex += 1;
+        }
+    }
+    return eventSubBlock;
+}
+
+EventSubIndex::EventSubIndex(const std::vector<EventSubParams::ConstPtr>& _params)
+  : m_params(_params)
+{
+    for (std::size_t index = 0; index < m_params.size(); ++index)
+    {
+        const auto& params = *m_params[index];
+        if (params.addresses().empty())
+        {
+            addToTopicIndex(m_anyAddress, params, index);
+            continue;
+        }
+        for (const auto& address : params.addresses())
+        {
+            addToTopicIndex(m_byAddress[address], params, index);
+        }
+    }
+}
+
+void EventSubIndex::addToTopicIndex(
+    TopicIndex& _topicIndex, const EventSubParams& _params, std::size_t _index)
+{
+    const auto& topics = _params.topics();
+    if (topics.empty() || topics[0].empty())
+    {
+        _topicIndex.anyTopic.push_back(_index);
+        return;
+    }
+    for (const auto& topic : topics[0])
+    {
+        _topicIndex.byTopic[topic].push_back(_index);
+    }
+}
+
+std::vector<Json::Value> EventSubIndex::matches(
+    EventSubMatcher& _matcher, const EventSubBlock& _block) const
+{
+    std::vector<Json::Value> result(m_params.size(), Json::Value(Json::arrayValue));
+    for (const auto& log : _block.logs)
+    {
+        auto it = m_byAddress.find(std::string(log.logEntry.address()));
+        if (it != m_byAddress.end())
+        {
+            matches(_matcher, it->second, log, result);
+        }
+        matches(_matcher, m_anyAddress, log, result);
+    }
+    return result;
+}
+
+void EventSubIndex::matches(EventSubMatcher& _matcher, const TopicIndex& _topicIndex,
+    const EventSubBlock::Log& _log, std::vector<Json::Value>& _result) const
+{
+    auto match = [&](std::size_t _index) {
+        // the index only tells the address and the first topic, the other topics are compared here
+        if (_matcher.matches(m_params[_index], _log.logEntry))
+        {
+            _result[_index].append(_log.json);
+        }
+    };
+
+    const auto& topics = _log.logEntry.topics();
+    if (!topics.empty() && !_topicIndex.byTopic.empty())
+    {
+        auto it = _topicIndex.byTopic.find(topics[0].hex());
+        if (it != _topicIndex.byTopic.end())
+        {
+            std::for_each(it->second.begin(), it->second.end(), match);
+        }
+    }
+    std::for_each(_topicIndex.anyTopic.begin(), _topicIndex.anyTopic.end(), match);
+}
+
 bool EventSubMatcher::matches(
     EventSubParams::ConstPtr _params, const bcos::protocol::LogEntry& _logEntry)
 {
@@ -19,16 +19,74 @@
  */
 #pragma once
 #include <bcos-framework/protocol/Block.h>
+#include <bcos-framework/protocol/LogBloom.h>
 #include <bcos-framework/protocol/LogEntry.h>
 #include <bcos-framework/protocol/ProtocolTypeDef.h>
 #include <bcos-framework/protocol/TransactionReceipt.h>
 #include <bcos-rpc/event/EventSubParams.h>
 #include <json/json.h>
+#include <unordered_map>
+#include <vector>
 
 namespace bcos
 {
 namespace event
 {
+// The blooms of the addresses and the topics of the params: a log can only match if the bloom of
+// its receipt or block has one of the addresses and one of the topics of each topic position
+class EventSubBloomFilter
+{
+public:
+    explicit EventSubBloomFilter(const EventSubParams& _params);
+
+    bool mayMatch(const bcos::protocol::LogBloom& _bloom) const;
+
+private:
+    std::vector<std::vector<bcos::protocol::LogBloom>> m_groups;
+};
+
+// The logs of a block with their json, decoded once for all the event sub tasks
+struct EventSubBlock
+{
+    using ConstPtr = std::shared_ptr<const EventSubBlock>;
+    struct Log
+    {
+        bcos::protocol::LogEntry logEntry;
+        Json::Value json;
+    };
+
+    int64_t blockNumber = -1;
+    std::vector<Log> logs;
+};
+
+class EventSubMatcher;
+// The params of the event sub tasks indexed by address then by first topic, each log of a block is
+// only compared to the tasks of its address and first topic and to the tasks without them
+class EventSubIndex
+{
+public:
+    explicit EventSubIndex(const std::vector<EventSubParams::ConstPtr>& _params);
+
+    // The logs matched by each params, in the order of the params
+    std::vector<Json::Value> matches(
+        EventSubMatcher& _matcher, const EventSubBlock& _block) const;
+
+private:
+    struct TopicIndex
+    {
+        std::unordered_map<std::string, std::vector<std::size_t>> byTopic;
+        std::vector<std::size_t> anyTopic;
+    };
+    static void addToTopicIndex(
+        TopicIndex& _topicIndex, const EventSubParams& _params, std::size_t _index);
+    void matches(EventSubMatcher& _matcher, const TopicIndex& _topicIndex,
+        const EventSubBlock::Log& _log, std::vector<Json::Value>& _result) const;
+
+    std::vector<EventSubParams::ConstPtr> m_params;
+    std::unordered_map<std::string, TopicIndex> m_byAddress;
+    TopicIndex m_anyAddress;
+};
+
 class EventSubMatcher
 {
 public:
@@ -47,6 +105,14 @@ public:
         bcos::protocol::Transaction::ConstPtr _tx, std::size_t _txIndex, Json::Value& _result);
     uint32_t matches(EventSubParams::ConstPtr _params, bcos::protocol::Block::ConstPtr _block,
         Json::Value& _result);
+    // Only the receipts whose bloom may match are decoded, all of them without bloom
+    uint32_t matches(EventSubParams::ConstPtr _params, bcos::protocol::Block::ConstPtr _block,
+        const bcos::protocol::BlockLogBloom* _blockLogBloom, Json::Value& _result);
+
+    static EventSubBlock::ConstPtr decode(bcos::protocol::Block::ConstPtr _block);
+    static Json::Value toJson(const bcos::protocol::TransactionReceipt& _receipt,
+        const bcos::protocol::Transaction& _tx, std::size_t _txIndex,
+        const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex);
 };
 
 }  // namespace event
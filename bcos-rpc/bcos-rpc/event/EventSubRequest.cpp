@@ -169,6 +169,67 @@ std::string EventSubRequest::generateJson() const
     return result;
 }
 
+void EventSubRequest::paramsFromJson(const Json::Value& _jParams, EventSubParams& _params)
+{
+    if (_jParams.isMember("fromBlock"))
+    {
+        _params.setFromBlock(_jParams["fromBlock"].asInt64());
+    }
+
+    if (_jParams.isMember("toBlock"))
+    {
+        _params.setToBlock(_jParams["toBlock"].asInt64());
+    }
+
+    if (_jParams.isMember("addresses"))
+    {
+        auto& jAddresses = _jParams["addresses"];
+        for (Json::Value::ArrayIndex index = 0; index < jAddresses.size(); ++index)
+        {
+            std::string address = jAddresses[index].asString();
+            if ((address.compare(0, 2, "0x") == 0) || (address.compare(0, 2, "0X") == 0))
+            {
+                address = address.substr(2);
+            }
+            // std::transform(address.begin(), address.end(), address.begin(), ::tolower);
+            _params.addAddress(address);
+        }
+    }
+
+    if (_jParams.isMember("topics"))
+    {
+        auto& jTopics = _jParams["topics"];
+
+        for (Json::Value::ArrayIndex index = 0; index < jTopics.size(); ++index)
+        {
+            auto& jIndex = jTopics[index];
+            if (jIndex.isNull())
+            {
+                continue;
+            }
+
+            if (jIndex.isArray())
+            {  // array topics
+                for (Json::Value::ArrayIndex innerIndex = 0; innerIndex < jIndex.size();
+                     ++innerIndex)
+                {
+                    std::string topic = jIndex[innerIndex].asString();
+                    if ((topic.compare(0, 2, "0x") == 0) || (topic.compare(0, 2, "0XC") == 0))
+                    {
+                        topic = topic.substr(2);
+                    }
+                    std::transform(topic.begin(), topic.end(), topic.begin(), ::tolower);
+                    _params.addTopic(index, topic);
+                }
+            }
+            else
+            {  // single topic, string value
+                _params.addTopic(index, jIndex.asString());
+            }
+        }
+    }
+}
+
 bool EventSubRequest::fromJson(const std::string& _request)
 {
     std::string id;
@@ -209,65 +270,7 @@ bool EventSubRequest::fromJson(const std::string& _request)
                 break;
             }
 
-            auto& jParams = root["params"];
-            if (jParams.isMember("fromBlock"))
-            {
-                params->setFromBlock(jParams["fromBlock"].asInt64());
-            }
-
-            if (jParams.isMember("toBlock"))
-            {
-                params->setToBlock(jParams["toBlock"].asInt64());
-            }
-
-            if (jParams.isMember("addresses"))
-            {
-                auto& jAddresses = jParams["addresses"];
-                for (Json::Value::ArrayIndex index = 0; index < jAddresses.size(); ++index)
-                {
-                    std::string address = jAddresses[index].asString();
-                    if ((address.compare(0, 2, "0x") == 0) || (address.compare(0, 2, "0X") == 0))
-                    {
-                        address = address.substr(2);
-                    }
-                    // std::transform(address.begin(), address.end(), address.begin(), ::tolower);
-                    params->addAddress(address);
-                }
-            }
-
-            if (jParams.isMember("topics"))
-            {
-                auto& jTopics = jParams["topics"];
-
-                for (Json::Value::ArrayIndex index = 0; index < jTopics.size(); ++index)
-                {
-                    auto& jIndex = jTopics[index];
-                    if (jIndex.isNull())
-                    {
-                        continue;
-                    }
-
-                    if (jIndex.isArray())
-                    {  // array topics
-                        for (Json::Value::ArrayIndex innerIndex = 0; innerIndex < jIndex.size();
-                             ++innerIndex)
-                        {
-                            std::string topic = jIndex[innerIndex].asString();
-                            if ((topic.compare(0, 2, "0x") == 0) ||
-                                (topic.compare(0, 2, "0XC") == 0))
-                            {
-                                topic = topic.substr(2);
-                            }
-                            std::transform(topic.begin(), topic.end(), topic.begin(), ::tolower);
-                            params->addTopic(index, topic);
-                        }
-                    }
-                    else
-                    {  // single topic, string value
-                        params->addTopic(index, jIndex.asString());
-                    }
-                }
-            }
+            paramsFromJson(root["params"], *params);
 
             setId(id);
             setGroup(group);
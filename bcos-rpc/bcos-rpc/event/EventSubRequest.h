@@ -20,6 +20,7 @@
 
 #pragma once
 #include <bcos-rpc/event/EventSubParams.h>
+#include <json/json.h>
 
 namespace bcos
 {
@@ -62,6 +63,9 @@ public:
     std::string generateJson() const override;
     bool fromJson(const std::string& _request) override;
 
+    // Parse the fromBlock, toBlock, addresses and topics fields of a filter
+    static void paramsFromJson(const Json::Value& _jParams, EventSubParams& _params);
+
 private:
     std::shared_ptr<EventSubParams> m_params;
     std::shared_ptr<EventSubTaskState> m_state;
@@ -31,6 +31,7 @@ namespace bcos
 namespace event
 {
 using Callback = std::function<bool(const std::string&, bool, const Json::Value&)>;
+class EventSubBloomFilter;
 
 class EventSubTaskState
 {
@@ -74,6 +75,16 @@ public:
     void setParams(std::shared_ptr<EventSubParams> _params) { m_params = _params; }
     std::shared_ptr<EventSubParams> params() const { return m_params; }
 
+    void setBloomFilter(std::shared_ptr<const EventSubBloomFilter> _bloomFilter)
+    {
+        m_bloomFilter = std::move(_bloomFilter);
+    }
+    // the blooms of the params, null if the blocks are not to be filtered by their bloom
+    const std::shared_ptr<const EventSubBloomFilter>& bloomFilter() const
+    {
+        return m_bloomFilter;
+    }
+
     void setState(std::shared_ptr<EventSubTaskState> _state) { m_state = _state; }
     std::shared_ptr<EventSubTaskState> state() const { return m_state; }
 
@@ -109,6 +120,7 @@ private:
 
     std::shared_ptr<bcos::boostssl::ws::WsSession> m_session;
     std::shared_ptr<EventSubParams> m_params;
+    std::shared_ptr<const EventSubBloomFilter> m_bloomFilter;
     std::shared_ptr<EventSubTaskState> m_state;
 
 private:
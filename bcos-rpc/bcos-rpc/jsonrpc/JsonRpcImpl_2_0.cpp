@@ -31,6 +31,8 @@
 #include <bcos-framework/protocol/Transaction.h>
 #include <bcos-framework/protocol/TransactionReceipt.h>
 #include <bcos-protocol/TransactionStatus.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <bcos-rpc/event/EventSubRequest.h>
 #include <bcos-rpc/jsonrpc/Common.h>
 #include <bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h>
 #include <bcos-task/Wait.h>
@@ -44,6 +46,8 @@
 #include <boost/archive/iterators/transform_width.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <atomic>
 #include <exception>
 #include <iterator>
 #include <stdexcept>
@@ -371,6 +375,146 @@ void bcos::rpc::toJsonResp(Json::Value& jResp, bcos::protocol::Block& block, boo
     jResp["transactions"] = jTxs;
 }
 
+void bcos::rpc::toJsonStream(JsonWriter& writer, bcos::protocol::Transaction const& transaction)
+{
+    writer.startObject();
+    writer.key("version");
+    writer.value(transaction.version());
+    writer.key("hash");
+    writer.hexValue(transaction.hash());
+    writer.key("nonce");
+    writer.hexValue(transaction.nonce(), {});
+    writer.key("blockLimit");
+    writer.value(transaction.blockLimit());
+    writer.key("to");
+    writer.value(transaction.to());
+    writer.key("input");
+    writer.hexValue(transaction.input());
+    writer.key("from");
+    writer.hexValue(transaction.sender());
+    writer.key("importTime");
+    writer.value(transaction.importTime());
+    writer.key("chainID");
+    writer.value(transaction.chainId());
+    writer.key("groupID");
+    writer.value(transaction.groupId());
+    writer.key("abi");
+    writer.value(transaction.abi());
+    writer.key("signature");
+    writer.hexValue(transaction.signatureData());
+    writer.key("extraData");
+    writer.value(transaction.extraData());
+    writer.endObject();
+}
+
+static void writeBlockHeaderFields(
+    JsonWriter& writer, bcos::protocol::BlockHeader const& _blockHeader)
+{
+    writer.key("hash");
+    writer.hexValue(_blockHeader.hash());
+    writer.key("version");
+    writer.value(_blockHeader.version());
+    writer.key("txsRoot");
+    writer.hexValue(_blockHeader.txsRoot());
+    writer.key("receiptsRoot");
+    writer.hexValue(_blockHeader.receiptsRoot());
+    writer.key("stateRoot");
+    writer.hexValue(_blockHeader.stateRoot());
+    writer.key("number");
+    writer.value(_blockHeader.number());
+    writer.key("gasUsed");
+    writer.value(_blockHeader.gasUsed().str(16));
+    writer.key("timestamp");
+    writer.value(_blockHeader.timestamp());
+    writer.key("sealer");
+    writer.value(_blockHeader.sealer());
+    writer.key("extraData");
+    writer.hexValue(_blockHeader.extraData());
+
+    writer.key("consensusWeights");
+    writer.startArray();
+    for (const auto& wei : _blockHeader.consensusWeights())
+    {
+        writer.value(wei);
+    }
+    writer.endArray();
+
+    writer.key("sealerList");
+    writer.startArray();
+    for (const auto& sealer : _blockHeader.sealerList())
+    {
+        writer.hexValue(sealer);
+    }
+    writer.endArray();
+
+    writer.key("parentInfo");
+    writer.startArray();
+    for (const auto& p : _blockHeader.parentInfo())
+    {
+        writer.startObject();
+        writer.key("blockNumber");
+        writer.value(p.blockNumber);
+        writer.key("blockHash");
+        writer.hexValue(p.blockHash);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.key("signatureList");
+    writer.startArray();
+    for (const auto& sign : _blockHeader.signatureList())
+    {
+        writer.startObject();
+        writer.key("sealerIndex");
+        writer.value(sign.index);
+        writer.key("signature");
+        writer.hexValue(sign.signature);
+        writer.endObject();
+    }
+    writer.endArray();
+}
+
+void bcos::rpc::toJsonStream(JsonWriter& writer, bcos::protocol::BlockHeader::Ptr _blockHeaderPtr)
+{
+    if (!_blockHeaderPtr)
+    {
+        writer.null();
+        return;
+    }
+    writer.startObject();
+    writeBlockHeaderFields(writer, *_blockHeaderPtr);
+    writer.endObject();
+}
+
+void bcos::rpc::toJsonStream(JsonWriter& writer, bcos::protocol::Block& block, bool _onlyTxHash)
+{
+    writer.startObject();
+    // header
+    auto blockHeader = block.blockHeader();
+    if (blockHeader)
+    {
+        writeBlockHeaderFields(writer, *blockHeader);
+    }
+    auto txSize = _onlyTxHash ? block.transactionsMetaDataSize() : block.transactionsSize();
+
+    // each transaction is written when it is decoded, no tree of the transactions is built
+    writer.key("transactions");
+    writer.startArray();
+    for (std::size_t index = 0; index < txSize; ++index)
+    {
+        if (_onlyTxHash)
+        {
+            writer.hexValue(block.transactionMetaData(index)->hash());
+        }
+        else
+        {
+            toJsonStream(writer, *block.transaction(index));
+        }
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
 void JsonRpcImpl_2_0::call(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _to, std::string_view _data, RespFunc _respFunc)
 {
@@ -689,6 +833,43 @@ void JsonRpcImpl_2_0::getTransactionReceipt(std::string_view _groupID, std::stri
 
 void JsonRpcImpl_2_0::getBlockByHash(std::string_view _groupID, std::string_view _nodeName,
     std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
+{
+    getBlockNumberByHash(_groupID, _nodeName, _blockHash, _onlyHeader, _onlyTxHash,
+        [m_groupID = std::string(_groupID), m_nodeName = std::string(_nodeName), _onlyHeader,
+            _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            JsonRpcImpl_2_0& _rpc, Error::Ptr _error, protocol::BlockNumber _blockNumber) mutable {
+            if (_error)
+            {
+                Json::Value jResp;
+                m_respFunc(_error, jResp);
+                return;
+            }
+            // call getBlockByNumber
+            _rpc.getBlockByNumber(m_groupID, m_nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+                std::move(m_respFunc));
+        });
+}
+
+void JsonRpcImpl_2_0::streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+    std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    getBlockNumberByHash(_groupID, _nodeName, _blockHash, _onlyHeader, _onlyTxHash,
+        [m_groupID = std::string(_groupID), m_nodeName = std::string(_nodeName), _onlyHeader,
+            _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            JsonRpcImpl_2_0& _rpc, Error::Ptr _error, protocol::BlockNumber _blockNumber) mutable {
+            if (_error)
+            {
+                m_respFunc(_error, nullptr);
+                return;
+            }
+            _rpc.streamBlockByNumber(m_groupID, m_nodeName, _blockNumber, _onlyHeader,
+                _onlyTxHash, std::move(m_respFunc));
+        });
+}
+
+void JsonRpcImpl_2_0::getBlockNumberByHash(std::string_view _groupID, std::string_view _nodeName,
+    std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
+    std::function<void(JsonRpcImpl_2_0&, Error::Ptr, protocol::BlockNumber)> _onGetNumber)
 {
     RPC_IMPL_LOG(TRACE) << LOG_DESC("getBlockByHash") << LOG_KV("blockHash", _blockHash)
                         << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
@@ -700,35 +881,78 @@ void JsonRpcImpl_2_0::getBlockByHash(std::string_view _groupID, std::string_view
     auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
     ledger->asyncGetBlockNumberByHash(
         bcos::crypto::HashType(_blockHash, bcos::crypto::HashType::FromHex),
-        [m_groupID = std::string(_groupID), m_nodeName = std::string(_nodeName),
-            m_blockHash = std::string(_blockHash), _onlyHeader, _onlyTxHash,
-            m_respFunc = std::move(_respFunc),
+        [m_blockHash = std::string(_blockHash), _onlyHeader, _onlyTxHash,
+            m_onGetNumber = std::move(_onGetNumber),
             self](Error::Ptr _error, protocol::BlockNumber blockNumber) {
+            auto rpc = self.lock();
+            if (!rpc)
+            {
+                return;
+            }
             if (!_error || _error->errorCode() == bcos::protocol::CommonError::SUCCESS)
             {
-                auto rpc = self.lock();
-                if (rpc)
+                m_onGetNumber(*rpc, nullptr, blockNumber);
+                return;
+            }
+            RPC_IMPL_LOG(INFO) << LOG_BADGE("getBlockByHash failed")
+                               << LOG_KV("blockHash", m_blockHash)
+                               << LOG_KV("onlyHeader", _onlyHeader)
+                               << LOG_KV("onlyTxHash", _onlyTxHash)
+                               << LOG_KV("code", _error ? _error->errorCode() : 0)
+                               << LOG_KV("message", _error ? _error->errorMessage() : "success");
+            m_onGetNumber(*rpc, std::move(_error), blockNumber);
+        });
+}
+
+void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
+{
+    getBlock(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+        [_onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            Error::Ptr _error, protocol::Block::Ptr _block) {
+            Json::Value jResp;
+            if (!_error)
+            {
+                if (_onlyHeader)
+                {
+                    toJsonResp(jResp, _block ? _block->blockHeader() : nullptr);
+                }
+                else
                 {
-                    // call getBlockByNumber
-                    return rpc->getBlockByNumber(m_groupID, m_nodeName, blockNumber, _onlyHeader,
-                        _onlyTxHash, std::move(m_respFunc));
+                    toJsonResp(jResp, *_block, _onlyTxHash);
                 }
             }
-            else
+            m_respFunc(_error, jResp);
+        });
+}
+
+void JsonRpcImpl_2_0::streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+{
+    getBlock(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+        [_onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+            Error::Ptr _error, protocol::Block::Ptr _block) {
+            if (_error)
             {
-                RPC_IMPL_LOG(INFO)
-                    << LOG_BADGE("getBlockByHash failed") << LOG_KV("blockHash", m_blockHash)
-                    << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
-                    << LOG_KV("code", _error ? _error->errorCode() : 0)
-                    << LOG_KV("message", _error ? _error->errorMessage() : "success");
-                Json::Value jResp;
-                m_respFunc(_error, jResp);
+                m_respFunc(_error, nullptr);
+                return;
             }
+            m_respFunc(nullptr, [&](JsonWriter& _writer) {
+                if (_onlyHeader)
+                {
+                    toJsonStream(_writer, _block ? _block->blockHeader() : nullptr);
+                }
+                else
+                {
+                    toJsonStream(_writer, *_block, _onlyTxHash);
+                }
+            });
         });
 }
 
-void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
-    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc)
+void JsonRpcImpl_2_0::getBlock(std::string_view _groupID, std::string_view _nodeName,
+    int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+    std::function<void(Error::Ptr, protocol::Block::Ptr)> _onGetBlock)
 {
     RPC_IMPL_LOG(TRACE) << LOG_DESC("getBlockByNumber") << LOG_KV("_blockNumber", _blockNumber)
                         << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
@@ -742,9 +966,8 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_vi
                     (_onlyTxHash ? bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS_HASH :
                                    bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS);
     ledger->asyncGetBlockDataByNumber(_blockNumber, flag,
-        [_blockNumber, _onlyHeader, _onlyTxHash, m_respFunc = std::move(_respFunc)](
+        [_blockNumber, _onlyHeader, _onlyTxHash, m_onGetBlock = std::move(_onGetBlock)](
             Error::Ptr _error, protocol::Block::Ptr _block) {
-            Json::Value jResp;
             if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
             {
                 RPC_IMPL_LOG(INFO)
@@ -752,19 +975,10 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string_view _groupID, std::string_vi
                     << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
                     << LOG_KV("code", _error ? _error->errorCode() : 0)
                     << LOG_KV("message", _error ? _error->errorMessage() : "success");
+                m_onGetBlock(std::move(_error), nullptr);
+                return;
             }
-            else
-            {
-                if (_onlyHeader)
-                {
-                    toJsonResp(jResp, _block ? _block->blockHeader() : nullptr);
-                }
-                else
-                {
-                    toJsonResp(jResp, *_block, _onlyTxHash);
-                }
-            }
-            m_respFunc(_error, jResp);
+            m_onGetBlock(nullptr, std::move(_block));
         });
 }
 
@@ -1182,6 +1396,212 @@ void JsonRpcImpl_2_0::getTotalTransactionCount(
         m_respFunc(_error, jResp);
     });
 }
+namespace
+{
+// The widest block range a getLogs request scans, and the most blocks with logs it reads from the
+// log index
+constexpr static int64_t c_maxGetLogsBlockRange = 10000;
+
+// Await a ledger method calling back an error and a result, without suspending if the ledger calls
+// back synchronously: a loop over many blocks then does not grow the stack
+template <class Result>
+class LedgerAwaitable
+{
+public:
+    using Callback = std::function<void(Error::Ptr, Result)>;
+    explicit LedgerAwaitable(std::function<void(Callback)> call) : m_call(std::move(call)) {}
+
+    constexpr static bool await_ready() noexcept { return false; }
+    bool await_suspend(CO_STD::coroutine_handle<> handle)
+    {
+        m_call([this, handle](Error::Ptr error, Result result) {
+            m_error = std::move(error);
+            m_result.emplace(std::move(result));
+            if (m_finished.exchange(true))
+            {
+                handle.resume();
+            }
+        });
+        return !m_finished.exchange(true);
+    }
+    Result await_resume()
+    {
+        if (m_error && m_error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+        {
+            BOOST_THROW_EXCEPTION(*m_error);
+        }
+        return std::move(*m_result);
+    }
+
+private:
+    std::function<void(Callback)> m_call;
+    Error::Ptr m_error;
+    std::optional<Result> m_result;
+    std::atomic_bool m_finished = false;
+};
+}  // namespace
+
+void JsonRpcImpl_2_0::getLogs(std::string_view _groupID, std::string_view _nodeName,
+    const Json::Value& _filter, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("getLogs") << LOG_KV("group", _groupID)
+                        << LOG_KV("node", _nodeName);
+
+    auto nodeService = getNodeService(_groupID, _nodeName, "getLogs");
+    auto ledger = nodeService->ledger();
+    checkService(ledger, "ledger");
+    auto params = std::make_shared<event::EventSubParams>();
+    event::EventSubRequest::paramsFromJson(_filter, *params);
+
+    task::wait([](bcos::ledger::LedgerInterface::Ptr ledger, event::EventSubParams::Ptr params,
+                   RespFunc respFunc) -> task::Task<void> {
+        Json::Value jResp(Json::arrayValue);
+        try
+        {
+            auto blockNumber = co_await LedgerAwaitable<protocol::BlockNumber>(
+                [&ledger](auto callback) { ledger->asyncGetBlockNumber(std::move(callback)); });
+            auto fromBlock = params->fromBlock() < 0 ? blockNumber : params->fromBlock();
+            auto toBlock = params->toBlock() < 0 ? blockNumber :
+                                                   std::min(params->toBlock(), blockNumber);
+
+            // The blocks with logs of the addresses are read from the log index up to the indexed
+            // number, the blocks after it are scanned
+            std::vector<protocol::BlockNumber> numbers;
+            auto scanFromBlock = fromBlock;
+            if (!params->addresses().empty() && fromBlock <= toBlock)
+            {
+                std::vector<std::string> topic0s{std::string()};
+                if (!params->topics().empty() && !params->topics()[0].empty())
+                {
+                    topic0s.assign(params->topics()[0].begin(), params->topics()[0].end());
+                }
+                auto indexedNumber = toBlock;
+                for (const auto& address : params->addresses())
+                {
+                    for (const auto& topic0 : topic0s)
+                    {
+                        auto [number, blockNumbers] = co_await LedgerAwaitable<
+                            std::pair<protocol::BlockNumber, std::vector<protocol::BlockNumber>>>(
+                            [&](auto callback) {
+                                // one block more than the limit tells it is exceeded
+                                ledger->asyncGetIndexedLogBlocks(address, topic0, fromBlock,
+                                    toBlock, c_maxGetLogsBlockRange + 1,
+                                    [callback = std::move(callback)](Error::Ptr error,
+                                        protocol::BlockNumber indexedNumber,
+                                        std::vector<protocol::BlockNumber> blockNumbers) {
+                                        callback(std::move(error),
+                                            {indexedNumber, std::move(blockNumbers)});
+                                    });
+                            });
+                        indexedNumber = std::min(indexedNumber, number);
+                        numbers.insert(numbers.end(), blockNumbers.begin(), blockNumbers.end());
+                    }
+                }
+                if (indexedNumber >= fromBlock)
+                {
+                    std::sort(numbers.begin(), numbers.end());
+                    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+                    numbers.erase(std::upper_bound(numbers.begin(), numbers.end(), indexedNumber),
+                        numbers.end());
+                    scanFromBlock = indexedNumber + 1;
+                }
+                else
+                {
+                    numbers.clear();
+                }
+            }
+            if (toBlock - scanFromBlock >= c_maxGetLogsBlockRange)
+            {
+                BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidParams,
+                    "The block range of getLogs exceeds " +
+                        std::to_string(c_maxGetLogsBlockRange)));
+            }
+            if ((int64_t)numbers.size() > c_maxGetLogsBlockRange)
+            {
+                BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidParams,
+                    "The blocks with logs of getLogs exceed " +
+                        std::to_string(c_maxGetLogsBlockRange)));
+            }
+            auto indexedBlocks = numbers.size();
+            for (auto number = scanFromBlock; number <= toBlock; ++number)
+            {
+                numbers.push_back(number);
+            }
+
+            event::EventSubBloomFilter bloomFilter(*params);
+            event::EventSubMatcher matcher;
+            size_t skippedBlocks = 0;
+            for (auto number : numbers)
+            {
+                // A block without bloom is matched log by log, the empty bloom of a block
+                // tells it has no log
+                auto blockBloom = co_await LedgerAwaitable<std::optional<protocol::LogBloom>>(
+                    [&ledger, number](auto callback) {
+                        ledger->asyncGetBlockLogBloom(number,
+                            [callback = std::move(callback)](
+                                Error::Ptr /*error*/, std::optional<protocol::LogBloom> bloom) {
+                                callback(nullptr, std::move(bloom));
+                            });
+                    });
+                if (blockBloom && (blockBloom->empty() || !bloomFilter.mayMatch(*blockBloom)))
+                {
+                    ++skippedBlocks;
+                    continue;
+                }
+                // The blooms of the receipts are only read for the blocks which may match
+                std::optional<protocol::BlockLogBloom> blockLogBloom;
+                if (blockBloom)
+                {
+                    blockLogBloom =
+                        co_await LedgerAwaitable<std::optional<protocol::BlockLogBloom>>(
+                            [&ledger, number](auto callback) {
+                                ledger->asyncGetReceiptLogBlooms(number,
+                                    [callback = std::move(callback)](Error::Ptr /*error*/,
+                                        std::optional<protocol::BlockLogBloom> blooms) {
+                                        callback(nullptr, std::move(blooms));
+                                    });
+                            });
+                }
+
+                auto block = co_await LedgerAwaitable<protocol::Block::Ptr>(
+                    [&ledger, number](auto callback) {
+                        ledger->asyncGetBlockDataByNumber(number,
+                            bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS,
+                            std::move(callback));
+                    });
+                matcher.matches(params, std::move(block),
+                    blockLogBloom ? std::addressof(*blockLogBloom) : nullptr, jResp);
+            }
+
+            RPC_IMPL_LOG(TRACE) << LOG_BADGE("getLogs") << LOG_KV("fromBlock", fromBlock)
+                                << LOG_KV("toBlock", toBlock)
+                                << LOG_KV("indexedBlocks", indexedBlocks)
+                                << LOG_KV("skippedBlocks", skippedBlocks)
+                                << LOG_KV("logs", jResp.size());
+        }
+        catch (JsonRpcException& e)
+        {
+            respFunc(BCOS_ERROR_PTR(e.code(), e.msg()), jResp);
+            co_return;
+        }
+        catch (bcos::Error& e)
+        {
+            RPC_IMPL_LOG(WARNING) << LOG_BADGE("getLogs failed") << LOG_KV("code", e.errorCode())
+                                  << LOG_KV("message", e.errorMessage());
+            respFunc(std::make_shared<bcos::Error>(std::move(e)), jResp);
+            co_return;
+        }
+        catch (std::exception& e)
+        {
+            auto info = boost::diagnostic_information(e);
+            RPC_IMPL_LOG(WARNING) << LOG_BADGE("getLogs failed") << LOG_KV("message", info);
+            respFunc(BCOS_ERROR_PTR(-1, std::move(info)), jResp);
+            co_return;
+        }
+        respFunc(nullptr, jResp);
+    }(std::move(ledger), std::move(params), std::move(_respFunc)));
+}
+
 void JsonRpcImpl_2_0::getPeers(RespFunc _respFunc)
 {
     RPC_IMPL_LOG(TRACE) << LOG_DESC("getPeers");
@@ -67,6 +67,14 @@ public:
     void getBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
         int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, RespFunc _respFunc) override;
 
+    void streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc) override;
+
+    void streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash,
+        StreamRespFunc _respFunc) override;
+
     void getBlockHashByNumber(std::string_view _groupID, std::string_view _nodeName,
         int64_t _blockNumber, RespFunc _respFunc) override;
 
@@ -106,6 +114,11 @@ public:
     void getTotalTransactionCount(
         std::string_view _groupID, std::string_view _nodeName, RespFunc _respFunc) override;
 
+    // The logs of the blocks [fromBlock, toBlock] matching the addresses and the topics of the
+    // filter, the blocks whose log bloom cannot match are not loaded
+    void getLogs(std::string_view _groupID, std::string_view _nodeName, const Json::Value& _filter,
+        RespFunc _respFunc) override;
+
     void getPeers(RespFunc _respFunc) override;
 
     // get all the groupID list
@@ -164,6 +177,15 @@ private:
     static void execCall(NodeService::Ptr nodeService, protocol::Transaction::Ptr _tx,
         bcos::rpc::RespFunc _respFunc);
 
+    // the block of getBlockByNumber and streamBlockByNumber, the error is nullptr on success
+    void getBlock(std::string_view _groupID, std::string_view _nodeName, int64_t _blockNumber,
+        bool _onlyHeader, bool _onlyTxHash,
+        std::function<void(Error::Ptr, protocol::Block::Ptr)> _onGetBlock);
+    // the block number of getBlockByHash and streamBlockByHash, not called if the rpc is released
+    void getBlockNumberByHash(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash,
+        std::function<void(JsonRpcImpl_2_0&, Error::Ptr, protocol::BlockNumber)> _onGetNumber);
+
     // ms
     int m_sendTxTimeout = -1;
 
@@ -195,5 +217,9 @@ void toJsonResp(Json::Value& jResp, bcos::protocol::Block& block, bool _onlyTxHa
 void toJsonResp(Json::Value& jResp, std::string_view _txHash, protocol::TransactionStatus status,
     bcos::protocol::TransactionReceipt const& transactionReceiptPtr, bool _isWasm,
     crypto::Hash& hashImpl);
+// the same json as toJsonResp, written into the response buffer
+void toJsonStream(JsonWriter& writer, bcos::protocol::Transaction const& transaction);
+void toJsonStream(JsonWriter& writer, bcos::protocol::BlockHeader::Ptr _blockHeaderPtr);
+void toJsonStream(JsonWriter& writer, bcos::protocol::Block& block, bool _onlyTxHash);
 
 }  // namespace bcos::rpc
\ No newline at end of file
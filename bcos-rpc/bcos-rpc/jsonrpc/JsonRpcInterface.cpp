@@ -1,13 +1,8 @@
 #include "JsonRpcInterface.h"
 #include <json/forwards.h>
-#include <boost/beast/core/ostream.hpp>
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/device/back_inserter.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <iterator>
-#include <ostream>
-#include <sstream>
+#include <json/reader.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <memory>
 
 using namespace bcos::rpc;
 
@@ -21,9 +16,9 @@ void JsonRpcInterface::initMethod()
         &JsonRpcInterface::getTransactionI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getTransactionReceipt"] = std::bind(&JsonRpcInterface::getTransactionReceiptI,
         this, std::placeholders::_1, std::placeholders::_2);
-    m_methodToFunc["getBlockByHash"] = std::bind(
+    m_methodToStreamFunc["getBlockByHash"] = std::bind(
         &JsonRpcInterface::getBlockByHashI, this, std::placeholders::_1, std::placeholders::_2);
-    m_methodToFunc["getBlockByNumber"] = std::bind(
+    m_methodToStreamFunc["getBlockByNumber"] = std::bind(
         &JsonRpcInterface::getBlockByNumberI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getBlockHashByNumber"] = std::bind(&JsonRpcInterface::getBlockHashByNumberI,
         this, std::placeholders::_1, std::placeholders::_2);
@@ -52,6 +47,8 @@ void JsonRpcInterface::initMethod()
     m_methodToFunc["getTotalTransactionCount"] =
         std::bind(&JsonRpcInterface::getTotalTransactionCountI, this, std::placeholders::_1,
             std::placeholders::_2);
+    m_methodToFunc["getLogs"] = std::bind(
+        &JsonRpcInterface::getLogsI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getPeers"] =
         std::bind(&JsonRpcInterface::getPeersI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getGroupPeers"] = std::bind(
@@ -70,7 +67,13 @@ void JsonRpcInterface::initMethod()
     {
         RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("method", method.first);
     }
-    RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("size", m_methodToFunc.size());
+    for (const auto& method : m_methodToStreamFunc)
+    {
+        RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod") << LOG_KV("method", method.first)
+                           << LOG_DESC("stream");
+    }
+    RPC_IMPL_LOG(INFO) << LOG_BADGE("initMethod")
+                       << LOG_KV("size", m_methodToFunc.size() + m_methodToStreamFunc.size());
 }
 
 void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sender)
@@ -84,33 +87,41 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
         response.jsonrpc = request.jsonrpc;
         response.id = request.id;
 
+        RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody);
+        StreamRespFunc respFunc = [response, _sender](
+                                      Error::Ptr _error, ResultWriter _writeResult) mutable {
+            bcos::bytes strResp;
+            if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
+            {
+                // error
+                response.error.code = _error->errorCode();
+                response.error.message = _error->errorMessage();
+                strResp = toStringResponse(std::move(response));
+            }
+            else
+            {
+                strResp = toStringResponse(response, _writeResult);
+            }
+            RPC_IMPL_LOG(TRACE)
+                << LOG_BADGE("onRPCRequest")
+                << LOG_KV("response",
+                       std::string_view((const char*)strResp.data(), strResp.size()));
+            _sender(std::move(strResp));
+        };
+
         const auto& method = request.method;
+        if (auto it = m_methodToStreamFunc.find(method); it != m_methodToStreamFunc.end())
+        {
+            it->second(std::move(request.params), std::move(respFunc));
+            return;
+        }
         auto it = m_methodToFunc.find(method);
         if (it == m_methodToFunc.end())
         {
             BOOST_THROW_EXCEPTION(JsonRpcException(
                 JsonRpcError::MethodNotFound, "The method does not exist/is not available."));
         }
-        RPC_IMPL_LOG(TRACE) << LOG_BADGE("onRPCRequest") << LOG_KV("request", _requestBody);
-        it->second(
-            request.params, [response, _sender](Error::Ptr _error, Json::Value& _result) mutable {
-                if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
-                {
-                    // error
-                    response.error.code = _error->errorCode();
-                    response.error.message = _error->errorMessage();
-                }
-                else
-                {
-                    response.result.swap(_result);
-                }
-                auto strResp = toStringResponse(std::move(response));
-                RPC_IMPL_LOG(TRACE)
-                    << LOG_BADGE("onRPCRequest")
-                    << LOG_KV("response",
-                           std::string_view((const char*)strResp.data(), strResp.size()));
-                _sender(std::move(strResp));
-            });
+        it->second(std::move(request.params), toRespFunc(std::move(respFunc)));
 
         // success response
         return;
@@ -138,60 +149,68 @@ void JsonRpcInterface::onRPCRequest(std::string_view _requestBody, Sender _sende
 
 void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest)
 {
+    // the reader keeps no state between parses, one reader for each thread saves its construction
+    thread_local std::unique_ptr<Json::CharReader> jsonReader = [] {
+        Json::CharReaderBuilder builder;
+        builder["collectComments"] = false;
+        return std::unique_ptr<Json::CharReader>(builder.newCharReader());
+    }();
     Json::Value root;
-    Json::Reader jsonReader;
+    auto member = [&root](std::string_view _key) {
+        return root.find(_key.data(), _key.data() + _key.size());
+    };
     std::string errorMessage;
 
     try
     {
-        std::string jsonrpc = "";
-        std::string method = "";
-        int64_t id = 0;
         do
         {
-            if (!jsonReader.parse(_requestBody.begin(), _requestBody.end(), root))
+            if (!jsonReader->parse(_requestBody.data(), _requestBody.data() + _requestBody.size(),
+                    &root, nullptr) ||
+                !root.isObject())
             {
                 errorMessage = "invalid request json object";
                 break;
             }
 
-            if (!root.isMember("jsonrpc"))
+            auto* jsonrpc = member("jsonrpc");
+            if (jsonrpc == nullptr)
             {
                 errorMessage = "request has no jsonrpc field";
                 break;
             }
-            jsonrpc = root["jsonrpc"].asString();
 
-            if (!root.isMember("method"))
+            auto* method = member("method");
+            if (method == nullptr)
             {
                 errorMessage = "request has no method field";
                 break;
             }
-            method = root["method"].asString();
 
-            if (root.isMember("id"))
+            int64_t id = 0;
+            if (auto* jId = member("id"); jId != nullptr)
             {
-                id = root["id"].asInt64();
+                id = jId->asInt64();
             }
 
-            if (!root.isMember("params"))
+            auto* params = member("params");
+            if (params == nullptr)
             {
                 errorMessage = "request has no params field";
                 break;
             }
 
-            if (!root["params"].isArray())
+            if (!params->isArray())
             {
                 errorMessage = "request params is not array object";
                 break;
             }
 
-            auto jParams = root["params"];
-
-            _jsonRequest.jsonrpc = jsonrpc;
-            _jsonRequest.method = method;
+            _jsonRequest.jsonrpc = jsonrpc->asString();
+            _jsonRequest.method = method->asString();
             _jsonRequest.id = id;
-            _jsonRequest.params = jParams;
+            // the params may hold the large transaction data, move it instead of copy
+            _jsonRequest.params.swap(root["params"]);
 
             // RPC_IMPL_LOG(DEBUG) << LOG_BADGE("parseRpcRequestJson") << LOG_KV("method", method)
             //                     << LOG_KV("requestMessage", _requestBody);
@@ -218,30 +237,51 @@ void bcos::rpc::parseRpcRequestJson(std::string_view _requestBody, JsonRequest&
 
 bcos::bytes bcos::rpc::toStringResponse(JsonResponse _jsonResponse)
 {
-    auto jResp = toJsonResponse(std::move(_jsonResponse));
-    std::unique_ptr<Json::StreamWriter> writer(Json::StreamWriterBuilder().newStreamWriter());
-    class JsonSink
-    {
-    public:
-        typedef char char_type;
-        typedef boost::iostreams::sink_tag category;
-
-        JsonSink(bcos::bytes& buffer) : m_buffer(buffer) {}
-
-        std::streamsize write(const char* s, std::streamsize n)
-        {
-            m_buffer.insert(m_buffer.end(), (bcos::byte*)s, (bcos::byte*)s + n);
-            return n;
-        }
-
-        bcos::bytes& m_buffer;
-    };
-
+    if (_jsonResponse.error.code == 0)
+    {  // success
+        const auto& result = _jsonResponse.result;
+        return toStringResponse(
+            _jsonResponse, [&result](JsonWriter& _writer) { _writer.value(result); });
+    }
+    // error
     bcos::bytes out;
-    boost::iostreams::stream<JsonSink> outputStream(out);
+    JsonWriter writer(out);
+    writer.startObject();
+    writer.key("error");
+    writer.startObject();
+    writer.key("code");
+    writer.value(_jsonResponse.error.code);
+    writer.key("message");
+    writer.value(_jsonResponse.error.message);
+    writer.endObject();
+    writer.key("id");
+    writer.value(_jsonResponse.id);
+    writer.key("jsonrpc");
+    writer.value(_jsonResponse.jsonrpc);
+    writer.endObject();
+    return out;
+}
 
-    writer->write(jResp, &outputStream);
-    writer.reset();
+bcos::bytes bcos::rpc::toStringResponse(
+    const JsonResponse& _jsonResponse, const ResultWriter& _writeResult)
+{
+    bcos::bytes out;
+    JsonWriter writer(out);
+    writer.startObject();
+    writer.key("id");
+    writer.value(_jsonResponse.id);
+    writer.key("jsonrpc");
+    writer.value(_jsonResponse.jsonrpc);
+    writer.key("result");
+    if (_writeResult)
+    {
+        _writeResult(writer);
+    }
+    else
+    {
+        writer.null();
+    }
+    writer.endObject();
     return out;
 }
 
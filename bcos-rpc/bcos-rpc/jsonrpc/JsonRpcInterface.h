@@ -24,6 +24,7 @@
 #include <bcos-framework/multigroup/GroupInfo.h>
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/jsonrpc/JsonWriter.h>
 #include <bcos-utilities/Error.h>
 #include <json/json.h>
 #include <util/tc_json.h>
@@ -33,6 +34,9 @@ namespace bcos::rpc
 {
 using Sender = std::function<void(bcos::bytes)>;
 using RespFunc = std::function<void(bcos::Error::Ptr, Json::Value&)>;
+// write the result into the response buffer, called before the response callback returns
+using ResultWriter = std::function<void(JsonWriter&)>;
+using StreamRespFunc = std::function<void(bcos::Error::Ptr, ResultWriter)>;
 
 class JsonRpcInterface
 {
@@ -105,6 +109,9 @@ public:
     virtual void getTotalTransactionCount(
         std::string_view _groupID, std::string_view _nodeName, RespFunc _respFunc) = 0;
 
+    virtual void getLogs(std::string_view _groupID, std::string_view _nodeName,
+        const Json::Value& _filter, RespFunc _respFunc) = 0;
+
     virtual void getGroupPeers(std::string_view _groupID, RespFunc _respFunc) = 0;
     virtual void getPeers(RespFunc _respFunc) = 0;
     // get all the groupID list
@@ -119,13 +126,40 @@ public:
 
     virtual void getGroupBlockNumber(RespFunc _respFunc) = 0;
 
+    // write the block into the response buffer without building a Json::Value, the default
+    // writes the result of getBlockByHash
+    virtual void streamBlockByHash(std::string_view _groupID, std::string_view _nodeName,
+        std::string_view _blockHash, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+    {
+        getBlockByHash(_groupID, _nodeName, _blockHash, _onlyHeader, _onlyTxHash,
+            toRespFunc(std::move(_respFunc)));
+    }
+
+    virtual void streamBlockByNumber(std::string_view _groupID, std::string_view _nodeName,
+        int64_t _blockNumber, bool _onlyHeader, bool _onlyTxHash, StreamRespFunc _respFunc)
+    {
+        getBlockByNumber(_groupID, _nodeName, _blockNumber, _onlyHeader, _onlyTxHash,
+            toRespFunc(std::move(_respFunc)));
+    }
+
 public:
     void onRPCRequest(std::string_view _requestBody, Sender _sender);
 
+    static RespFunc toRespFunc(StreamRespFunc _respFunc)
+    {
+        return [respFunc = std::move(_respFunc)](bcos::Error::Ptr _error, Json::Value& _result) {
+            respFunc(std::move(_error),
+                [&_result](JsonWriter& _writer) { _writer.value(_result); });
+        };
+    }
+
 private:
     void initMethod();
 
     std::unordered_map<std::string, std::function<void(Json::Value, RespFunc)>> m_methodToFunc;
+    // the methods writing their results into the response buffer
+    std::unordered_map<std::string, std::function<void(Json::Value, StreamRespFunc)>>
+        m_methodToStreamFunc;
 
 
     std::string_view toView(const Json::Value& value)
@@ -172,16 +206,16 @@ private:
             std::move(_respFunc));
     }
 
-    void getBlockByHashI(const Json::Value& req, RespFunc _respFunc)
+    void getBlockByHashI(const Json::Value& req, StreamRespFunc _respFunc)
     {
-        getBlockByHash(toView(req[0u]), toView(req[1u]), toView(req[2u]),
+        streamBlockByHash(toView(req[0u]), toView(req[1u]), toView(req[2u]),
             (req.size() > 3 ? req[3u].asBool() : true), (req.size() > 4 ? req[4u].asBool() : true),
             std::move(_respFunc));
     }
 
-    void getBlockByNumberI(const Json::Value& req, RespFunc _respFunc)
+    void getBlockByNumberI(const Json::Value& req, StreamRespFunc _respFunc)
     {
-        getBlockByNumber(toView(req[0u]), toView(req[1u]), req[2u].asInt64(),
+        streamBlockByNumber(toView(req[0u]), toView(req[1u]), req[2u].asInt64(),
             (req.size() > 3 ? req[3u].asBool() : true), (req.size() > 4 ? req[4u].asBool() : true),
             std::move(_respFunc));
     }
@@ -253,6 +287,11 @@ private:
         getTotalTransactionCount(toView(req[0u]), toView(req[1u]), std::move(_respFunc));
     }
 
+    void getLogsI(const Json::Value& req, RespFunc _respFunc)
+    {
+        getLogs(toView(req[0u]), toView(req[1u]), req[2u], std::move(_respFunc));
+    }
+
     void getPeersI(const Json::Value& req, RespFunc _respFunc)
     {
         boost::ignore_unused(req);
@@ -290,6 +329,8 @@ private:
 };
 void parseRpcRequestJson(std::string_view _requestBody, JsonRequest& _jsonRequest);
 bcos::bytes toStringResponse(JsonResponse _jsonResponse);
+// the response of the result written by _writeResult, _jsonResponse.result is not used
+bcos::bytes toStringResponse(const JsonResponse& _jsonResponse, const ResultWriter& _writeResult);
 Json::Value toJsonResponse(JsonResponse _jsonResponse);
 
 
@@ -0,0 +1,254 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file JsonWriter.cpp
+ */
+
+#include "JsonWriter.h"
+#include <json/writer.h>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+namespace
+{
+constexpr static uint32_t REPLACEMENT_CHARACTER = 0xfffd;
+
+// the code point of the utf-8 sequence starting at _it, which is moved to the last byte of the
+// sequence. An invalid sequence is the replacement character, and only its first byte is taken
+// unless the bytes are well formed but encode an overlong form, a surrogate or no code point
+uint32_t decodeUtf8(const char*& _it, const char* _end)
+{
+    auto first = (unsigned char)*_it;
+    long size = 0;
+    uint32_t codePoint = 0;
+    uint32_t minCodePoint = 0;
+    if (first >= 0xc0 && first < 0xe0)
+    {
+        size = 2;
+        codePoint = first & 0x1f;
+        minCodePoint = 0x80;
+    }
+    else if (first >= 0xe0 && first < 0xf0)
+    {
+        size = 3;
+        codePoint = first & 0x0f;
+        minCodePoint = 0x800;
+    }
+    else if (first >= 0xf0 && first < 0xf8)
+    {
+        size = 4;
+        codePoint = first & 0x07;
+        minCodePoint = 0x10000;
+    }
+    else
+    {
+        // a continuation byte without a leading byte
+        return REPLACEMENT_CHARACTER;
+    }
+    if (_end - _it < size)
+    {
+        return REPLACEMENT_CHARACTER;
+    }
+    for (long i = 1; i < size; ++i)
+    {
+        auto c = (unsigned char)_it[i];
+        if ((c & 0xc0) != 0x80)
+        {
+            return REPLACEMENT_CHARACTER;
+        }
+        codePoint = (codePoint << 6) | (c & 0x3f);
+    }
+    _it += size - 1;
+    if (codePoint < minCodePoint || (codePoint >= 0xd800 && codePoint <= 0xdfff) ||
+        codePoint > 0x10ffff)
+    {
+        return REPLACEMENT_CHARACTER;
+    }
+    return codePoint;
+}
+}  // namespace
+
+void JsonWriter::startObject()
+{
+    writeSeparator();
+    m_out.push_back('{');
+    m_needSeparator = false;
+}
+
+void JsonWriter::endObject()
+{
+    m_out.push_back('}');
+    m_needSeparator = true;
+}
+
+void JsonWriter::startArray()
+{
+    writeSeparator();
+    m_out.push_back('[');
+    m_needSeparator = false;
+}
+
+void JsonWriter::endArray()
+{
+    m_out.push_back(']');
+    m_needSeparator = true;
+}
+
+void JsonWriter::key(std::string_view _key)
+{
+    writeSeparator();
+    writeString(_key);
+    m_out.push_back(':');
+    m_needSeparator = false;
+}
+
+void JsonWriter::value(std::string_view _value)
+{
+    writeSeparator();
+    writeString(_value);
+    m_needSeparator = true;
+}
+
+void JsonWriter::null()
+{
+    writeSeparator();
+    writeRaw("null");
+    m_needSeparator = true;
+}
+
+void JsonWriter::value(const Json::Value& _value)
+{
+    switch (_value.type())
+    {
+    case Json::nullValue:
+        null();
+        break;
+    case Json::intValue:
+        value(_value.asLargestInt());
+        break;
+    case Json::uintValue:
+        value(_value.asLargestUInt());
+        break;
+    case Json::realValue:
+        writeSeparator();
+        writeRaw(Json::valueToString(_value.asDouble()));
+        m_needSeparator = true;
+        break;
+    case Json::stringValue:
+    {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        _value.getString(&begin, &end);
+        value(std::string_view(begin, end - begin));
+        break;
+    }
+    case Json::booleanValue:
+        value(_value.asBool());
+        break;
+    case Json::arrayValue:
+        startArray();
+        for (const auto& item : _value)
+        {
+            value(item);
+        }
+        endArray();
+        break;
+    case Json::objectValue:
+        startObject();
+        for (auto it = _value.begin(); it != _value.end(); ++it)
+        {
+            const char* end = nullptr;
+            const char* begin = it.memberName(&end);
+            key(std::string_view(begin, end - begin));
+            value(*it);
+        }
+        endObject();
+        break;
+    }
+}
+
+void JsonWriter::writeString(std::string_view _value)
+{
+    m_out.push_back('"');
+    const auto* end = _value.data() + _value.size();
+    const auto* begin = _value.data();
+    for (const auto* it = _value.data(); it != end; ++it)
+    {
+        auto c = (unsigned char)*it;
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        // write the run of the characters need no escape at once
+        m_out.insert(m_out.end(), begin, it);
+        switch (c)
+        {
+        case '"':
+            writeRaw("\\\"");
+            break;
+        case '\\':
+            writeRaw("\\\\");
+            break;
+        case '\b':
+            writeRaw("\\b");
+            break;
+        case '\f':
+            writeRaw("\\f");
+            break;
+        case '\n':
+            writeRaw("\\n");
+            break;
+        case '\r':
+            writeRaw("\\r");
+            break;
+        case '\t':
+            writeRaw("\\t");
+            break;
+        default:
+        {
+            if (c < 0x20)
+            {
+                writeUnicodeEscape(c);
+                break;
+            }
+            auto codePoint = decodeUtf8(it, end);
+            if (codePoint < 0x10000)
+            {
+                writeUnicodeEscape(codePoint);
+                break;
+            }
+            // the surrogate pair of a code point beyond the basic multilingual plane
+            codePoint -= 0x10000;
+            writeUnicodeEscape(0xd800 + (codePoint >> 10));
+            writeUnicodeEscape(0xdc00 + (codePoint & 0x3ff));
+            break;
+        }
+        }
+        begin = it + 1;
+    }
+    m_out.insert(m_out.end(), begin, end);
+    m_out.push_back('"');
+}
+
+void JsonWriter::writeUnicodeEscape(uint32_t _codeUnit)
+{
+    constexpr static std::string_view digits = "0123456789abcdef";
+    writeRaw("\\u");
+    m_out.push_back(digits[(_codeUnit >> 12) & 0xf]);
+    m_out.push_back(digits[(_codeUnit >> 8) & 0xf]);
+    m_out.push_back(digits[(_codeUnit >> 4) & 0xf]);
+    m_out.push_back(digits[_codeUnit & 0xf]);
+}
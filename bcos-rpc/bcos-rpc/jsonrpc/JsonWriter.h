@@ -0,0 +1,105 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the compact json writer of the responses
+ * @file JsonWriter.h
+ */
+
+#pragma once
+
+#include <bcos-utilities/Common.h>
+#include <json/value.h>
+#include <boost/algorithm/hex.hpp>
+#include <charconv>
+#include <concepts>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace bcos::rpc
+{
+/**
+ * @brief write compact json into the buffer of a response as the values are generated, so the
+ * large results need no Json::Value tree and no extra copy of the serialized string
+ *
+ * The caller writes a well formed sequence: key() before each value of an object. The strings
+ * are written as jsoncpp writes them: the non ascii characters are escaped by their utf-16 code
+ * units, and the invalid utf-8 sequences are written as U+FFFD
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(bcos::bytes& _out) : m_out(_out) {}
+
+    void startObject();
+    void endObject();
+    void startArray();
+    void endArray();
+    // the key of the next value of an object
+    void key(std::string_view _key);
+
+    void value(std::string_view _value);
+    void value(const char* _value) { value(std::string_view(_value)); }
+    void value(const std::string& _value) { value(std::string_view(_value)); }
+    template <std::integral Integer>
+    void value(Integer _value)
+    {
+        writeSeparator();
+        if constexpr (std::is_same_v<Integer, bool>)
+        {
+            writeRaw(_value ? "true" : "false");
+        }
+        else
+        {
+            char buffer[24];
+            auto result = std::to_chars(std::begin(buffer), std::end(buffer), _value);
+            writeRaw(std::string_view(buffer, result.ptr - buffer));
+        }
+        m_needSeparator = true;
+    }
+    // a Json::Value built by the methods not writing their results directly
+    void value(const Json::Value& _value);
+    void null();
+
+    // the hex of the binary data as a string, 0x prefixed by default
+    template <class Binary>
+    void hexValue(const Binary& _data, std::string_view _prefix = "0x")
+    {
+        writeSeparator();
+        m_out.push_back('"');
+        writeRaw(_prefix);
+        boost::algorithm::hex_lower(_data.begin(), _data.end(), std::back_inserter(m_out));
+        m_out.push_back('"');
+        m_needSeparator = true;
+    }
+
+private:
+    void writeSeparator()
+    {
+        if (m_needSeparator)
+        {
+            m_out.push_back(',');
+        }
+    }
+    void writeRaw(std::string_view _raw) { m_out.insert(m_out.end(), _raw.begin(), _raw.end()); }
+    void writeString(std::string_view _value);
+    void writeUnicodeEscape(uint32_t _codeUnit);
+
+    bcos::bytes& m_out;
+    // a value has been written in the current object or array
+    bool m_needSeparator = false;
+};
+}  // namespace bcos::rpc
@@ -0,0 +1,79 @@
+#include <bcos-rpc/event/EventSubCache.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+
+namespace bcos::test
+{
+BOOST_AUTO_TEST_SUITE(testEventSubCache)
+BOOST_AUTO_TEST_CASE(sharedFetch)
+{
+    auto cache = std::make_shared<EventSubCache<int>>(2);
+    std::vector<std::function<void(Error::Ptr, int)>> pending;
+    int fetches = 0;
+    auto fetcher = [&](std::function<void(Error::Ptr, int)> _onFetched) {
+        ++fetches;
+        pending.push_back(std::move(_onFetched));
+    };
+    std::vector<int> values;
+    auto callback = [&](Error::Ptr _error, const int& _value) {
+        BOOST_CHECK(!_error);
+        values.push_back(_value);
+    };
+
+    // The gets of a value being fetched wait for the same fetch
+    cache->asyncGet("group0", 1, fetcher, callback);
+    cache->asyncGet("group0", 1, fetcher, callback);
+    BOOST_CHECK_EQUAL(fetches, 1);
+    BOOST_CHECK(values.empty());
+    pending[0](nullptr, 100);
+    BOOST_CHECK_EQUAL(values.size(), 2);
+    BOOST_CHECK_EQUAL(values[0], 100);
+    BOOST_CHECK_EQUAL(values[1], 100);
+    BOOST_CHECK_EQUAL(cache->size(), 1);
+
+    // Cached
+    cache->asyncGet("group0", 1, fetcher, callback);
+    BOOST_CHECK_EQUAL(fetches, 1);
+    BOOST_CHECK_EQUAL(values.size(), 3);
+
+    // Another group is another value
+    cache->asyncGet("group1", 1, fetcher, callback);
+    BOOST_CHECK_EQUAL(fetches, 2);
+    pending[1](nullptr, 200);
+    BOOST_CHECK_EQUAL(values.back(), 200);
+
+    // The oldest is evicted
+    cache->asyncGet("group0", 2, fetcher, callback);
+    pending[2](nullptr, 300);
+    BOOST_CHECK_EQUAL(cache->size(), 2);
+    cache->asyncGet("group0", 1, fetcher, callback);
+    BOOST_CHECK_EQUAL(fetches, 4);
+}
+
+BOOST_AUTO_TEST_CASE(failedFetch)
+{
+    auto cache = std::make_shared<EventSubCache<int>>(2);
+    int fetches = 0;
+    auto fetcher = [&](std::function<void(Error::Ptr, int)> _onFetched) {
+        ++fetches;
+        _onFetched(BCOS_ERROR_PTR(-1, "fetch failed"), 0);
+    };
+    int errors = 0;
+    auto callback = [&](Error::Ptr _error, const int&) {
+        if (_error)
+        {
+            ++errors;
+        }
+    };
+
+    // Not cached, the next get fetches again
+    cache->asyncGet("group0", 1, fetcher, callback);
+    cache->asyncGet("group0", 1, fetcher, callback);
+    BOOST_CHECK_EQUAL(fetches, 2);
+    BOOST_CHECK_EQUAL(errors, 2);
+    BOOST_CHECK_EQUAL(cache->size(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -0,0 +1,127 @@
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+using namespace bcos::protocol;
+
+namespace bcos::test
+{
+BOOST_AUTO_TEST_SUITE(testEventSubMatcher)
+BOOST_AUTO_TEST_CASE(bloomFilter)
+{
+    std::string address = "e0e794ca86d198042b64285c5ce667aee747509b";
+    auto topic = h256::generateRandomFixedBytes();
+    LogEntry logEntry(bytes(address.begin(), address.end()), {topic}, {});
+    LogBloom bloom;
+    bloom.add(logEntry);
+
+    EventSubParams all;
+    BOOST_CHECK(EventSubBloomFilter(all).mayMatch(bloom));
+    BOOST_CHECK(EventSubBloomFilter(all).mayMatch(LogBloom()));
+
+    EventSubParams params;
+    params.addAddress(address);
+    params.addTopic(0, topic.hex());
+    BOOST_CHECK(EventSubBloomFilter(params).mayMatch(bloom));
+    BOOST_CHECK(!EventSubBloomFilter(params).mayMatch(LogBloom()));
+    EventSubMatcher matcher;
+    BOOST_CHECK(matcher.matches(std::make_shared<EventSubParams>(params), logEntry));
+
+    // One of the alternatives of each position
+    params.addAddress("0102e8b6fc8cdf9626fddc1c3ea8c1e79b3fce94");
+    params.addTopic(0, h256::generateRandomFixedBytes().hex());
+    BOOST_CHECK(EventSubBloomFilter(params).mayMatch(bloom));
+
+    // Topics the bloom cannot tell leave their position unfiltered
+    EventSubParams invalidTopic;
+    invalidTopic.addTopic(0, "not a topic");
+    BOOST_CHECK(EventSubBloomFilter(invalidTopic).mayMatch(LogBloom()));
+
+    // A bloom without the address or the topic
+    LogEntry otherLogEntry(bytes(address.begin(), address.end()), {}, {});
+    LogBloom otherBloom;
+    otherBloom.add(otherLogEntry);
+    EventSubParams topicOnly;
+    topicOnly.addTopic(0, topic.hex());
+    BOOST_CHECK(EventSubBloomFilter(topicOnly).mayMatch(bloom));
+    BOOST_CHECK(!EventSubBloomFilter(topicOnly).mayMatch(otherBloom) ||
+                otherBloom.contains(LogBloom(
+                    std::string_view((const char*)topic.data(), topic.size()))));
+}
+BOOST_AUTO_TEST_CASE(index)
+{
+    std::vector<std::string> addresses = {"e0e794ca86d198042b64285c5ce667aee747509b",
+        "0102e8b6fc8cdf9626fddc1c3ea8c1e79b3fce94", "5a4dc6bb1bbd3f4b9b0b1e8b2c5c2a4f7d8c1e0a"};
+    std::vector<h256> topics;
+    for (int i = 0; i < 3; ++i)
+    {
+        topics.push_back(h256::generateRandomFixedBytes());
+    }
+
+    EventSubBlock block;
+    block.blockNumber = 1;
+    for (const auto& address : addresses)
+    {
+        for (const auto& topic0 : topics)
+        {
+            for (const auto& topic1 : topics)
+            {
+                LogEntry logEntry(
+                    bytes(address.begin(), address.end()), {topic0, topic1}, {});
+                Json::Value json;
+                json["address"] = address;
+                json["logIndex"] = (uint64_t)block.logs.size();
+                block.logs.push_back({std::move(logEntry), std::move(json)});
+            }
+        }
+    }
+
+    std::vector<EventSubParams::ConstPtr> params;
+    params.push_back(std::make_shared<EventSubParams>());
+    auto byAddress = std::make_shared<EventSubParams>();
+    byAddress->addAddress(addresses[0]);
+    params.push_back(byAddress);
+    auto byTopic = std::make_shared<EventSubParams>();
+    byTopic->addTopic(0, topics[1].hex());
+    params.push_back(byTopic);
+    auto bySecondTopic = std::make_shared<EventSubParams>();
+    bySecondTopic->addTopic(1, topics[2].hex());
+    params.push_back(bySecondTopic);
+    auto byAll = std::make_shared<EventSubParams>();
+    byAll->addAddress(addresses[1]);
+    byAll->addAddress(addresses[2]);
+    byAll->addTopic(0, topics[0].hex());
+    byAll->addTopic(0, topics[2].hex());
+    byAll->addTopic(1, topics[1].hex());
+    params.push_back(byAll);
+    auto none = std::make_shared<EventSubParams>();
+    none->addAddress("ffffffffffffffffffffffffffffffffffffffff");
+    params.push_back(none);
+
+    // The same logs in the same order as matching each params against all the logs
+    EventSubMatcher matcher;
+    auto results = EventSubIndex(params).matches(matcher, block);
+    BOOST_REQUIRE_EQUAL(results.size(), params.size());
+    for (std::size_t i = 0; i < params.size(); ++i)
+    {
+        Json::Value expected(Json::arrayValue);
+        for (const auto& log : block.logs)
+        {
+            if (matcher.matches(params[i], log.logEntry))
+            {
+                expected.append(log.json);
+            }
+        }
+        BOOST_CHECK_EQUAL(results[i].size(), expected.size());
+        BOOST_CHECK(results[i] == expected);
+    }
+    BOOST_CHECK_EQUAL(results[0].size(), block.logs.size());
+    BOOST_CHECK_EQUAL(results[1].size(), 9);
+    BOOST_CHECK_EQUAL(results[2].size(), 9);
+    BOOST_CHECK_EQUAL(results[3].size(), 9);
+    BOOST_CHECK_EQUAL(results[4].size(), 4);
+    BOOST_CHECK_EQUAL(results[5].size(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
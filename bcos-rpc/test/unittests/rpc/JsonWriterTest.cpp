@@ -0,0 +1,165 @@
+#include "../common/RPCFixture.h"
+#include <bcos-framework/testutils/faker/FakeBlock.h>
+#include <bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h>
+#include <bcos-rpc/jsonrpc/JsonWriter.h>
+#include <json/reader.h>
+#include <json/writer.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+namespace bcos::test
+{
+namespace
+{
+Json::Value parse(const bcos::bytes& _json)
+{
+    Json::Value value;
+    Json::Reader reader;
+    BOOST_CHECK(reader.parse((const char*)_json.data(), (const char*)_json.data() + _json.size(),
+        value, false));
+    return value;
+}
+
+// the numbers parsed are signed if they can be, compare the values parsed from the texts
+Json::Value reparse(const Json::Value& _value)
+{
+    auto json = Json::writeString(Json::StreamWriterBuilder(), _value);
+    return parse(bcos::bytes(json.begin(), json.end()));
+}
+
+std::string_view view(const bcos::bytes& _json)
+{
+    return {(const char*)_json.data(), _json.size()};
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(testJsonWriter)
+BOOST_AUTO_TEST_CASE(writer)
+{
+    bcos::bytes out;
+    JsonWriter writer(out);
+    writer.startObject();
+    writer.key("string");
+    writer.value(std::string("a\"b\\c\n\t\x01"));
+    writer.key("numbers");
+    writer.startArray();
+    writer.value(-1);
+    writer.value(uint64_t(18446744073709551615U));
+    writer.value(true);
+    writer.null();
+    writer.endArray();
+    writer.key("hex");
+    writer.hexValue(bcos::bytes{0x01, 0xab});
+    writer.key("empty");
+    writer.startObject();
+    writer.endObject();
+    writer.endObject();
+    BOOST_CHECK_EQUAL(view(out),
+        R"({"string":"a\"b\\c\n\t\u0001","numbers":[-1,18446744073709551615,true,null],)"
+        R"("hex":"0x01ab","empty":{}})");
+
+    // a Json::Value is written as the same value
+    Json::Value value;
+    value["string"] = "中文\"";
+    value["int"] = -100;
+    value["uint"] = Json::UInt64(100);
+    value["real"] = 1.5;
+    value["array"] = Json::Value(Json::arrayValue);
+    value["array"].append(Json::Value());
+    value["array"].append(false);
+    value["object"]["key"] = Json::Value(Json::arrayValue);
+    out.clear();
+    JsonWriter valueWriter(out);
+    valueWriter.value(value);
+    BOOST_CHECK(parse(out) == reparse(value));
+}
+
+BOOST_AUTO_TEST_CASE(utf8)
+{
+    auto write = [](std::string_view _value) {
+        bcos::bytes out;
+        JsonWriter writer(out);
+        writer.value(_value);
+        return std::string(view(out));
+    };
+
+    // the non ascii characters are escaped as jsoncpp escapes them
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    for (std::string value : {"中文", "é\x7f", "😀 emoji", "a\"\n中"})
+    {
+        BOOST_CHECK_EQUAL(write(value), Json::writeString(builder, Json::Value(value)));
+    }
+    BOOST_CHECK_EQUAL(write("中"), R"("\u4e2d")");
+    BOOST_CHECK_EQUAL(write("😀"), R"("\ud83d\ude00")");
+
+    // the invalid sequences are written as U+FFFD: a lone continuation byte, a truncated sequence,
+    // an overlong form and a surrogate
+    BOOST_CHECK_EQUAL(write("\x80x"), R"("\ufffdx")");
+    BOOST_CHECK_EQUAL(write("\xff"), R"("\ufffd")");
+    BOOST_CHECK_EQUAL(write("a\xe4\xb8"), R"("a\ufffd\ufffd")");
+    BOOST_CHECK_EQUAL(write("\xc0\xaf"), R"("\ufffd")");
+    BOOST_CHECK_EQUAL(write("\xed\xa0\x80"), R"("\ufffd")");
+    auto json = write("a\xe4\xb8");
+    BOOST_CHECK_EQUAL(parse(bcos::bytes(json.begin(), json.end())).asString(), "a\ufffd\ufffd");
+}
+
+BOOST_AUTO_TEST_CASE(response)
+{
+    JsonResponse response;
+    response.jsonrpc = "2.0";
+    response.id = 1;
+    response.result = "0x1";
+    BOOST_CHECK(parse(toStringResponse(response)) == reparse(toJsonResponse(response)));
+
+    response.error.code = JsonRpcError::InvalidParams;
+    response.error.message = "invalid params";
+    BOOST_CHECK(parse(toStringResponse(response)) == reparse(toJsonResponse(response)));
+
+    // the result is written by the writer of the method
+    response.error = {};
+    auto out = toStringResponse(response, [](JsonWriter& _writer) { _writer.value(int64_t(1)); });
+    BOOST_CHECK_EQUAL(view(out), R"({"id":1,"jsonrpc":"2.0","result":1})");
+
+    JsonRequest request;
+    parseRpcRequestJson(
+        R"({"jsonrpc":"2.0","method":"getBlockByNumber","params":["group0","",1],"id":3})",
+        request);
+    BOOST_CHECK_EQUAL(request.method, "getBlockByNumber");
+    BOOST_CHECK_EQUAL(request.id, 3);
+    BOOST_CHECK_EQUAL(request.params.size(), 3);
+    BOOST_CHECK_THROW(parseRpcRequestJson("[]", request), JsonRpcException);
+    BOOST_CHECK_THROW(parseRpcRequestJson(R"({"jsonrpc":"2.0"})", request), JsonRpcException);
+}
+
+BOOST_FIXTURE_TEST_CASE(block, RPCFixture)
+{
+    auto block = fakeAndCheckBlock(cryptoSuite, m_blockFactory, 10, 0, 1);
+
+    // the streamed block is the same as the Json::Value of the block
+    for (auto onlyTxHash : {false, true})
+    {
+        Json::Value jBlock;
+        toJsonResp(jBlock, *block, onlyTxHash);
+        bcos::bytes out;
+        JsonWriter writer(out);
+        toJsonStream(writer, *block, onlyTxHash);
+        BOOST_CHECK(parse(out) == reparse(jBlock));
+    }
+
+    Json::Value jHeader;
+    toJsonResp(jHeader, block->blockHeader());
+    bcos::bytes out;
+    JsonWriter writer(out);
+    toJsonStream(writer, block->blockHeader());
+    BOOST_CHECK(parse(out) == reparse(jHeader));
+
+    out.clear();
+    JsonWriter nullWriter(out);
+    toJsonStream(nullWriter, protocol::BlockHeader::Ptr());
+    BOOST_CHECK_EQUAL(view(out), "null");
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -62,14 +62,44 @@ void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
     std::string keyPrefix;
     keyPrefix = string(_table) + TABLE_KEY_SPLIT;
 
+    // seek to the lower bound of the condition and stop after its upper bound, so a range of keys
+    // is read without iterating the whole table
+    std::string seekKey = keyPrefix;
+    Condition upperBound;
+    if (_condition)
+    {
+        for (const auto& [comparator, value] : _condition->m_conditions)
+        {
+            if ((comparator == Condition::Comparator::GE ||
+                    comparator == Condition::Comparator::GT) &&
+                keyPrefix + value > seekKey)
+            {
+                seekKey = keyPrefix + value;
+            }
+            else if (comparator == Condition::Comparator::LT)
+            {
+                upperBound.LT(value);
+            }
+            else if (comparator == Condition::Comparator::LE)
+            {
+                upperBound.LE(value);
+            }
+        }
+    }
+
     ReadOptions read_options;
     read_options.total_order_seek = true;
     auto iter = std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(read_options));
 
     // check performance
-    for (iter->Seek(keyPrefix); iter->Valid() && iter->key().starts_with(keyPrefix); iter->Next())
+    for (iter->Seek(seekKey); iter->Valid() && iter->key().starts_with(keyPrefix); iter->Next())
     {
         size_t start = keyPrefix.size();
+        if (!upperBound.isValid(
+                std::string_view(iter->key().data() + start, iter->key().size() - start)))
+        {
+            break;
+        }
         if (!_condition || _condition->isValid(std::string_view(
                                iter->key().data() + start, iter->key().size() - start)))
         {  // filter by condition, the key need
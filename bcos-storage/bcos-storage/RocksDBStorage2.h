@@ -13,6 +13,7 @@
 #include <boost/container/small_vector.hpp>
 #include <boost/throw_exception.hpp>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <variant>
 
@@ -49,6 +50,15 @@ private:
     ::rocksdb::DB& m_rocksDB;
     [[no_unique_address]] KeyResolver m_keyResolver;
     [[no_unique_address]] ValueResolver m_valueResolver;
+    // Pinned by the storages returned from snapshot(), released with the last of them
+    std::shared_ptr<const ::rocksdb::Snapshot> m_snapshot;
+
+    ::rocksdb::ReadOptions readOptions() const
+    {
+        ::rocksdb::ReadOptions options;
+        options.snapshot = m_snapshot.get();
+        return options;
+    }
 
 public:
     RocksDBStorage2(::rocksdb::DB& rocksDB) : m_rocksDB(rocksDB) {}
@@ -60,6 +70,19 @@ public:
     {}
     using Key = KeyType;
     using Value = ValueType;
+    using Snapshot = RocksDBStorage2;
+
+    // A storage reading the state of the database at this moment, unaffected by the later
+    // writes. Only for read and seek, the writes through it go to the latest state
+    Snapshot snapshot()
+    {
+        Snapshot storage(*this);
+        storage.m_snapshot = std::shared_ptr<const ::rocksdb::Snapshot>(m_rocksDB.GetSnapshot(),
+            [&rocksDB = m_rocksDB](const ::rocksdb::Snapshot* pinned) {
+                rocksDB.ReleaseSnapshot(pinned);
+            });
+        return storage;
+    }
 
     class ReadIterator
     {
@@ -105,7 +128,7 @@ public:
 
                 auto key = m_keyResolver.encode(keys[0]);
                 auto& status = readIterator.m_status[0];
-                status = m_rocksDB.Get(::rocksdb::ReadOptions(), m_rocksDB.DefaultColumnFamily(),
+                status = m_rocksDB.Get(readOptions(), m_rocksDB.DefaultColumnFamily(),
                     ::rocksdb::Slice(RANGES::data(key), RANGES::size(key)),
                     &readIterator.m_results[0]);
                 if (!status.ok() && !status.IsNotFound())
@@ -132,7 +155,7 @@ public:
         readIterator.m_results.resize(RANGES::size(rocksDBKeys));
         readIterator.m_status.resize(RANGES::size(rocksDBKeys));
 
-        m_rocksDB.MultiGet(::rocksdb::ReadOptions(), m_rocksDB.DefaultColumnFamily(),
+        m_rocksDB.MultiGet(readOptions(), m_rocksDB.DefaultColumnFamily(),
             rocksDBKeys.size(), rocksDBKeys.data(), readIterator.m_results.data(),
             readIterator.m_status.data());
         return readIteratorAwaitable;
@@ -228,7 +251,7 @@ public:
     {
         task::AwaitableValue<SeekIterator> iteratorAwaitable(
             {std::unique_ptr<::rocksdb::Iterator>(
-                 m_rocksDB.NewIterator(::rocksdb::ReadOptions(), m_rocksDB.DefaultColumnFamily())),
+                 m_rocksDB.NewIterator(readOptions(), m_rocksDB.DefaultColumnFamily())),
                 *this});
         auto& iterator = iteratorAwaitable.value();
         if constexpr (std::is_same_v<storage2::STORAGE_BEGIN_TYPE,
@@ -269,7 +292,18 @@ public:
         }
     }
 
+    using MergeBatch = ::rocksdb::WriteBatch;
+
     task::Task<void> merge(storage2::SeekableStorage auto& from)
+    {
+        MergeBatch writeBatch;
+        co_await prepareMerge(from, writeBatch);
+        co_await commitMerge(writeBatch);
+    }
+
+    // Encode the items of the storage into the write batch, may run ahead of commitMerge on
+    // another thread as long as the storage is not modified
+    task::Task<void> prepareMerge(storage2::SeekableStorage auto& from, MergeBatch& writeBatch)
     {
         auto it = co_await from.seek(storage2::STORAGE_BEGIN);
         using IteratorKeyType = task::AwaitableReturnType<decltype(it.key())>;
@@ -289,7 +323,6 @@ public:
         using Item = std::variant<KeyValue, DeleteKey>;
         using EncodedItem = std::variant<KeyValueBuffer, DeleteKeyBuffer>;
 
-        ::rocksdb::WriteBatch writeBatch;
         tbb::parallel_pipeline(std::thread::hardware_concurrency(),
             tbb::make_filter<void, Item>(tbb::filter_mode::serial_in_order,
                 [&](tbb::flow_control& control) {
@@ -343,6 +376,11 @@ public:
                                        }},
                             input);
                     }));
+        co_return;
+    }
+
+    task::Task<void> commitMerge(MergeBatch& writeBatch)
+    {
         ::rocksdb::WriteOptions options;
         auto status = m_rocksDB.Write(options, &writeBatch);
         if (!status.ok())
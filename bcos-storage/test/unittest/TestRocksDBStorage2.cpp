@@ -198,4 +198,36 @@ BOOST_AUTO_TEST_CASE(merge)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        RocksDBStorage2<StateKey, StateValue, StateKeyResolver,
+            bcos::storage2::rocksdb::StateValueResolver>
+            rocksDB(*originRocksDB, StateKeyResolver{}, StateValueResolver{});
+
+        storage::Entry oldEntry;
+        oldEntry.set("old value");
+        co_await storage2::writeOne(rocksDB, StateKey{"Table", "Key"}, std::move(oldEntry));
+
+        auto snapshot = rocksDB.snapshot();
+        storage::Entry newEntry;
+        newEntry.set("new value");
+        co_await storage2::writeOne(rocksDB, StateKey{"Table", "Key"}, std::move(newEntry));
+        co_await storage2::writeOne(rocksDB, StateKey{"Table", "Key2"}, storage::Entry{});
+
+        // The snapshot keeps reading the state before the writes
+        auto snapshotValue = co_await storage2::readOne(snapshot, StateKey{"Table", "Key"});
+        BOOST_REQUIRE(snapshotValue);
+        BOOST_CHECK_EQUAL(snapshotValue->get(), "old value");
+        BOOST_CHECK(!co_await storage2::readOne(snapshot, StateKey{"Table", "Key2"}));
+
+        auto latestValue = co_await storage2::readOne(rocksDB, StateKey{"Table", "Key"});
+        BOOST_REQUIRE(latestValue);
+        BOOST_CHECK_EQUAL(latestValue->get(), "new value");
+        BOOST_CHECK(co_await storage2::readOne(rocksDB, StateKey{"Table", "Key2"}));
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -63,6 +63,30 @@ public:
         return block;
     }
 
+    bcos::protocol::Block::Ptr createBlockHeaderAndTxsHash(bcos::bytesConstRef _data) override
+    {
+        bcostars::BlockHeaderAndTxsHash decoded;
+        tars::TarsInputStream<tars::BufferReader> input;
+        input.setBuffer((const char*)_data.data(), _data.size());
+        decoded.readFrom(input);
+
+        bcostars::Block inner;
+        inner.blockHeader = std::move(decoded.blockHeader);
+        inner.transactionsMetaData.resize(decoded.transactionsMetaData.size());
+        for (size_t i = 0; i < decoded.transactionsMetaData.size(); ++i)
+        {
+            inner.transactionsMetaData[i].hash = std::move(decoded.transactionsMetaData[i].hash);
+        }
+        auto block = std::make_shared<BlockImpl>(std::move(inner));
+
+        if (block->inner().blockHeader.dataHash.empty())
+        {
+            block->blockHeader()->calculateHash(*m_cryptoSuite->hashImpl());
+        }
+
+        return block;
+    }
+
     bcos::crypto::CryptoSuite::Ptr cryptoSuite() override { return m_cryptoSuite; }
     bcos::protocol::BlockHeaderFactory::Ptr blockHeaderFactory() override
     {
@@ -233,3 +233,20 @@ bcos::crypto::HashType bcostars::protocol::BlockImpl::calculateReceiptRoot(
 
     return receiptsRoot;
 }
+static std::vector<bcos::crypto::HashType> toMerkle(auto const& nodes)
+{
+    // the length records are the first bytes of the nodes
+    return nodes | RANGES::views::transform([](auto const& node) {
+        bcos::crypto::HashType hash;
+        bcos::concepts::bytebuffer::assignTo(node, hash);
+        return hash;
+    }) | RANGES::to<std::vector<bcos::crypto::HashType>>();
+}
+std::vector<bcos::crypto::HashType> bcostars::protocol::BlockImpl::transactionsMerkle() const
+{
+    return toMerkle(m_inner->transactionsMerkle);
+}
+std::vector<bcos::crypto::HashType> bcostars::protocol::BlockImpl::receiptsMerkle() const
+{
+    return toMerkle(m_inner->receiptsMerkle);
+}
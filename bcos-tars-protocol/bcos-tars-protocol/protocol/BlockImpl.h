@@ -99,6 +99,8 @@ public:
         const bcos::crypto::Hash& hashImpl) const override;
 
     bcos::crypto::HashType calculateReceiptRoot(const bcos::crypto::Hash& hashImpl) const override;
+    std::vector<bcos::crypto::HashType> transactionsMerkle() const override;
+    std::vector<bcos::crypto::HashType> receiptsMerkle() const override;
 
 private:
     std::shared_ptr<bcostars::Block> m_inner;
@@ -509,11 +509,16 @@ void NodeConfig::loadTxPoolConfig(boost::property_tree::ptree const& _pt)
     }
     m_txsExpirationTime = std::max(
         {txsExpirationTime * 1000, (int64_t)DEFAULT_MIN_CONSENSUS_TIME_MS, (int64_t)m_minSealTime});
+    // the txs submitted when the txpool is full are spilled to disk, disabled by default
+    m_txpoolSpillLimit = _pt.get<size_t>("txpool.spill_limit", 0);
+    m_txpoolSpillPath = _pt.get<std::string>("txpool.spill_path", "");
 
     NodeConfig_LOG(INFO) << LOG_DESC("loadTxPoolConfig") << LOG_KV("txpoolLimit", m_txpoolLimit)
                          << LOG_KV("notifierWorkers", m_notifyWorkerNum)
                          << LOG_KV("verifierWorkers", m_verifierWorkerNum)
-                         << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime);
+                         << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime)
+                         << LOG_KV("spillLimit", m_txpoolSpillLimit)
+                         << LOG_KV("spillPath", m_txpoolSpillPath);
 }
 
 void NodeConfig::loadChainConfig(boost::property_tree::ptree const& _pt, bool _enforceGroupId)
@@ -656,6 +661,7 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
         m_archiveListenIP = _pt.get<std::string>("storage.archive_ip");
         m_archiveListenPort = _pt.get<uint16_t>("storage.archive_port");
     }
+    m_enableLogIndex = _pt.get<bool>("storage.enable_log_index", false);
 
     // if (m_keyPageSize < 4096 || m_keyPageSize > (1 << 25))
     // {
@@ -673,6 +679,7 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
                          << LOG_KV("enableArchive", m_enableArchive)
                          << LOG_KV("archiveListenIP", m_archiveListenIP)
                          << LOG_KV("archiveListenPort", m_archiveListenPort)
+                         << LOG_KV("enableLogIndex", m_enableLogIndex)
                          << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage);
 }
 
@@ -718,6 +725,36 @@ void NodeConfig::loadOthersConfig(boost::property_tree::ptree const& _pt)
     m_baselineSchedulerConfig.maxThread = _pt.get<int>("executor.baseline_scheduler_maxthread", 16);
     m_baselineSchedulerConfig.parallel =
         _pt.get<bool>("executor.baseline_scheduler_parallel", false);
+    m_baselineSchedulerConfig.backgroundMerge =
+        _pt.get<bool>("executor.baseline_scheduler_background_merge", true);
+    m_baselineSchedulerConfig.maxInflightBlocks =
+        _pt.get<int>("executor.baseline_scheduler_max_inflight_blocks", 4);
+    m_baselineSchedulerConfig.callConcurrency =
+        _pt.get<int>("executor.baseline_scheduler_call_concurrency", 4);
+    m_baselineSchedulerConfig.conflictAware =
+        _pt.get<bool>("executor.baseline_scheduler_conflict_aware", false);
+    m_baselineSchedulerConfig.predict =
+        _pt.get<bool>("executor.baseline_scheduler_predict", false);
+    m_baselineSchedulerConfig.prefetch =
+        _pt.get<bool>("executor.baseline_scheduler_prefetch", false);
+    m_baselineSchedulerConfig.adaptive =
+        _pt.get<bool>("executor.baseline_scheduler_adaptive", false);
+    m_baselineSchedulerConfig.vmInterpreter =
+        _pt.get<std::string>("executor.baseline_scheduler_vm_interpreter", "adaptive");
+    if (m_baselineSchedulerConfig.vmInterpreter != "adaptive" &&
+        m_baselineSchedulerConfig.vmInterpreter != "baseline" &&
+        m_baselineSchedulerConfig.vmInterpreter != "advanced")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "executor.baseline_scheduler_vm_interpreter must be adaptive, "
+                                  "baseline or advanced"));
+    }
+    m_baselineSchedulerConfig.vmAnalysisCacheSize =
+        _pt.get<int64_t>("executor.baseline_scheduler_vm_analysis_cache_size", 64 << 20);
+    m_baselineSchedulerConfig.vmAdvancedCalls =
+        _pt.get<uint32_t>("executor.baseline_scheduler_vm_advanced_calls", 16);
+    m_baselineSchedulerConfig.vmAdvancedMaxCodeSize =
+        _pt.get<size_t>("executor.baseline_scheduler_vm_advanced_max_code_size", 24 * 1024);
 
     m_tarsRPCConfig.host = _pt.get<std::string>("rpc.tars_rpc_host", "127.0.0.1");
     m_tarsRPCConfig.port = _pt.get<int>("rpc.tars_rpc_port", 0);
@@ -103,6 +103,9 @@ public:
     size_t notifyWorkerNum() const { return m_notifyWorkerNum; }
     size_t verifierWorkerNum() const { return m_verifierWorkerNum; }
     int64_t txsExpirationTime() const { return m_txsExpirationTime; }
+    // the txs spilled to disk when the txpool is full, 0 to reject the txs instead
+    size_t txpoolSpillLimit() const { return m_txpoolSpillLimit; }
+    std::string const& txpoolSpillPath() const { return m_txpoolSpillPath; }
 
     bool smCryptoType() const { return m_smCryptoType; }
     std::string const& chainId() const { return m_chainId; }
@@ -138,6 +141,7 @@ public:
     bool enableArchive() const { return m_enableArchive; }
     std::string const& archiveListenIP() const { return m_archiveListenIP; }
     uint16_t archiveListenPort() const { return m_archiveListenPort; }
+    bool enableLogIndex() const { return m_enableLogIndex; }
 
     bcos::crypto::KeyFactory::Ptr keyFactory() { return m_keyFactory; }
 
@@ -249,6 +253,18 @@ public:
         int parallel = 0;
         int chunkSize = 0;
         int maxThread = 0;
+        bool backgroundMerge = false;
+        int maxInflightBlocks = 0;
+        int callConcurrency = 0;
+        bool conflictAware = false;
+        bool predict = false;
+        bool prefetch = false;
+        bool adaptive = false;
+        // adaptive, baseline or advanced
+        std::string vmInterpreter;
+        int64_t vmAnalysisCacheSize = 0;
+        uint32_t vmAdvancedCalls = 0;
+        size_t vmAdvancedMaxCodeSize = 0;
     };
     BaselineSchedulerConfig const& baselineSchedulerConfig() const
     {
@@ -312,6 +328,8 @@ private:
     size_t m_notifyWorkerNum;
     size_t m_verifierWorkerNum;
     int64_t m_txsExpirationTime;
+    size_t m_txpoolSpillLimit = 0;
+    std::string m_txpoolSpillPath;
     // TODO: the block sync module need some configurations?
 
     // chain configuration
@@ -367,6 +385,7 @@ private:
     bool m_enableArchive = false;
     std::string m_archiveListenIP;
     uint16_t m_archiveListenPort = 0;
+    bool m_enableLogIndex = false;
 
     std::string m_storageDBName = "storage";
     std::string m_stateDBName = "state";
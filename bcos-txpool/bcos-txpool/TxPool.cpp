@@ -251,18 +251,38 @@ void TxPool::asyncNotifyBlockResult(BlockNumber _blockNumber, TransactionSubmitR
 void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _block,
     std::function<void(Error::Ptr, bool)> _onVerifyFinished)
 {
-    auto block = m_config->blockFactory()->createBlock(_block);
+    // Note: only the header and the hash list of the txs are decoded from the proposal, in the
+    // caller(consensus) thread without copying it
+    auto startT = utcTime();
+    Block::Ptr block;
+    try
+    {
+        block = m_config->blockFactory()->createBlockHeaderAndTxsHash(_block);
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("asyncVerifyBlock: decode proposal failed")
+                            << LOG_KV("fromNodeId", _generatedNodeID->shortHex())
+                            << LOG_KV("message", boost::diagnostic_information(e));
+        if (_onVerifyFinished)
+        {
+            _onVerifyFinished(BCOS_ERROR_PTR(CommonError::VerifyProposalFailed,
+                                  "asyncVerifyBlock failed for decode proposal failed"),
+                false);
+        }
+        return;
+    }
     auto blockHeader = block->blockHeader();
-    TXPOOL_LOG(INFO) << LOG_DESC("begin asyncVerifyBlock")
+    TXPOOL_LOG(INFO) << LOG_DESC("begin asyncVerifyBlock") << LOG_KV("size", _block.size())
                      << LOG_KV("consNum", blockHeader ? blockHeader->number() : -1)
-                     << LOG_KV("hash", blockHeader ? blockHeader->hash().abridged() : "null");
+                     << LOG_KV("hash", blockHeader ? blockHeader->hash().abridged() : "null")
+                     << LOG_KV("decodeT", (utcTime() - startT));
     // Note: here must have thread pool for lock in the callback
     // use single thread here to decrease thread competition
     auto self = weak_from_this();
-    m_verifier->enqueue([self, _generatedNodeID, blockHeader, block, _onVerifyFinished]() {
+    m_verifier->enqueue([self, _generatedNodeID, block, blockHeader, startT, _onVerifyFinished]() {
         try
         {
-            auto startT = utcTime();
             auto txpool = self.lock();
             if (!txpool)
             {
@@ -275,7 +295,9 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
                 return;
             }
             auto txpoolStorage = txpool->m_txpoolStorage;
-            auto missedTxs = txpoolStorage->batchVerifyProposal(block);
+            // the txs hit in the txpool are kept to store the proposal without fetching again
+            auto hitTxs = std::make_shared<Transactions>();
+            auto missedTxs = txpoolStorage->batchVerifyProposal(block, hitTxs);
             if (!missedTxs)
             {
                 _onVerifyFinished(BCOS_ERROR_PTR(CommonError::VerifyProposalFailed,
@@ -284,8 +306,8 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
                 return;
             }
             auto onVerifyFinishedWrapper =
-                [txpool, txpoolStorage, _onVerifyFinished, block, blockHeader, missedTxs, startT](
-                    const Error::Ptr& _error, bool _ret) {
+                [txpool, txpoolStorage, _onVerifyFinished, block, blockHeader, missedTxs, hitTxs,
+                    startT](const Error::Ptr& _error, bool _ret) {
                     auto verifyRet = _ret;
                     auto verifyError = _error;
                     if (!missedTxs->empty())
@@ -319,8 +341,9 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
                     // m_txsPreStore
                     if (!verifyError && verifyRet && block && block->blockHeader())
                     {
-                        txpool->m_txsPreStore->enqueue(
-                            [txpool, block]() { txpool->storeVerifiedBlock(block); });
+                        txpool->m_txsPreStore->enqueue([txpool, block, hitTxs]() {
+                            txpool->storeVerifiedBlock(block, hitTxs);
+                        });
                     }
                 };
 
@@ -337,8 +360,19 @@ void TxPool::asyncVerifyBlock(PublicPtr _generatedNodeID, bytesConstRef const& _
                               << LOG_KV("consNum", blockHeader ? blockHeader->number() : -1)
                               << LOG_KV("totalTxs", block->transactionsHashSize())
                               << LOG_KV("missedTxs", missedTxs->size());
-            txpool->m_transactionSync->requestMissedTxs(
-                _generatedNodeID, missedTxs, block, onVerifyFinishedWrapper);
+            // the spilled txs are read back from the disk in m_worker instead of m_verifier, the
+            // others are requested from the ledger and the peers
+            txpool->m_worker->enqueue(
+                [txpool, _generatedNodeID, missedTxs, block, onVerifyFinishedWrapper]() {
+                    txpool->m_txpoolStorage->rehydrateTxs(*missedTxs);
+                    if (missedTxs->empty())
+                    {
+                        onVerifyFinishedWrapper(nullptr, true);
+                        return;
+                    }
+                    txpool->m_transactionSync->requestMissedTxs(
+                        _generatedNodeID, missedTxs, block, onVerifyFinishedWrapper);
+                });
         }
         catch (std::exception const& e)
         {
@@ -597,7 +631,7 @@ void TxPool::initSendResponseHandler()
 }
 
 
-void TxPool::storeVerifiedBlock(bcos::protocol::Block::Ptr _block)
+void TxPool::storeVerifiedBlock(bcos::protocol::Block::Ptr _block, TransactionsPtr _hitTxs)
 {
     auto blockHeader = _block->blockHeader();
 
@@ -618,16 +652,69 @@ void TxPool::storeVerifiedBlock(bcos::protocol::Block::Ptr _block)
     TXPOOL_LOG(INFO) << LOG_DESC("storeVerifiedBlock") << LOG_KV("consNum", blockHeader->number())
                      << LOG_KV("hash", blockHeader->hash().abridged())
                      << LOG_KV("txsSize", _block->transactionsHashSize());
+    auto self = weak_from_this();
+    auto startT = utcTime();
+    auto preStoreBlockTxs = [self, startT, blockHeader, _block](TransactionsPtr _txs) {
+        auto txpool = self.lock();
+        if (!txpool)
+        {
+            return;
+        }
+        txpool->m_config->ledger()->asyncPreStoreBlockTxs(
+            std::move(_txs), _block, [startT, blockHeader](Error::UniquePtr&& _error) {
+                if (_error)
+                {
+                    TXPOOL_LOG(WARNING)
+                        << LOG_DESC("storeVerifiedBlock: asyncPreStoreBlockTxs failed")
+                        << LOG_KV("consNum", blockHeader->number())
+                        << LOG_KV("hash", blockHeader->hash().abridged())
+                        << LOG_KV("msg", _error->errorMessage())
+                        << LOG_KV("code", _error->errorCode());
+                    return;
+                }
+                TXPOOL_LOG(INFO) << LOG_DESC("storeVerifiedBlock success")
+                                 << LOG_KV("consNum", blockHeader->number())
+                                 << LOG_KV("hash", blockHeader->hash().abridged())
+                                 << LOG_KV("timecost", (utcTime() - startT));
+            });
+    };
+
+    // reuse the txs hit when verifying, only the missed ones which have been fetched from the
+    // peers since then are looked up again
+    if (_hitTxs && _hitTxs->size() == _block->transactionsHashSize())
+    {
+        HashList missedHashes;
+        std::vector<size_t> missedIndexes;
+        for (size_t i = 0; i < _hitTxs->size(); ++i)
+        {
+            if (!(*_hitTxs)[i])
+            {
+                missedHashes.emplace_back(_block->transactionHash(i));
+                missedIndexes.emplace_back(i);
+            }
+        }
+        HashList stillMissed;
+        auto fetchedTxs =
+            missedHashes.empty() ? nullptr : m_txpoolStorage->fetchTxs(stillMissed, missedHashes);
+        if (stillMissed.empty())
+        {
+            for (size_t i = 0; i < missedIndexes.size(); ++i)
+            {
+                (*_hitTxs)[missedIndexes[i]] = (*fetchedTxs)[i];
+            }
+            preStoreBlockTxs(std::move(_hitTxs));
+            return;
+        }
+    }
+
     auto txsHashList = std::make_shared<HashList>();
     for (size_t i = 0; i < _block->transactionsHashSize(); i++)
     {
         txsHashList->emplace_back(_block->transactionHash(i));
     }
-
-    auto self = weak_from_this();
-    auto startT = utcTime();
-    asyncFillBlock(
-        txsHashList, [self, startT, blockHeader, _block](Error::Ptr _error, TransactionsPtr _txs) {
+    asyncFillBlock(txsHashList,
+        [blockHeader, preStoreBlockTxs = std::move(preStoreBlockTxs)](
+            Error::Ptr _error, TransactionsPtr _txs) {
             if (_error)
             {
                 TXPOOL_LOG(WARNING)
@@ -637,28 +724,7 @@ void TxPool::storeVerifiedBlock(bcos::protocol::Block::Ptr _block)
                     << LOG_KV("msg", _error->errorMessage()) << LOG_KV("code", _error->errorCode());
                 return;
             }
-            auto txpool = self.lock();
-            if (!txpool)
-            {
-                return;
-            }
-            txpool->m_config->ledger()->asyncPreStoreBlockTxs(
-                std::move(_txs), _block, [startT, blockHeader](Error::UniquePtr&& _error) {
-                    if (_error)
-                    {
-                        TXPOOL_LOG(WARNING)
-                            << LOG_DESC("storeVerifiedBlock: asyncPreStoreBlockTxs failed")
-                            << LOG_KV("consNum", blockHeader->number())
-                            << LOG_KV("hash", blockHeader->hash().abridged())
-                            << LOG_KV("msg", _error->errorMessage())
-                            << LOG_KV("code", _error->errorCode());
-                        return;
-                    }
-                    TXPOOL_LOG(INFO) << LOG_DESC("storeVerifiedBlock success")
-                                     << LOG_KV("consNum", blockHeader->number())
-                                     << LOG_KV("hash", blockHeader->hash().abridged())
-                                     << LOG_KV("timecost", (utcTime() - startT));
-                });
+            preStoreBlockTxs(std::move(_txs));
         });
 }
 void bcos::txpool::TxPool::notifyConnectedNodes(
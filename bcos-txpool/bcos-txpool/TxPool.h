@@ -106,6 +106,8 @@ public:
 
     TxPoolConfig::Ptr txpoolConfig();
     TxPoolStorageInterface::Ptr txpoolStorage();
+    // the workers the submissions go on in once their signatures are verified
+    ThreadPool::Ptr submitWorker() { return m_worker; }
 
     bcos::sync::TransactionSyncInterface::Ptr& transactionSync();
     void setTransactionSync(bcos::sync::TransactionSyncInterface::Ptr _transactionSync);
@@ -148,7 +150,9 @@ protected:
 
     void initSendResponseHandler();
 
-    virtual void storeVerifiedBlock(bcos::protocol::Block::Ptr _block);
+    // _hitTxs: the txs of the block found in the txpool when verifying, null for the missed ones
+    virtual void storeVerifiedBlock(
+        bcos::protocol::Block::Ptr _block, bcos::protocol::TransactionsPtr _hitTxs = nullptr);
 
 private:
     TxPoolConfig::Ptr m_config;
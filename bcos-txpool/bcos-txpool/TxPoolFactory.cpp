@@ -23,6 +23,8 @@
 #include "bcos-txpool/sync/protocol/PB/TxsSyncMsgFactoryImpl.h"
 #include "bcos-txpool/txpool/validator/TxValidator.h"
 #include "txpool/storage/MemoryStorage.h"
+#include "txpool/storage/TxSpillStore.h"
+#include "txpool/validator/TxBatchVerifier.h"
 #include "txpool/validator/TxPoolNonceChecker.h"
 #include <bcos-tool/LedgerConfigFetcher.h>
 
@@ -50,8 +52,8 @@ TxPoolFactory::TxPoolFactory(NodeIDPtr _nodeId, CryptoSuite::Ptr _cryptoSuite,
 {}
 
 
-TxPool::Ptr TxPoolFactory::createTxPool(
-    size_t _notifyWorkerNum, size_t _verifierWorkerNum, uint64_t _txsExpirationTime)
+TxPool::Ptr TxPoolFactory::createTxPool(size_t _notifyWorkerNum, size_t _verifierWorkerNum,
+    uint64_t _txsExpirationTime, std::string const& _spillPath, size_t _spillLimit)
 {
     TXPOOL_LOG(INFO) << LOG_DESC("create transaction validator");
     auto txpoolNonceChecker = std::make_shared<TxPoolNonceChecker>();
@@ -65,6 +67,13 @@ TxPool::Ptr TxPoolFactory::createTxPool(
     TXPOOL_LOG(INFO) << LOG_DESC("create transaction storage");
     auto txpoolStorage =
         std::make_shared<MemoryStorage>(txpoolConfig, _notifyWorkerNum, _txsExpirationTime);
+    if (_spillLimit > 0)
+    {
+        TXPOOL_LOG(INFO) << LOG_DESC("create transaction spill store")
+                         << LOG_KV("path", _spillPath) << LOG_KV("limit", _spillLimit);
+        txpoolStorage->setSpillStore(
+            std::make_shared<TxSpillStore>(_spillPath, _spillLimit, txpoolConfig->txFactory()));
+    }
 
     auto syncMsgFactory = std::make_shared<TxsSyncMsgFactoryImpl>();
     TXPOOL_LOG(INFO) << LOG_DESC("create sync config");
@@ -75,5 +84,13 @@ TxPool::Ptr TxPoolFactory::createTxPool(
 
     TXPOOL_LOG(INFO) << LOG_DESC("create txpool") << LOG_KV("submitWorkerNum", _verifierWorkerNum)
                      << LOG_KV("notifyWorkerNum", _notifyWorkerNum);
-    return std::make_shared<TxPool>(txpoolConfig, txpoolStorage, txsSync, _verifierWorkerNum);
+    auto txpool =
+        std::make_shared<TxPool>(txpoolConfig, txpoolStorage, txsSync, _verifierWorkerNum);
+
+    TXPOOL_LOG(INFO) << LOG_DESC("create transaction batch verifier");
+    auto batchVerifier =
+        std::make_shared<TxBatchVerifier>(m_cryptoSuite, 0, txpool->submitWorker());
+    txpoolStorage->setBatchVerifier(batchVerifier);
+    txsSyncConfig->setBatchVerifier(std::move(batchVerifier));
+    return txpool;
 }
\ No newline at end of file
@@ -37,8 +37,10 @@ public:
         std::string const& _chainId, int64_t _blockLimit, size_t _txpoolLimit = DEFAULT_POOL_LIMIT);
 
     virtual ~TxPoolFactory() = default;
+    // _spillLimit: the txs spilled to _spillPath when the pool is full, 0 to reject them
     TxPool::Ptr createTxPool(size_t _notifyWorkerNum = 2, size_t _verifierWorkerNum = 4,
-        uint64_t _txsExpirationTime = TX_DEFAULT_EXPIRATION_TIME);
+        uint64_t _txsExpirationTime = TX_DEFAULT_EXPIRATION_TIME, std::string const& _spillPath = "",
+        size_t _spillLimit = 0);
 
 private:
     bcos::crypto::NodeIDPtr m_nodeId;
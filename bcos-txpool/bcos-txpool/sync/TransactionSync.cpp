@@ -22,6 +22,7 @@
 #include "bcos-txpool/sync/utilities/Common.h"
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-framework/protocol/Protocol.h>
+#include <algorithm>
 
 using namespace bcos;
 using namespace bcos::sync;
@@ -412,9 +413,12 @@ bool TransactionSync::importDownloadedTxs(TransactionsPtr _txs, Block::Ptr _veri
     auto startT = utcTime();
     // verify the transactions
     std::atomic_bool verifySuccess = {true};
+    auto const& batchVerifier = m_config->batchVerifier();
+    // the txs already in the txpool are not verified again
+    std::vector<uint8_t> unverified(txsSize, 0);
     tbb::parallel_for(tbb::blocked_range<size_t>(0, txsSize),
-        [&_txs, &_verifiedProposal, &proposalHeader, this, &verifySuccess](
-            const tbb::blocked_range<size_t>& _range) {
+        [&_txs, &_verifiedProposal, &proposalHeader, this, &verifySuccess, &batchVerifier,
+            &unverified](const tbb::blocked_range<size_t>& _range) {
             for (size_t i = _range.begin(); i < _range.end(); i++)
             {
                 auto tx = (*_txs)[i];
@@ -431,6 +435,11 @@ bool TransactionSync::importDownloadedTxs(TransactionsPtr _txs, Block::Ptr _veri
                 {
                     continue;
                 }
+                if (batchVerifier)
+                {
+                    unverified[i] = 1;
+                    continue;
+                }
                 try
                 {
                     tx->verify(*m_hashImpl, *m_signatureImpl);
@@ -445,6 +454,23 @@ bool TransactionSync::importDownloadedTxs(TransactionsPtr _txs, Block::Ptr _veri
                 }
             }
         });
+    if (batchVerifier)
+    {
+        Transactions unverifiedTxs;
+        for (size_t i = 0; i < txsSize; i++)
+        {
+            if (unverified[i] != 0)
+            {
+                unverifiedTxs.emplace_back((*_txs)[i]);
+            }
+        }
+        batchVerifier->batchVerify(unverifiedTxs);
+        if (std::any_of(unverifiedTxs.begin(), unverifiedTxs.end(),
+                [](auto const& tx) { return tx->invalid(); }))
+        {
+            verifySuccess = false;
+        }
+    }
     if (enforceImport && !verifySuccess)
     {
         return false;
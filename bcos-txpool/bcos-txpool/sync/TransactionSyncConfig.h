@@ -20,6 +20,7 @@
  */
 #pragma once
 #include "../txpool/interfaces/TxPoolStorageInterface.h"
+#include "../txpool/validator/TxBatchVerifier.h"
 #include "interfaces/TxsSyncMsgFactory.h"
 #include <bcos-framework/front/FrontServiceInterface.h>
 #include <bcos-framework/ledger/LedgerInterface.h>
@@ -63,6 +64,14 @@ public:
     void setForwardPercent(unsigned _forwardPercent) { m_forwardPercent = _forwardPercent; }
     std::shared_ptr<bcos::ledger::LedgerInterface> ledger() { return m_ledger; }
 
+    // verify the signatures of the downloaded txs on the arena of the submissions, verified in the
+    // calling thread if not set
+    bcos::txpool::TxBatchVerifier::Ptr batchVerifier() { return m_batchVerifier; }
+    void setBatchVerifier(bcos::txpool::TxBatchVerifier::Ptr _batchVerifier)
+    {
+        m_batchVerifier = std::move(_batchVerifier);
+    }
+
     // for ut
     void setTxPoolStorage(bcos::txpool::TxPoolStorageInterface::Ptr _txpoolStorage)
     {
@@ -82,6 +91,7 @@ public:
 private:
     bcos::front::FrontServiceInterface::Ptr m_frontService;
     bcos::txpool::TxPoolStorageInterface::Ptr m_txpoolStorage;
+    bcos::txpool::TxBatchVerifier::Ptr m_batchVerifier;
     bcos::sync::TxsSyncMsgFactory::Ptr m_msgFactory;
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     std::shared_ptr<bcos::ledger::LedgerInterface> m_ledger;
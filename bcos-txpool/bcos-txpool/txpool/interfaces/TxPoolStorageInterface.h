@@ -108,8 +108,14 @@ public:
 
     virtual std::shared_ptr<bcos::crypto::HashList> batchVerifyProposal(
         bcos::protocol::Block::Ptr _block) = 0;
+    // the txs of the proposal hit in the txpool are set into _hitTxs by their index without
+    // copying, the missed ones are left null
+    virtual std::shared_ptr<bcos::crypto::HashList> batchVerifyProposal(
+        bcos::protocol::Block::Ptr _block, bcos::protocol::TransactionsPtr _hitTxs) = 0;
 
     virtual bool batchVerifyProposal(std::shared_ptr<bcos::crypto::HashList> _txsHashList) = 0;
+    // move the spilled txs of _txsHash back into the txpool, and remove them from _txsHash
+    virtual void rehydrateTxs(bcos::crypto::HashList& _txsHash) = 0;
     virtual bcos::crypto::HashListPtr getTxsHash(int _limit) = 0;
 
     void registerTxsCleanUpSwitch(std::function<bool()> _txsCleanUpSwitch)
@@ -82,6 +82,10 @@ void MemoryStorage::stop()
     m_inRateCollector.stop();
     m_sealRateCollector.stop();
     m_removeRateCollector.stop();
+    if (m_spillWorker)
+    {
+        m_spillWorker->stop();
+    }
 }
 
 task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransaction(
@@ -98,6 +102,18 @@ task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransact
     {
         [[maybe_unused]] constexpr bool await_ready() { return false; }
         [[maybe_unused]] void await_suspend(CO_STD::coroutine_handle<> handle)
+        {
+            // verify the signature with the other submissions in parallel before submitting
+            if (auto const& batchVerifier = m_self->m_batchVerifier)
+            {
+                auto transaction = m_transaction;
+                batchVerifier->verify(
+                    std::move(transaction), [this, handle]() { submit(handle); });
+                return;
+            }
+            submit(handle);
+        }
+        void submit(CO_STD::coroutine_handle<> handle)
         {
             try
             {
@@ -208,6 +224,10 @@ TransactionStatus MemoryStorage::txpoolStorageCheck(
             return TransactionStatus::AlreadyInTxPool;
         }
     }
+    if (m_spillStore && m_spillStore->contains(txHash))
+    {
+        return TransactionStatus::AlreadyInTxPool;
+    }
     return TransactionStatus::None;
 }
 
@@ -248,6 +268,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
                 {
                     m_sealedTxsSize++;
                     tx->setSealed(true);
+                    m_sealingQueue.erase(tx->hash());
                 }
                 tx->setBatchId(_tx->batchId());
                 tx->setBatchHash(_tx->batchHash());
@@ -291,6 +312,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
         {
             tx->setSealed(true);
             m_sealedTxsSize++;
+            m_sealingQueue.erase(tx->hash());
         }
     }
     else
@@ -326,9 +348,14 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     }
     // Note: In order to ensure that transactions can reach all nodes, transactions from P2P are not
     // restricted
+    bool spill = false;
     if (checkPoolLimit && txsSize >= m_config->poolLimit())
     {
-        return TransactionStatus::TxPoolIsFull;
+        if (!m_spillStore || m_spillStore->full())
+        {
+            return TransactionStatus::TxPoolIsFull;
+        }
+        spill = true;
     }
 
     // verify the transaction
@@ -340,6 +367,16 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
         {
             transaction->setSubmitCallback(std::move(txSubmitCallback));
         }
+        if (spill)
+        {
+            if (m_spillStore->spill(transaction))
+            {
+                return TransactionStatus::None;
+            }
+            // the nonce has been recorded by the validator
+            m_config->txPoolNonceChecker()->remove(transaction->nonce());
+            return TransactionStatus::TxPoolIsFull;
+        }
         if (lock)
         {
             result = insert(std::move(transaction));
@@ -391,6 +428,11 @@ TransactionStatus MemoryStorage::insertWithoutLock(Transaction::Ptr transaction)
             return TransactionStatus::AlreadyInTxPool;
         }
     }
+    // a concurrent remove may run before the push, batchFetchTxs drops such stale entries
+    if (!transaction->sealed())
+    {
+        m_sealingQueue.push(transaction);
+    }
     m_onReady();
 
     notifyUnsealedTxsSize();
@@ -417,6 +459,10 @@ void MemoryStorage::onTxRemoved(const Transaction::Ptr& _tx, bool needNotifyUnse
     {
         --m_sealedTxsSize;
     }
+    if (_tx)
+    {
+        m_sealingQueue.erase(_tx->hash());
+    }
     if (needNotifyUnsealedTxsSize)
     {
         notifyUnsealedTxsSize();
@@ -429,6 +475,92 @@ void MemoryStorage::onTxRemoved(const Transaction::Ptr& _tx, bool needNotifyUnse
 #endif
 }
 
+Transaction::Ptr MemoryStorage::rehydrate(HashType const& _txHash)
+{
+    if (!m_spillStore)
+    {
+        return nullptr;
+    }
+    TxSpillStore::DroppedTxs droppedTxs;
+    auto tx = m_spillStore->take(_txHash, droppedTxs);
+    onSpilledTxsDropped(droppedTxs);
+    if (!tx)
+    {
+        return nullptr;
+    }
+    insertWithoutLock(tx);
+    return tx;
+}
+
+void MemoryStorage::onSpilledTxsDropped(TxSpillStore::DroppedTxs const& _droppedTxs)
+{
+    for (auto const& droppedTx : _droppedTxs)
+    {
+        m_config->txPoolNonceChecker()->remove(droppedTx.nonce);
+        notifyInvalidReceipt(droppedTx.txHash, TransactionStatus::Malformed, droppedTx.callback);
+    }
+}
+
+size_t MemoryStorage::refillFromSpillStore()
+{
+    if (!m_spillStore || m_spillStore->size() == 0)
+    {
+        return 0;
+    }
+    auto txsSize = m_txsTable.size();
+    if (txsSize >= m_config->poolLimit())
+    {
+        return 0;
+    }
+    auto startT = utcTime();
+    TxSpillStore::DroppedTxs droppedTxs;
+    auto txs = m_spillStore->load(m_config->poolLimit() - txsSize, droppedTxs);
+    onSpilledTxsDropped(droppedTxs);
+    for (auto const& tx : txs)
+    {
+        bool inserted = false;
+        {
+            TxsMap::WriteAccessor::Ptr accessor;
+            inserted = m_txsTable.insert(accessor, {tx->hash(), tx});
+        }
+        // never lock the sealing queue under the txs table, batchFetchTxs locks them the other way
+        if (inserted)
+        {
+            m_sealingQueue.push(tx);
+        }
+    }
+    if (!txs.empty())
+    {
+        m_onReady();
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("refillFromSpillStore") << LOG_KV("refilled", txs.size())
+                     << LOG_KV("dropped", droppedTxs.size())
+                     << LOG_KV("spilledTxs", m_spillStore->size())
+                     << LOG_KV("timecost", (utcTime() - startT));
+    return txs.size();
+}
+
+void MemoryStorage::asyncRefillFromSpillStore()
+{
+    if (!m_spillWorker || m_spillStore->size() == 0 || m_txsTable.size() >= m_config->poolLimit())
+    {
+        return;
+    }
+    // at most one refill is queued, the following removals trigger another one
+    if (m_refilling.exchange(true))
+    {
+        return;
+    }
+    m_spillWorker->enqueue([this]() {
+        auto refilled = refillFromSpillStore();
+        m_refilling = false;
+        if (refilled > 0)
+        {
+            notifyUnsealedTxsSize();
+        }
+    });
+}
+
 Transaction::Ptr MemoryStorage::removeWithoutNotifyUnseal(HashType const& _txHash)
 {
     auto tx = m_txsTable.remove(_txHash);
@@ -558,6 +690,18 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
             results[key].first = std::move(tx);
             m_removeRateCollector.update(1, true);
         });
+    // the txs committed by the blocks of the other leaders may be still spilled
+    TxSpillStore::DroppedTxs droppedTxs;
+    if (m_spillStore && m_spillStore->size() > 0)
+    {
+        for (auto& [txHash, result] : results)
+        {
+            if (!result.first)
+            {
+                result.first = m_spillStore->take(txHash, droppedTxs);
+            }
+        }
+    }
 
     if (batchId > m_blockNumber)
     {
@@ -583,6 +727,7 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
     auto removeT = utcTime() - startT;
 
     startT = utcTime();
+    asyncRefillFromSpillStore();
     notifyUnsealedTxsSize();
     // update the ledger nonce
 
@@ -612,6 +757,15 @@ void MemoryStorage::batchRemove(BlockNumber batchId, TransactionSubmitResults co
 
     tbb::parallel_for_each(txs2Notify.begin(), txs2Notify.end(),
         [&](auto& _result) { notifyTxResult(*_result.first, std::move(_result.second)); });
+    // the committed txs whose spilled records can't be read are notified with the results
+    for (auto const& droppedTx : droppedTxs)
+    {
+        m_config->txPoolNonceChecker()->remove(droppedTx.nonce);
+        if (droppedTx.callback)
+        {
+            droppedTx.callback(nullptr, std::move(results[droppedTx.txHash].second));
+        }
+    }
     // for (auto& [tx, txResult] : txs2Notify)
     // {
     //     notifyTxResult(*tx, std::move(txResult));
@@ -636,6 +790,11 @@ TransactionsPtr MemoryStorage::fetchTxs(HashList& _missedTxs, HashList const& _t
         auto has = m_txsTable.find<TxsMap::ReadAccessor>(accessor, hash);
         if (!has)
         {
+            if (auto tx = rehydrate(hash))
+            {
+                fetchedTxs->emplace_back(std::move(tx));
+                continue;
+            }
             _missedTxs.emplace_back(hash);
             continue;
         }
@@ -679,7 +838,10 @@ ConstTransactionsPtr MemoryStorage::fetchNewTxs(size_t _txsLimit)
 void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, size_t _txsLimit,
     TxsHashSetPtr _avoidTxs, bool _avoidDuplicate)
 {
+    // the txs refilled meanwhile are sealed by the next proposal
+    asyncRefillFromSpillStore();
     TXPOOL_LOG(INFO) << LOG_DESC("begin batchFetchTxs") << LOG_KV("pendingTxs", m_txsTable.size())
+                     << LOG_KV("spilledTxs", m_spillStore ? m_spillStore->size() : 0)
                      << LOG_KV("limit", _txsLimit);
     auto blockFactory = m_config->blockFactory();
     auto recordT = utcTime();
@@ -690,6 +852,7 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
     size_t traverseCount = 0;
     size_t sealed = 0;
 
+    // return true if the tx should leave the sealing queue: sealed, expired or invalid
     auto handleTx = [&](Transaction::Ptr tx) {
         traverseCount++;
         // Note: When inserting data into tbb::concurrent_unordered_map while traversing,
@@ -704,7 +867,12 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
         if (_avoidDuplicate && tx->sealed())
         {
             ++sealed;
-            return false;
+            return true;
+        }
+        // the tx has been removed from the txpool after it was queued
+        if (!m_txsTable.contains(txHash))
+        {
+            return true;
         }
 
         if (currentTime > (tx->importTime() + m_txsExpirationTime))
@@ -714,12 +882,12 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
                 TxsMap::WriteAccessor::Ptr accessor;
                 m_invalidTxs.insert(accessor, {txHash, tx});
             }
-            return false;
+            return true;
         }
 
         if (m_invalidTxs.contains(txHash))
         {
-            return false;
+            return true;
         }
         /// check nonce again when obtain transactions
         // since the invalid nonce has already been checked before the txs import into the
@@ -734,14 +902,14 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
             // add to m_invalidTxs to be deleted
             TxsMap::WriteAccessor::Ptr accessor;
             m_invalidTxs.insert(accessor, {txHash, tx});
-            return false;
+            return true;
         }
         // blockLimit expired
         if (result == TransactionStatus::BlockLimitCheckFail)
         {
             TxsMap::WriteAccessor::Ptr accessor;
             m_invalidTxs.insert(accessor, {txHash, tx});
-            return false;
+            return true;
         }
         if (_avoidTxs && _avoidTxs->contains(txHash))
         {
@@ -782,19 +950,23 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
 
     if (_avoidDuplicate)
     {
-        m_txsTable.forEach<TxsMap::ReadAccessor>(
-            m_knownLatestSealedTxHash, [&](TxsMap::ReadAccessor::Ptr accessor) {
-                const auto& tx = accessor->value();
-                handleTx(tx);
-                return (_txsList->transactionsMetaDataSize() +
-                           _sysTxsList->transactionsMetaDataSize()) < _txsLimit;
-            });
+        // only the unsealed txs are candidates, walk them in import order so the cost is bounded
+        // by the batch instead of the pool
+        m_sealingQueue.traverse([&](Transaction::Ptr const& tx) {
+            auto action =
+                handleTx(tx) ? SealingQueue::Action::REMOVE : SealingQueue::Action::KEEP;
+            return std::make_tuple(action, (_txsList->transactionsMetaDataSize() +
+                                               _sysTxsList->transactionsMetaDataSize()) < _txsLimit);
+        });
     }
     else
     {
         m_txsTable.forEach<TxsMap::ReadAccessor>([&](TxsMap::ReadAccessor::Ptr accessor) {
             const auto& tx = accessor->value();
-            handleTx(tx);
+            if (handleTx(tx))
+            {
+                m_sealingQueue.erase(tx->hash());
+            }
             return (_txsList->transactionsMetaDataSize() +
                        _sysTxsList->transactionsMetaDataSize()) < _txsLimit;
         });
@@ -812,7 +984,8 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
                      << LOG_KV("fetchTxsT", fetchTxsT) << LOG_KV("lockT", lockT)
                      << LOG_KV("invalidBefore", invalidTxsSize)
                      << LOG_KV("invalidNow", m_invalidTxs.size()) << LOG_KV("sealed", sealed)
-                     << LOG_KV("traverseCount", traverseCount);
+                     << LOG_KV("traverseCount", traverseCount)
+                     << LOG_KV("sealingQueue", m_sealingQueue.size());
 }
 #endif
 
@@ -845,6 +1018,7 @@ void MemoryStorage::removeInvalidTxs(bool lock)
             txs2Remove | RANGES::views::values |
             RANGES::views::transform([](auto const& tx2Remove) { return tx2Remove->nonce(); });
         m_config->txPoolNonceChecker()->batchRemove(invalidNonceList | RANGES::to_vector);
+        m_sealingQueue.batchErase(txs2Remove | RANGES::views::keys);
 
         /*
         m_txsTable.batchRemove(txs2Remove | RANGES::views::keys,
@@ -894,6 +1068,11 @@ void MemoryStorage::clear()
     m_txsTable.clear();
     m_invalidTxs.clear();
     m_missedTxs.clear();
+    m_sealingQueue.clear();
+    if (m_spillStore)
+    {
+        m_spillStore->clear();
+    }
     notifyUnsealedTxsSize();
 }
 
@@ -984,6 +1163,14 @@ bool MemoryStorage::batchMarkTxsWithoutLock(
             m_sealedTxsSize--;
         }
         tx->setSealed(_sealFlag);
+        if (_sealFlag)
+        {
+            m_sealingQueue.erase(txHash);
+        }
+        else
+        {
+            m_sealingQueue.push(tx);
+        }
         successCount += 1;
         // set the block information for the transaction
         if (_sealFlag)
@@ -1022,6 +1209,7 @@ void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
         {
             tx->setBatchId(-1);
             tx->setBatchHash(HashType());
+            m_sealingQueue.push(tx);
         }
         return true;
     });
@@ -1029,6 +1217,7 @@ void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
     if (_sealFlag)
     {
         m_sealedTxsSize = m_txsTable.size();
+        m_sealingQueue.clear();
     }
     else
     {
@@ -1088,9 +1277,19 @@ void MemoryStorage::notifyUnsealedTxsSize(size_t _retryTime)
 }
 
 std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
+{
+    return batchVerifyProposal(std::move(_block), nullptr);
+}
+
+std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(
+    Block::Ptr _block, TransactionsPtr _hitTxs)
 {
     auto missedTxs = std::make_shared<HashList>();
     auto txsSize = _block->transactionsHashSize();
+    if (_hitTxs)
+    {
+        _hitTxs->assign(txsSize, nullptr);
+    }
     if (txsSize == 0)
     {
         return missedTxs;
@@ -1102,30 +1301,38 @@ std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
     auto lockT = utcTime() - startT;
     startT = utcTime();
 
-    auto txHashes =
-        RANGES::iota_view<size_t, size_t>{0, txsSize} |
-        RANGES::views::transform([&_block](size_t i) { return _block->transactionHash(i); });
-    bool findErrorTxInBlock = false;
-
-    m_txsTable.batchFind<TxsMap::ReadAccessor>(
-        txHashes, [&missedTxs, &findErrorTxInBlock, _block](
-                      const auto& txHash, TxsMap::ReadAccessor::Ptr accessor) {
-            if (!accessor)
+    // look up the hashes in parallel, each lookup only takes the read lock of its bucket
+    std::vector<uint8_t> missed(txsSize, 0);
+    std::atomic_bool findErrorTxInBlock = false;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, txsSize),
+        [&](tbb::blocked_range<size_t> const& range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
             {
-                missedTxs->emplace_back(txHash);
-            }
-            else if (accessor->value()->sealed())
-            {
-                auto header = _block->blockHeader();
-                if ((accessor->value()->batchId() != header->number() &&
-                        accessor->value()->batchId() != -1))
+                if (findErrorTxInBlock)
+                {
+                    return;
+                }
+                auto txHash = _block->transactionHash(i);
+                Transaction::Ptr tx;
                 {
-                    TXPOOL_LOG(INFO)
-                        << LOG_DESC("batchVerifyProposal unexpected wrong tx")
-                        << LOG_KV("blkNum", header->number())
-                        << LOG_KV("blkHash", header->hash().abridged())
-                        << LOG_KV("txBatchId", accessor->value()->batchId())
-                        << LOG_KV("txBatchHash", accessor->value()->batchHash().abridged());
+                    TxsMap::ReadAccessor::Ptr accessor;
+                    if (m_txsTable.find<TxsMap::ReadAccessor>(accessor, txHash))
+                    {
+                        tx = accessor->value();
+                    }
+                }
+                if (!tx)
+                {
+                    missed[i] = 1;
+                    continue;
+                }
+                if (tx->sealed() && tx->batchId() != batchId && tx->batchId() != -1)
+                {
+                    TXPOOL_LOG(INFO) << LOG_DESC("batchVerifyProposal unexpected wrong tx")
+                                     << LOG_KV("blkNum", batchId)
+                                     << LOG_KV("blkHash", batchHash.abridged())
+                                     << LOG_KV("txBatchId", tx->batchId())
+                                     << LOG_KV("txBatchHash", tx->batchHash().abridged());
                     // NOTE: In certain scenarios, a bug may occur here: The leader generates the
                     // (N)th proposal, which includes transaction A. The local node puts this
                     // proposal into the cache and sets the batchId of transaction A to (N) and the
@@ -1143,11 +1350,25 @@ std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
                     //
                     // Therefore, we do not validate the consistency of the batchHash for now.
                     findErrorTxInBlock = true;
-                    return false;
+                    return;
+                }
+                if (_hitTxs)
+                {
+                    (*_hitTxs)[i] = std::move(tx);
                 }
             }
-            return true;
         });
+    // the spilled txs are left missed, they are read back by rehydrateTxs out of the verifier
+    if (!findErrorTxInBlock)
+    {
+        for (size_t i = 0; i < txsSize; ++i)
+        {
+            if (missed[i] != 0)
+            {
+                missedTxs->emplace_back(_block->transactionHash(i));
+            }
+        }
+    }
 
     TXPOOL_LOG(INFO) << LOG_DESC("batchVerifyProposal") << LOG_KV("consNum", batchId)
                      << LOG_KV("hash", batchHash.abridged()) << LOG_KV("txsSize", txsSize)
@@ -1168,6 +1389,28 @@ bool MemoryStorage::batchVerifyProposal(std::shared_ptr<HashList> _txsHashList)
     return has;
 }
 
+void MemoryStorage::rehydrateTxs(HashList& _txsHash)
+{
+    if (!m_spillStore || m_spillStore->size() == 0)
+    {
+        return;
+    }
+    TxSpillStore::DroppedTxs droppedTxs;
+    auto txs = m_spillStore->take(_txsHash, droppedTxs);
+    onSpilledTxsDropped(droppedTxs);
+    size_t missed = 0;
+    for (size_t i = 0; i < _txsHash.size(); ++i)
+    {
+        if (txs[i])
+        {
+            insertWithoutLock(txs[i]);
+            continue;
+        }
+        _txsHash[missed++] = _txsHash[i];
+    }
+    _txsHash.resize(missed);
+}
+
 HashListPtr MemoryStorage::getTxsHash(int _limit)
 {
     auto txsHash = std::make_shared<HashList>();
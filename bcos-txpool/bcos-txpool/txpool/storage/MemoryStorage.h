@@ -22,7 +22,10 @@
 
 #include "bcos-task/Task.h"
 #include "bcos-txpool/TxPoolConfig.h"
+#include "bcos-txpool/txpool/storage/TxSpillStore.h"
 #include "bcos-txpool/txpool/utilities/Common.h"
+#include "bcos-txpool/txpool/validator/TxBatchVerifier.h"
+#include <bcos-txpool/bcos-txpool/txpool/utilities/SealingQueue.h>
 #include <bcos-txpool/bcos-txpool/txpool/utilities/TransactionBucket.h>
 #include <bcos-utilities/BucketMap.h>
 #include <bcos-utilities/FixedBytes.h>
@@ -95,9 +98,14 @@ public:
     bool exist(bcos::crypto::HashType const& _txHash) override
     {
         TxsMap::ReadAccessor::Ptr accessor;
-        return m_txsTable.find<TxsMap::ReadAccessor>(accessor, _txHash);
+        return m_txsTable.find<TxsMap::ReadAccessor>(accessor, _txHash) ||
+               (m_spillStore && m_spillStore->contains(_txHash));
+    }
+    // the pending txs, including the spilled ones
+    size_t size() const override
+    {
+        return m_txsTable.size() + (m_spillStore ? m_spillStore->size() : 0);
     }
-    size_t size() const override { return m_txsTable.size(); }
     void clear() override;
 
     // FIXME: deprecated, after using txpool::broadcastTransaction
@@ -114,8 +122,11 @@ public:
 
     std::shared_ptr<bcos::crypto::HashList> batchVerifyProposal(
         bcos::protocol::Block::Ptr _block) override;
+    std::shared_ptr<bcos::crypto::HashList> batchVerifyProposal(
+        bcos::protocol::Block::Ptr _block, bcos::protocol::TransactionsPtr _hitTxs) override;
 
     bool batchVerifyProposal(std::shared_ptr<bcos::crypto::HashList> _txsHashList) override;
+    void rehydrateTxs(bcos::crypto::HashList& _txsHash) override;
 
     bool batchVerifyAndSubmitTransaction(
         bcos::protocol::BlockHeader::Ptr _header, bcos::protocol::TransactionsPtr _txs) override;
@@ -130,6 +141,23 @@ public:
         protocol::Transaction::Ptr transaction, protocol::TxSubmitCallback txSubmitCallback,
         bool checkPoolLimit, bool lock);
 
+    // verify the signatures of the submitted txs in parallel batches, verified one by one in
+    // the submitting thread if not set
+    void setBatchVerifier(TxBatchVerifier::Ptr _batchVerifier)
+    {
+        m_batchVerifier = std::move(_batchVerifier);
+    }
+    // accept the submitted txs into the spill store when the pool is full instead of rejecting
+    // them, rejected with TxPoolIsFull if not set
+    void setSpillStore(TxSpillStore::Ptr _spillStore)
+    {
+        m_spillStore = std::move(_spillStore);
+        if (m_spillStore && !m_spillWorker)
+        {
+            m_spillWorker = std::make_shared<ThreadPool>("txsRefill", 1);
+        }
+    }
+
 protected:
     bcos::protocol::TransactionStatus insertWithoutLock(
         bcos::protocol::Transaction::Ptr transaction);
@@ -142,6 +170,16 @@ protected:
 
     void onTxRemoved(const bcos::protocol::Transaction::Ptr& _tx, bool needNotifyUnsealedTxsSize);
 
+    // move the spilled tx back into the pool, nullptr if not spilled
+    bcos::protocol::Transaction::Ptr rehydrate(bcos::crypto::HashType const& _txHash);
+    // reject the spilled txs whose records can't be read back and release their nonces
+    void onSpilledTxsDropped(TxSpillStore::DroppedTxs const& _droppedTxs);
+    // move the spilled txs back into the pool in submission order until the pool is full, return
+    // the number of the txs moved
+    size_t refillFromSpillStore();
+    // refill in m_spillWorker, the sealing and the committing threads never read the spill file
+    void asyncRefillFromSpillStore();
+
     virtual bcos::protocol::Transaction::Ptr removeWithoutNotifyUnseal(
         bcos::crypto::HashType const& _txHash);
     virtual bcos::protocol::Transaction::Ptr removeSubmittedTxWithoutLock(
@@ -174,6 +212,8 @@ protected:
 
     using HashSet = BucketSet<bcos::crypto::HashType, std::hash<bcos::crypto::HashType>>;
     HashSet m_missedTxs;
+    // the unsealed txs of m_txsTable in sealing order
+    SealingQueue m_sealingQueue;
 
     std::atomic<size_t> m_sealedTxsSize = {0};
 
@@ -194,5 +234,11 @@ protected:
     RateCollector m_removeRateCollector;
 
     bcos::crypto::HashType m_knownLatestSealedTxHash;
+
+    TxBatchVerifier::Ptr m_batchVerifier;
+    TxSpillStore::Ptr m_spillStore;
+    std::atomic_bool m_refilling = {false};
+    // destroyed first, so the running refill finishes before the members go
+    ThreadPool::Ptr m_spillWorker;
 };
 }  // namespace bcos::txpool
\ No newline at end of file
@@ -0,0 +1,346 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief overflow tier of the txpool, keeping the pending txs on disk
+ * @file TxSpillStore.cpp
+ */
+#include "TxSpillStore.h"
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <unordered_map>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+TxSpillStore::TxSpillStore(std::string _path, size_t _limit,
+    bcos::protocol::TransactionFactory::Ptr _txFactory, uint64_t _minCompactBytes)
+  : m_path(std::move(_path)),
+    m_limit(_limit),
+    m_txFactory(std::move(_txFactory)),
+    m_minCompactBytes(_minCompactBytes)
+{
+    auto parentPath = boost::filesystem::path(m_path).parent_path();
+    if (!parentPath.empty())
+    {
+        boost::filesystem::create_directories(parentPath);
+    }
+    reset();
+    if (!m_file.is_open())
+    {
+        BOOST_THROW_EXCEPTION(std::runtime_error("open txpool spill file failed: " + m_path));
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("create TxSpillStore") << LOG_KV("path", m_path)
+                     << LOG_KV("limit", m_limit);
+}
+
+bool TxSpillStore::spill(Transaction::Ptr const& _tx)
+{
+    bytes encodedData;
+    _tx->encode(encodedData);
+
+    std::unique_lock lock(m_mutex);
+    auto& hashIndex = m_index.get<1>();
+    if (m_index.size() >= m_limit || hashIndex.find(_tx->hash()) != hashIndex.end())
+    {
+        return false;
+    }
+    m_file.clear();
+    m_file.seekp(static_cast<std::streamoff>(m_fileSize));
+    m_file.write(reinterpret_cast<const char*>(encodedData.data()),
+        static_cast<std::streamsize>(encodedData.size()));
+    if (!m_file)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxSpillStore: write failed")
+                            << LOG_KV("tx", _tx->hash().abridged()) << LOG_KV("path", m_path);
+        return false;
+    }
+    m_index.push_back(Entry{.txHash = _tx->hash(),
+        .offset = m_fileSize,
+        .size = static_cast<uint32_t>(encodedData.size()),
+        .nonce = _tx->nonce(),
+        .callback = _tx->submitCallback()});
+    m_fileSize += encodedData.size();
+    m_liveBytes += encodedData.size();
+    return true;
+}
+
+Transaction::Ptr TxSpillStore::take(bcos::crypto::HashType const& _txHash, DroppedTxs& _droppedTxs)
+{
+    std::unique_lock lock(m_mutex);
+    auto& hashIndex = m_index.get<1>();
+    auto it = hashIndex.find(_txHash);
+    if (it == hashIndex.end())
+    {
+        return nullptr;
+    }
+    auto tx = read(*it, _droppedTxs);
+    auto size = it->size;
+    hashIndex.erase(it);
+    release(size);
+    return tx;
+}
+
+Transactions TxSpillStore::take(bcos::crypto::HashList const& _txsHash, DroppedTxs& _droppedTxs)
+{
+    Transactions txs(_txsHash.size());
+    std::unique_lock lock(m_mutex);
+    auto& hashIndex = m_index.get<1>();
+    std::vector<std::pair<size_t, decltype(hashIndex.begin())>> entries;
+    entries.reserve(_txsHash.size());
+    for (size_t i = 0; i < _txsHash.size(); ++i)
+    {
+        if (auto it = hashIndex.find(_txsHash[i]); it != hashIndex.end())
+        {
+            entries.emplace_back(i, it);
+        }
+    }
+    if (entries.empty())
+    {
+        return txs;
+    }
+    // every range reads the file by its own stream, the lock is held so the file is neither
+    // truncated nor switched by the compaction meanwhile
+    m_file.flush();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, entries.size()),
+        [this, &entries, &txs](tbb::blocked_range<size_t> const& range) {
+            std::ifstream file(m_path, std::ios::in | std::ios::binary);
+            bytes buffer;
+            for (auto i = range.begin(); i < range.end(); ++i)
+            {
+                auto const& [index, it] = entries[i];
+                txs[index] = read(*it, file, buffer);
+            }
+        });
+    for (auto const& [index, entry] : entries)
+    {
+        // found again by the hash, the same tx may be listed twice
+        auto it = hashIndex.find(_txsHash[index]);
+        if (it == hashIndex.end())
+        {
+            continue;
+        }
+        if (!txs[index])
+        {
+            _droppedTxs.emplace_back(DroppedTx{it->txHash, it->nonce, it->callback});
+        }
+        auto size = it->size;
+        hashIndex.erase(it);
+        release(size);
+    }
+    return txs;
+}
+
+Transactions TxSpillStore::load(size_t _limit, DroppedTxs& _droppedTxs)
+{
+    Transactions txs;
+    std::unique_lock lock(m_mutex);
+    txs.reserve(std::min(_limit, m_index.size()));
+    for (size_t i = 0; i < _limit && !m_index.empty(); ++i)
+    {
+        auto it = m_index.begin();
+        if (auto tx = read(*it, _droppedTxs))
+        {
+            txs.emplace_back(std::move(tx));
+        }
+        auto size = it->size;
+        m_index.pop_front();
+        release(size);
+    }
+    return txs;
+}
+
+bool TxSpillStore::contains(bcos::crypto::HashType const& _txHash) const
+{
+    std::unique_lock lock(m_mutex);
+    auto const& hashIndex = m_index.get<1>();
+    return hashIndex.find(_txHash) != hashIndex.end();
+}
+
+size_t TxSpillStore::size() const
+{
+    std::unique_lock lock(m_mutex);
+    return m_index.size();
+}
+
+bool TxSpillStore::full() const
+{
+    std::unique_lock lock(m_mutex);
+    return m_index.size() >= m_limit;
+}
+
+void TxSpillStore::clear()
+{
+    std::unique_lock lock(m_mutex);
+    m_index.clear();
+    reset();
+}
+
+uint64_t TxSpillStore::fileSize() const
+{
+    std::unique_lock lock(m_mutex);
+    return m_fileSize;
+}
+
+Transaction::Ptr TxSpillStore::read(Entry const& _entry, DroppedTxs& _droppedTxs)
+{
+    auto tx = read(_entry, m_file, m_buffer);
+    if (!tx)
+    {
+        _droppedTxs.emplace_back(DroppedTx{_entry.txHash, _entry.nonce, _entry.callback});
+    }
+    return tx;
+}
+
+Transaction::Ptr TxSpillStore::read(Entry const& _entry, std::istream& _file, bytes& _buffer) const
+{
+    _buffer.resize(_entry.size);
+    _file.clear();
+    _file.seekg(static_cast<std::streamoff>(_entry.offset));
+    _file.read(reinterpret_cast<char*>(_buffer.data()), _entry.size);
+    if (!_file)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxSpillStore: read failed")
+                            << LOG_KV("tx", _entry.txHash.abridged())
+                            << LOG_KV("offset", _entry.offset) << LOG_KV("path", m_path);
+        return nullptr;
+    }
+    try
+    {
+        // the signature has been verified before spilled, and the sender is encoded with the tx
+        auto tx = m_txFactory->createTransaction(bcos::ref(_buffer), false);
+        if (_entry.callback)
+        {
+            tx->setSubmitCallback(_entry.callback);
+        }
+        return tx;
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxSpillStore: decode failed")
+                            << LOG_KV("tx", _entry.txHash.abridged())
+                            << LOG_KV("message", boost::diagnostic_information(e));
+    }
+    return nullptr;
+}
+
+void TxSpillStore::release(uint32_t _size)
+{
+    m_liveBytes -= _size;
+    if (m_index.empty())
+    {
+        reset();
+        return;
+    }
+    auto deadBytes = m_fileSize - m_liveBytes;
+    if (!m_compacting && deadBytes > m_liveBytes && deadBytes > m_minCompactBytes)
+    {
+        m_compacting = true;
+        m_compactor.enqueue([this]() { compact(); });
+    }
+}
+
+void TxSpillStore::reset()
+{
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_file.open(m_path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    m_fileSize = 0;
+    m_liveBytes = 0;
+    ++m_generation;
+}
+
+// rewrite the live records into a new file, in the order of the index. The records are copied
+// without the lock, the records spilled meanwhile are appended under the lock before the switch
+void TxSpillStore::compact()
+{
+    auto startT = utcTime();
+    std::vector<std::tuple<bcos::crypto::HashType, uint64_t, uint32_t>> records;
+    uint64_t fileSize = 0;
+    uint64_t generation = 0;
+    {
+        std::unique_lock lock(m_mutex);
+        // the records buffered by m_file must reach the file before it is copied by another stream
+        m_file.flush();
+        records.reserve(m_index.size());
+        for (auto const& entry : m_index)
+        {
+            records.emplace_back(entry.txHash, entry.offset, entry.size);
+        }
+        fileSize = m_fileSize;
+        generation = m_generation;
+    }
+
+    auto compactPath = m_path + ".compact";
+    std::ifstream file(m_path, std::ios::in | std::ios::binary);
+    std::ofstream compactFile(compactPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    std::unordered_map<bcos::crypto::HashType, uint64_t, std::hash<bcos::crypto::HashType>>
+        offsets;
+    offsets.reserve(records.size());
+    bytes buffer;
+    uint64_t offset = 0;
+    for (auto const& [txHash, recordOffset, size] : records)
+    {
+        buffer.resize(size);
+        file.seekg(static_cast<std::streamoff>(recordOffset));
+        file.read(reinterpret_cast<char*>(buffer.data()), size);
+        compactFile.write(
+            reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(size));
+        offsets.emplace(txHash, offset);
+        offset += size;
+    }
+
+    std::unique_lock lock(m_mutex);
+    m_compacting = false;
+    // the records spilled during the copy
+    auto tailSize = m_fileSize - fileSize;
+    if (file && compactFile && generation == m_generation && tailSize > 0)
+    {
+        m_buffer.resize(tailSize);
+        m_file.clear();
+        m_file.seekg(static_cast<std::streamoff>(fileSize));
+        m_file.read(
+            reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(tailSize));
+        compactFile.write(
+            reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(tailSize));
+    }
+    compactFile.close();
+    if (!file || !compactFile || !m_file || generation != m_generation)
+    {
+        // keep the current file, the dead records are compacted next time
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxSpillStore: compact failed") << LOG_KV("path", m_path)
+                            << LOG_KV("truncated", generation != m_generation);
+        boost::system::error_code ec;
+        boost::filesystem::remove(compactPath, ec);
+        return;
+    }
+    m_file.close();
+    boost::filesystem::rename(compactPath, m_path);
+    m_file.open(m_path, std::ios::in | std::ios::out | std::ios::binary);
+    for (auto it = m_index.begin(); it != m_index.end(); ++it)
+    {
+        auto newOffset = it->offset >= fileSize ? offset + it->offset - fileSize :
+                                                  offsets.at(it->txHash);
+        m_index.modify(it, [newOffset](Entry& _entry) { _entry.offset = newOffset; });
+    }
+    TXPOOL_LOG(INFO) << LOG_DESC("TxSpillStore: compact") << LOG_KV("txs", m_index.size())
+                     << LOG_KV("deadBytes", fileSize - offset) << LOG_KV("liveBytes", m_liveBytes)
+                     << LOG_KV("timecost", (utcTime() - startT));
+    m_fileSize = offset + tailSize;
+}
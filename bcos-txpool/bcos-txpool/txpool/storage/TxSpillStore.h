@@ -0,0 +1,123 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief overflow tier of the txpool, keeping the pending txs on disk
+ * @file TxSpillStore.h
+ */
+#pragma once
+#include "bcos-txpool/txpool/utilities/Common.h"
+#include <bcos-framework/protocol/Transaction.h>
+#include <bcos-framework/protocol/TransactionFactory.h>
+#include <bcos-framework/txpool/TxPoolTypeDef.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <fstream>
+#include <mutex>
+
+namespace bcos::txpool
+{
+// The pending txs submitted while the memory pool is full are encoded into an append-only file,
+// only the offset, the size, the nonce and the submit callback of each tx stay in memory. The txs
+// are loaded back in submission order once the pool has room again. The txs of the file are
+// dropped on restart, the same as the memory pool. The dead records are compacted in background
+class TxSpillStore
+{
+public:
+    using Ptr = std::shared_ptr<TxSpillStore>;
+    // the spilled tx whose record can't be read back, the pool notifies its callback and releases
+    // its nonce
+    struct DroppedTx
+    {
+        bcos::crypto::HashType txHash;
+        bcos::protocol::NonceType nonce;
+        bcos::protocol::TxSubmitCallback callback;
+    };
+    using DroppedTxs = std::vector<DroppedTx>;
+
+    TxSpillStore(std::string _path, size_t _limit,
+        bcos::protocol::TransactionFactory::Ptr _txFactory,
+        uint64_t _minCompactBytes = MIN_SPILL_COMPACT_BYTES);
+    TxSpillStore(const TxSpillStore&) = delete;
+    TxSpillStore(TxSpillStore&&) = delete;
+    TxSpillStore& operator=(const TxSpillStore&) = delete;
+    TxSpillStore& operator=(TxSpillStore&&) = delete;
+    virtual ~TxSpillStore() = default;
+
+    // Write the verified tx to the file with its submit callback, return false if the store is
+    // full, already has the tx or the write failed
+    virtual bool spill(bcos::protocol::Transaction::Ptr const& _tx);
+    // Take the tx out of the store, nullptr if missing or its record can't be read, which is
+    // appended to _droppedTxs
+    virtual bcos::protocol::Transaction::Ptr take(
+        bcos::crypto::HashType const& _txHash, DroppedTxs& _droppedTxs);
+    // Take the txs out of the store, the records are read concurrently. The result is aligned
+    // with _txsHash, nullptr if missing or its record can't be read
+    virtual bcos::protocol::Transactions take(
+        bcos::crypto::HashList const& _txsHash, DroppedTxs& _droppedTxs);
+    // Take at most _limit records out of the store in submission order, the records can't be read
+    // are appended to _droppedTxs
+    virtual bcos::protocol::Transactions load(size_t _limit, DroppedTxs& _droppedTxs);
+
+    virtual bool contains(bcos::crypto::HashType const& _txHash) const;
+    virtual size_t size() const;
+    virtual bool full() const;
+    virtual void clear();
+
+    // size of the file, including the records of the txs already taken
+    uint64_t fileSize() const;
+
+private:
+    struct Entry
+    {
+        bcos::crypto::HashType txHash;
+        uint64_t offset;
+        uint32_t size;
+        bcos::protocol::NonceType nonce;
+        bcos::protocol::TxSubmitCallback callback;
+    };
+    using Index = boost::multi_index::multi_index_container<Entry,
+        boost::multi_index::indexed_by<boost::multi_index::sequenced<>,
+            boost::multi_index::hashed_unique<
+                boost::multi_index::member<Entry, bcos::crypto::HashType, &Entry::txHash>,
+                std::hash<bcos::crypto::HashType>>>>;
+
+    bcos::protocol::Transaction::Ptr read(Entry const& _entry, DroppedTxs& _droppedTxs);
+    bcos::protocol::Transaction::Ptr read(
+        Entry const& _entry, std::istream& _file, bcos::bytes& _buffer) const;
+    void release(uint32_t _size);
+    void reset();
+    void compact();
+
+    std::string m_path;
+    size_t m_limit;
+    bcos::protocol::TransactionFactory::Ptr m_txFactory;
+    uint64_t m_minCompactBytes;
+
+    mutable std::mutex m_mutex;
+    Index m_index;
+    std::fstream m_file;
+    uint64_t m_fileSize = 0;
+    uint64_t m_liveBytes = 0;
+    bcos::bytes m_buffer;
+    // increased when the file is truncated, the compaction started before is abandoned
+    uint64_t m_generation = 0;
+    bool m_compacting = false;
+    // destroyed first, so the running compaction finishes before the members go
+    bcos::ThreadPool m_compactor{"spillCompact", 1};
+};
+}  // namespace bcos::txpool
@@ -33,4 +33,10 @@ static constexpr const uint64_t MAX_TRAVERSE_TXS_COUNT = 10000;
 static constexpr const size_t MAX_RETRY_NOTIFY_TIME = 3;
 static constexpr const size_t DEFAULT_POOL_LIMIT = 15000;
 static constexpr const int64_t DEFAULT_BLOCK_LIMIT = 600;
+// Maximum number of transactions verified together by TxBatchVerifier
+static constexpr const size_t DEFAULT_VERIFY_BATCH_SIZE = 1000;
+// Counters of the nonce prefilter, 4MB for each nonce checker
+static constexpr const size_t DEFAULT_NONCE_FILTER_SIZE = size_t(1) << 22;
+// The spill file is compacted once the dead records exceed both the live ones and this size
+static constexpr const uint64_t MIN_SPILL_COMPACT_BYTES = uint64_t(64) << 20;
 }  // namespace bcos::txpool
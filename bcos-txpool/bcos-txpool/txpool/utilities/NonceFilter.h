@@ -0,0 +1,125 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief lock-free prefilter of the nonces
+ * @file NonceFilter.h
+ */
+#pragma once
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+
+namespace bcos::txpool
+{
+// Counting bloom filter of the nonces, the counters are atomics so checking, inserting and removing
+// never take a lock. mayContain returning false means the nonce is definitely absent, which is the
+// common case for a new transaction, so the exact nonce set is only consulted on a hit. A counter
+// reaching the maximum sticks there and is never decremented, trading false positives for never
+// reporting a present nonce as absent
+class NonceFilter
+{
+public:
+    explicit NonceFilter(size_t _size)
+      : m_mask(roundUpPowerOfTwo(_size) - 1),
+        m_counters(std::make_unique<std::atomic_uint8_t[]>(m_mask + 1))
+    {}
+    NonceFilter(const NonceFilter&) = delete;
+    NonceFilter(NonceFilter&&) = delete;
+    NonceFilter& operator=(const NonceFilter&) = delete;
+    NonceFilter& operator=(NonceFilter&&) = delete;
+    ~NonceFilter() = default;
+
+    // Must be called once for each nonce really inserted into the exact set
+    void insert(bcos::protocol::NonceType const& _nonce)
+    {
+        for (auto index : indexes(_nonce))
+        {
+            auto& counter = m_counters[index];
+            auto value = counter.load(std::memory_order_relaxed);
+            while (value != MAX_COUNT &&
+                   !counter.compare_exchange_weak(value, value + 1, std::memory_order_release,
+                       std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    // Must be called once for each nonce really removed from the exact set
+    void remove(bcos::protocol::NonceType const& _nonce)
+    {
+        for (auto index : indexes(_nonce))
+        {
+            auto& counter = m_counters[index];
+            auto value = counter.load(std::memory_order_relaxed);
+            while (value != MAX_COUNT && value != 0 &&
+                   !counter.compare_exchange_weak(value, value - 1, std::memory_order_release,
+                       std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    bool mayContain(bcos::protocol::NonceType const& _nonce) const
+    {
+        for (auto index : indexes(_nonce))
+        {
+            if (m_counters[index].load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    constexpr static size_t HASH_COUNT = 3;
+    constexpr static uint8_t MAX_COUNT = std::numeric_limits<uint8_t>::max();
+
+    static size_t roundUpPowerOfTwo(size_t _size)
+    {
+        size_t result = 1;
+        while (result < _size)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::array<size_t, HASH_COUNT> indexes(bcos::protocol::NonceType const& _nonce) const
+    {
+        // double hashing with the two halves of the mixed hash
+        uint64_t hash = std::hash<bcos::protocol::NonceType>{}(_nonce);
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        auto first = static_cast<uint32_t>(hash);
+        auto second = static_cast<uint32_t>(hash >> 32) | 1U;
+
+        std::array<size_t, HASH_COUNT> result;
+        for (size_t i = 0; i < HASH_COUNT; ++i)
+        {
+            result[i] = (first + i * second) & m_mask;
+        }
+        return result;
+    }
+
+    size_t m_mask;
+    std::unique_ptr<std::atomic_uint8_t[]> m_counters;
+};
+}  // namespace bcos::txpool
@@ -0,0 +1,145 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the queue of the unsealed transactions in sealing order
+ * @file SealingQueue.h
+ */
+#pragma once
+
+#include "bcos-crypto/bcos-crypto/interfaces/crypto/CommonType.h"
+#include "bcos-framework/bcos-framework/protocol/Transaction.h"
+#include "bcos-utilities/bcos-utilities/Ranges.h"
+#include "boost/multi_index/composite_key.hpp"
+#include "boost/multi_index/hashed_index.hpp"
+#include "boost/multi_index/member.hpp"
+#include "boost/multi_index/ordered_index.hpp"
+#include "boost/multi_index_container.hpp"
+#include <cstdint>
+#include <mutex>
+
+namespace bcos::txpool
+{
+
+// Index of the unsealed transactions ordered by import time, with the import sequence breaking the
+// ties. The sealer walks the queue from the front and only touches the transactions it seals or
+// drops, the sealed, removed and expired transactions are taken out eagerly
+class SealingQueue
+{
+public:
+    enum class Action
+    {
+        KEEP,    // leave the transaction in the queue
+        REMOVE,  // take the transaction out of the queue
+    };
+
+private:
+    struct QueueItem
+    {
+        bcos::crypto::HashType txHash;
+        int64_t importTime;
+        uint64_t sequence;
+        bcos::protocol::Transaction::Ptr transaction;
+    };
+
+    using Container = boost::multi_index::multi_index_container<QueueItem,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<boost::multi_index::member<QueueItem,
+                bcos::crypto::HashType, &QueueItem::txHash>>,
+            boost::multi_index::ordered_unique<boost::multi_index::composite_key<QueueItem,
+                boost::multi_index::member<QueueItem, int64_t, &QueueItem::importTime>,
+                boost::multi_index::member<QueueItem, uint64_t, &QueueItem::sequence>>>>>;
+
+    Container m_container;
+    uint64_t m_sequence = 0;
+    mutable std::mutex m_mutex;
+
+public:
+    SealingQueue() = default;
+    SealingQueue(const SealingQueue&) = delete;
+    SealingQueue(SealingQueue&&) = delete;
+    SealingQueue& operator=(const SealingQueue&) = delete;
+    SealingQueue& operator=(SealingQueue&&) = delete;
+    ~SealingQueue() = default;
+
+    bool push(bcos::protocol::Transaction::Ptr transaction)
+    {
+        std::unique_lock lock(m_mutex);
+        auto txHash = transaction->hash();
+        auto importTime = transaction->importTime();
+        auto [it, inserted] = m_container.emplace(
+            QueueItem{txHash, importTime, m_sequence, std::move(transaction)});
+        if (inserted)
+        {
+            ++m_sequence;
+        }
+        return inserted;
+    }
+
+    bool erase(bcos::crypto::HashType const& txHash)
+    {
+        std::unique_lock lock(m_mutex);
+        return m_container.get<0>().erase(txHash) > 0;
+    }
+
+    void batchErase(RANGES::input_range auto const& txHashes)
+    {
+        std::unique_lock lock(m_mutex);
+        auto& index = m_container.get<0>();
+        for (auto const& txHash : txHashes)
+        {
+            index.erase(txHash);
+        }
+    }
+
+    size_t size() const
+    {
+        std::unique_lock lock(m_mutex);
+        return m_container.size();
+    }
+
+    void clear()
+    {
+        std::unique_lock lock(m_mutex);
+        m_container.clear();
+    }
+
+    // Walk the queue from the front, the handler returns the action to take on the transaction and
+    // whether to continue. The handler is called with the queue locked, it must not access the
+    // queue itself
+    void traverse(auto&& handler)
+    {
+        std::unique_lock lock(m_mutex);
+        auto& index = m_container.get<1>();
+        auto it = index.begin();
+        while (it != index.end())
+        {
+            auto [action, isContinue] = handler(it->transaction);
+            if (action == Action::REMOVE)
+            {
+                it = index.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+            if (!isContinue)
+            {
+                break;
+            }
+        }
+    }
+};
+
+}  // namespace bcos::txpool
@@ -26,11 +26,37 @@ using namespace bcos::txpool;
 void LedgerNonceChecker::initNonceCache(
     std::shared_ptr<std::map<int64_t, bcos::protocol::NonceListPtr> > _initialNonces)
 {
+    WriteGuard lock(x_blockNonceCache);
     for (auto const& it : *_initialNonces)
     {
-        m_blockNonceCache[it.first] = it.second;
-        TxPoolNonceChecker::batchInsert(it.first, it.second);
+        if (it.first >= 0 && cacheBlockNonces(it.first, it.second))
+        {
+            TxPoolNonceChecker::batchInsert(it.first, it.second);
+        }
+    }
+}
+
+bool LedgerNonceChecker::cacheBlockNonces(BlockNumber _batchId, NonceListPtr const& _nonceList)
+{
+    auto& cached = blockNonces(_batchId);
+    if (cached.number >= _batchId)
+    {
+        return cached.number == _batchId;
+    }
+    // the epoch is still taken by an expired block which has not been evicted, e.g. the blocks
+    // between have been skipped
+    if (cached.nonces)
+    {
+        batchRemove(*cached.nonces);
+        NONCECHECKER_LOG(DEBUG) << LOG_DESC("remove the nonces of the stale block")
+                                << LOG_KV("staleBatchId", cached.number)
+                                << LOG_KV("nonceSize", cached.nonces->size());
     }
+    cached.number = _batchId;
+    cached.nonces = _nonceList;
+    NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert nonceList") << LOG_KV("batchId", _batchId)
+                            << LOG_KV("nonceSize", _nonceList->size());
+    return true;
 }
 
 TransactionStatus LedgerNonceChecker::checkNonce(Transaction::ConstPtr _tx, bool _shouldUpdate)
@@ -68,32 +94,35 @@ void LedgerNonceChecker::batchInsert(BlockNumber _batchId, NonceListPtr const& _
         m_blockNumber.store(_batchId);
     }
     ssize_t batchToBeRemoved = (_batchId > m_blockLimit) ? (_batchId - m_blockLimit) : -1;
-    // insert the latest nonces
-    TxPoolNonceChecker::batchInsert(_batchId, _nonceList);
 
     WriteGuard lock(x_blockNonceCache);
-    if (!m_blockNonceCache.contains(_batchId))
+    // the nonces of a block older than the one of its epoch would never be evicted
+    if (!cacheBlockNonces(_batchId, _nonceList))
     {
-        m_blockNonceCache[_batchId] = _nonceList;
-        NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert nonceList") << LOG_KV("batchId", _batchId)
+        NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert: ignore the nonces of the stale block")
+                                << LOG_KV("batchId", _batchId)
                                 << LOG_KV("nonceSize", _nonceList->size());
+        return;
     }
+    // insert the latest nonces
+    TxPoolNonceChecker::batchInsert(_batchId, _nonceList);
     // the genesis has no nonceList
     if (batchToBeRemoved == -1)
     {
         return;
     }
     // remove the expired nonces
-    if (!m_blockNonceCache.contains(batchToBeRemoved))
+    auto& expired = blockNonces(batchToBeRemoved);
+    if (expired.number != batchToBeRemoved)
     {
         NONCECHECKER_LOG(WARNING) << LOG_DESC("batchInsert: miss cache when remove expired cache")
                                   << LOG_KV("batchToBeRemoved", batchToBeRemoved);
         return;
     }
-    auto nonceList = m_blockNonceCache[batchToBeRemoved];
-    m_blockNonceCache.erase(batchToBeRemoved);
+    auto nonceList = std::move(expired.nonces);
+    expired.number = -1;
     batchRemove(*nonceList);
     NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert: remove expired nonce")
                             << LOG_KV("batchToBeRemoved", batchToBeRemoved)
                             << LOG_KV("nonceSize", nonceList->size());
-}
\ No newline at end of file
+}
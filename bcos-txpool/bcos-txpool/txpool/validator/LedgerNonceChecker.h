@@ -29,8 +29,12 @@ class LedgerNonceChecker : public TxPoolNonceChecker
 public:
     LedgerNonceChecker(
         std::shared_ptr<std::map<int64_t, bcos::protocol::NonceListPtr> > _initialNonces,
-        bcos::protocol::BlockNumber _blockNumber, int64_t _blockLimit)
-      : TxPoolNonceChecker(), m_blockNumber(_blockNumber), m_blockLimit(_blockLimit)
+        bcos::protocol::BlockNumber _blockNumber, int64_t _blockLimit,
+        size_t _filterSize = DEFAULT_NONCE_FILTER_SIZE)
+      : TxPoolNonceChecker(_filterSize),
+        m_blockNumber(_blockNumber),
+        m_blockLimit(_blockLimit),
+        m_blockNonceCache(std::max(_blockLimit, int64_t(0)) + 1)
     {
         if (_initialNonces)
         {
@@ -49,14 +53,26 @@ protected:
     void initNonceCache(std::shared_ptr<std::map<int64_t, bcos::protocol::NonceListPtr> > _initialNonces);
 
 private:
+    struct BlockNonces
+    {
+        bcos::protocol::BlockNumber number = -1;
+        bcos::protocol::NonceListPtr nonces;
+    };
+    BlockNonces& blockNonces(bcos::protocol::BlockNumber _batchId)
+    {
+        return m_blockNonceCache[_batchId % m_blockNonceCache.size()];
+    }
+    // return false if the slot is taken by a newer block
+    bool cacheBlockNonces(
+        bcos::protocol::BlockNumber _batchId, bcos::protocol::NonceListPtr const& _nonceList);
+
     std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {0};
     int64_t m_blockLimit;
 
     /// cache the block nonce to in case of accessing the DB to get nonces of given block frequently
-    /// key: block number
-    /// value: all the nonces of a given block
-    /// we cache at most m_blockLimit entries(occupy about 32KB)
-    std::map<int64_t, bcos::protocol::NonceListPtr> m_blockNonceCache;
+    /// a ring of m_blockLimit + 1 epochs indexed by the block number, so caching a block and
+    /// finding the expired one are O(1)
+    std::vector<BlockNonces> m_blockNonceCache;
     mutable SharedMutex x_blockNonceCache;
 };
 }  // namespace bcos::txpool
\ No newline at end of file
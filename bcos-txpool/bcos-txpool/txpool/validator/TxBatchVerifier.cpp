@@ -0,0 +1,153 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief verify the signatures of the incoming transactions in parallel micro-batches
+ * @file TxBatchVerifier.cpp
+ */
+#include "TxBatchVerifier.h"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+TxBatchVerifier::TxBatchVerifier(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, size_t _concurrency,
+    bcos::ThreadPool::Ptr _worker, size_t _maxBatchSize)
+  : m_cryptoSuite(std::move(_cryptoSuite)),
+    m_worker(std::move(_worker)),
+    m_maxBatchSize(std::max(_maxBatchSize, size_t(1))),
+    m_arena(_concurrency == 0 ? tbb::task_arena::automatic : static_cast<int>(_concurrency))
+{
+    TXPOOL_LOG(INFO) << LOG_DESC("create TxBatchVerifier") << LOG_KV("concurrency", _concurrency)
+                     << LOG_KV("maxBatchSize", m_maxBatchSize);
+}
+
+TxBatchVerifier::~TxBatchVerifier()
+{
+    m_arena.execute([this]() { m_group.wait(); });
+}
+
+void TxBatchVerifier::verifyTx(Transaction const& _tx) const
+{
+    if (_tx.invalid())
+    {
+        return;
+    }
+    try
+    {
+        _tx.verify(*m_cryptoSuite->hashImpl(), *m_cryptoSuite->signatureImpl());
+    }
+    catch (std::exception const& e)
+    {
+        _tx.setInvalid(true);
+        TXPOOL_LOG(DEBUG) << LOG_DESC("verify sender for tx failed")
+                          << LOG_KV("reason", boost::diagnostic_information(e))
+                          << LOG_KV("hash", _tx.hash().abridged());
+    }
+}
+
+void TxBatchVerifier::notifyVerified(std::function<void()> const& _onVerified)
+{
+    try
+    {
+        _onVerified();
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("TxBatchVerifier: onVerified exception")
+                            << LOG_KV("message", boost::diagnostic_information(e));
+    }
+}
+
+void TxBatchVerifier::verify(Transaction::ConstPtr _tx, std::function<void()> _onVerified)
+{
+    m_pendingTxs.push(PendingTx{std::move(_tx), std::move(_onVerified)});
+    if (m_draining.exchange(true))
+    {
+        // the running drain takes the tx with the next batch
+        return;
+    }
+    m_arena.execute([this]() { m_group.run([this]() { drain(); }); });
+}
+
+void TxBatchVerifier::drain()
+{
+    std::vector<PendingTx> batch;
+    batch.reserve(m_maxBatchSize);
+    while (true)
+    {
+        batch.clear();
+        PendingTx pendingTx;
+        while (batch.size() < m_maxBatchSize && m_pendingTxs.try_pop(pendingTx))
+        {
+            batch.emplace_back(std::move(pendingTx));
+        }
+        if (batch.empty())
+        {
+            m_draining = false;
+            // a tx pushed after the last try_pop but before m_draining was reset would be left
+            // behind, take the drain back in that case
+            if (m_pendingTxs.empty() || m_draining.exchange(true))
+            {
+                return;
+            }
+            continue;
+        }
+
+        auto startT = utcTime();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size()),
+            [this, &batch](tbb::blocked_range<size_t> const& range) {
+                for (auto i = range.begin(); i < range.end(); ++i)
+                {
+                    verifyTx(*batch[i].tx);
+                }
+            });
+        auto verifyT = utcTime() - startT;
+        for (auto& verifiedTx : batch)
+        {
+            if (m_worker)
+            {
+                m_worker->enqueue([onVerified = std::move(verifiedTx.onVerified)]() {
+                    notifyVerified(onVerified);
+                });
+            }
+            else
+            {
+                notifyVerified(verifiedTx.onVerified);
+            }
+        }
+        TXPOOL_LOG(TRACE) << LOG_DESC("TxBatchVerifier: verify batch")
+                          << LOG_KV("size", batch.size()) << LOG_KV("verifyT", verifyT)
+                          << LOG_KV("timecost", utcTime() - startT);
+    }
+}
+
+void TxBatchVerifier::batchVerify(Transactions const& _txs)
+{
+    m_arena.execute([this, &_txs]() {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _txs.size()),
+            [this, &_txs](tbb::blocked_range<size_t> const& range) {
+                for (auto i = range.begin(); i < range.end(); ++i)
+                {
+                    if (_txs[i])
+                    {
+                        verifyTx(*_txs[i]);
+                    }
+                }
+            });
+    });
+}
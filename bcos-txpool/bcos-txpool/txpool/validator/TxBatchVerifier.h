@@ -0,0 +1,77 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief verify the signatures of the incoming transactions in parallel micro-batches
+ * @file TxBatchVerifier.h
+ */
+#pragma once
+#include "bcos-txpool/txpool/utilities/Common.h"
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-framework/protocol/Transaction.h>
+#include <bcos-framework/txpool/TxPoolTypeDef.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <tbb/concurrent_queue.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <atomic>
+#include <functional>
+
+namespace bcos::txpool
+{
+// The submissions arriving while a batch is being verified are queued and verified together as the
+// next batch, so the signature recovery runs on all the cores of the arena instead of on the
+// threads delivering the transactions. Only the signatures are checked in the arena, the rest of
+// the submission goes on in the worker
+class TxBatchVerifier
+{
+public:
+    using Ptr = std::shared_ptr<TxBatchVerifier>;
+    TxBatchVerifier(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, size_t _concurrency,
+        bcos::ThreadPool::Ptr _worker = nullptr, size_t _maxBatchSize = DEFAULT_VERIFY_BATCH_SIZE);
+    TxBatchVerifier(const TxBatchVerifier&) = delete;
+    TxBatchVerifier(TxBatchVerifier&&) = delete;
+    TxBatchVerifier& operator=(const TxBatchVerifier&) = delete;
+    TxBatchVerifier& operator=(TxBatchVerifier&&) = delete;
+    virtual ~TxBatchVerifier();
+
+    // Verify the signature of the tx with the next batch, _onVerified is posted to the worker
+    // afterwards (called on the arena without worker), the tx is marked invalid if the
+    // verification failed
+    virtual void verify(
+        bcos::protocol::Transaction::ConstPtr _tx, std::function<void()> _onVerified);
+    // Verify the signatures of the txs in parallel and wait for the result, the txs failed are
+    // marked invalid
+    virtual void batchVerify(bcos::protocol::Transactions const& _txs);
+
+private:
+    struct PendingTx
+    {
+        bcos::protocol::Transaction::ConstPtr tx;
+        std::function<void()> onVerified;
+    };
+
+    void verifyTx(bcos::protocol::Transaction const& _tx) const;
+    static void notifyVerified(std::function<void()> const& _onVerified);
+    void drain();
+
+    bcos::crypto::CryptoSuite::Ptr m_cryptoSuite;
+    bcos::ThreadPool::Ptr m_worker;
+    size_t m_maxBatchSize;
+    tbb::concurrent_queue<PendingTx> m_pendingTxs;
+    std::atomic_bool m_draining = {false};
+    tbb::task_arena m_arena;
+    tbb::task_group m_group;
+};
+}  // namespace bcos::txpool
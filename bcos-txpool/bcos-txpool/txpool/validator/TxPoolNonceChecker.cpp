@@ -27,6 +27,10 @@ using namespace bcos::txpool;
 
 bool TxPoolNonceChecker::exists(NonceType const& _nonce)
 {
+    if (m_filter && !m_filter->mayContain(_nonce))
+    {
+        return false;
+    }
     return m_nonces.contains(_nonce);
 }
 
@@ -34,15 +38,14 @@ TransactionStatus TxPoolNonceChecker::checkNonce(Transaction::ConstPtr _tx, bool
 {
     auto nonce = _tx->nonce();
 
-    if (m_nonces.contains(nonce))
+    if (exists(nonce))
     {
         return TransactionStatus::NonceCheckFail;
     }
 
     if (_shouldUpdate)
     {
-        NonceSet::WriteAccessor::Ptr accessor;
-        m_nonces.insert(accessor, std::move(nonce));
+        insert(nonce);
     }
     return TransactionStatus::None;
 }
@@ -50,22 +53,52 @@ TransactionStatus TxPoolNonceChecker::checkNonce(Transaction::ConstPtr _tx, bool
 void TxPoolNonceChecker::insert(NonceType const& _nonce)
 {
     NonceSet::WriteAccessor::Ptr accessor;
-    m_nonces.insert(accessor, _nonce);
+    if (m_nonces.insert(accessor, _nonce) && m_filter)
+    {
+        m_filter->insert(_nonce);
+    }
 }
 
 void TxPoolNonceChecker::batchInsert(BlockNumber /*_batchId*/, NonceListPtr const& _nonceList)
 {
-    m_nonces.batchInsert(*_nonceList);
+    if (!m_filter)
+    {
+        m_nonces.batchInsert(*_nonceList);
+        return;
+    }
+    m_nonces.batchInsert(*_nonceList,
+        [this](bool success, NonceType const& nonce, NonceSet::WriteAccessor::Ptr const&) {
+            if (success)
+            {
+                m_filter->insert(nonce);
+            }
+        });
 }
 
 void TxPoolNonceChecker::remove(NonceType const& _nonce)
 {
-    m_nonces.remove(_nonce);
+    if (!m_filter)
+    {
+        m_nonces.remove(_nonce);
+        return;
+    }
+    batchRemove(NonceList{_nonce});
 }
 
 void TxPoolNonceChecker::batchRemove(NonceList const& _nonceList)
 {
-    m_nonces.batchRemove(_nonceList);
+    if (!m_filter)
+    {
+        m_nonces.batchRemove(_nonceList);
+        return;
+    }
+    m_nonces.batchRemove(
+        _nonceList, [this](bool success, NonceType const& nonce, EmptyType const&) {
+            if (success)
+            {
+                m_filter->remove(nonce);
+            }
+        });
 }
 
 void TxPoolNonceChecker::batchRemove(tbb::concurrent_unordered_set<bcos::protocol::NonceType,
@@ -75,4 +108,4 @@ void TxPoolNonceChecker::batchRemove(tbb::concurrent_unordered_set<bcos::protoco
     {
         remove(nonce);
     }
-}
\ No newline at end of file
+}
@@ -20,6 +20,8 @@
  */
 #pragma once
 #include "bcos-txpool/txpool/interfaces/NonceCheckerInterface.h"
+#include "bcos-txpool/txpool/utilities/Common.h"
+#include "bcos-txpool/txpool/utilities/NonceFilter.h"
 #include <bcos-utilities/BucketMap.h>
 #include <tbb/concurrent_hash_map.h>
 #include <variant>
@@ -29,7 +31,10 @@ namespace bcos::txpool
 class TxPoolNonceChecker : public NonceCheckerInterface
 {
 public:
-    TxPoolNonceChecker() : m_nonces(256){};
+    // _filterSize is the number of counters of the prefilter, 0 to check the nonce set directly
+    explicit TxPoolNonceChecker(size_t _filterSize = DEFAULT_NONCE_FILTER_SIZE)
+      : m_nonces(256),
+        m_filter(_filterSize > 0 ? std::make_unique<NonceFilter>(_filterSize) : nullptr){};
     bcos::protocol::TransactionStatus checkNonce(
         bcos::protocol::Transaction::ConstPtr _tx, bool _shouldUpdate = false) override;
     void batchInsert(bcos::protocol::BlockNumber _batchId,
@@ -47,6 +52,8 @@ protected:
     using NonceSet =
         bcos::BucketSet<bcos::protocol::NonceType, std::hash<bcos::protocol::NonceType>>;
     NonceSet m_nonces;
+    // skip the lookup of m_nonces for the nonces definitely absent
+    std::unique_ptr<NonceFilter> m_filter;
     // tbb::concurrent_hash_map<bcos::protocol::NonceType, std::monostate> m_nonces;
 };
 }  // namespace bcos::txpool
\ No newline at end of file
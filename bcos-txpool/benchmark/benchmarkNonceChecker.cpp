@@ -0,0 +1,92 @@
+#include "bcos-txpool/txpool/validator/LedgerNonceChecker.h"
+#include "bcos-txpool/txpool/validator/TxPoolNonceChecker.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <map>
+#include <string>
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+// 50k tx/s with 10 blocks each second, and the nonces of the last BLOCK_LIMIT blocks on chain
+constexpr static int64_t BLOCK_LIMIT = 600;
+constexpr static int64_t BLOCK_TXS = 5000;
+
+std::atomic_int64_t nonceSequence = 0;
+
+NonceType nextNonce()
+{
+    return std::to_string(nonceSequence++) + "-benchmark-nonce";
+}
+
+NonceListPtr makeNonceList(int64_t count)
+{
+    auto nonceList = std::make_shared<NonceList>();
+    nonceList->reserve(count);
+    for (int64_t i = 0; i < count; ++i)
+    {
+        nonceList->emplace_back(nextNonce());
+    }
+    return nonceList;
+}
+
+struct Checkers
+{
+    explicit Checkers(size_t filterSize)
+      : txpoolNonceChecker(std::make_shared<TxPoolNonceChecker>(filterSize))
+    {
+        auto initialNonces = std::make_shared<std::map<int64_t, NonceListPtr>>();
+        for (int64_t number = 1; number <= BLOCK_LIMIT; ++number)
+        {
+            initialNonces->emplace(number, makeNonceList(BLOCK_TXS));
+        }
+        ledgerNonceChecker = std::make_shared<LedgerNonceChecker>(
+            initialNonces, BLOCK_LIMIT, BLOCK_LIMIT, filterSize);
+    }
+
+    std::shared_ptr<TxPoolNonceChecker> txpoolNonceChecker;
+    std::shared_ptr<LedgerNonceChecker> ledgerNonceChecker;
+    BlockNumber blockNumber = BLOCK_LIMIT;
+};
+
+Checkers& checkers(bool withFilter)
+{
+    static Checkers withoutFilterCheckers(0);
+    static Checkers withFilterCheckers(DEFAULT_NONCE_FILTER_SIZE);
+    return withFilter ? withFilterCheckers : withoutFilterCheckers;
+}
+
+// The path of each submitted tx: a new nonce checked against the chain and the pool, then
+// inserted into the pool
+static void submitNewNonce(benchmark::State& state)
+{
+    auto& fixture = checkers(state.range(0) != 0);
+    for (auto const& it : state)
+    {
+        auto nonce = nextNonce();
+        benchmark::DoNotOptimize(fixture.ledgerNonceChecker->exists(nonce));
+        benchmark::DoNotOptimize(fixture.txpoolNonceChecker->exists(nonce));
+        fixture.txpoolNonceChecker->insert(nonce);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Commit a block: the nonces move from the pool to the chain and the oldest block expires
+static void commitBlock(benchmark::State& state)
+{
+    auto& fixture = checkers(state.range(0) != 0);
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        auto nonceList = makeNonceList(BLOCK_TXS);
+        state.ResumeTiming();
+
+        fixture.ledgerNonceChecker->batchInsert(++fixture.blockNumber, nonceList);
+        fixture.txpoolNonceChecker->batchRemove(*nonceList);
+    }
+    state.SetItemsProcessed(state.iterations() * BLOCK_TXS);
+}
+
+BENCHMARK(submitNewNonce)->Arg(0)->Arg(1)->Threads(1)->Threads(8)->UseRealTime();
+BENCHMARK(commitBlock)->Arg(0)->Arg(1);
@@ -0,0 +1,69 @@
+#include "bcos-txpool/txpool/utilities/NonceFilter.h"
+#include "bcos-txpool/txpool/validator/LedgerNonceChecker.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(TestNonceChecker, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(nonceFilter)
+{
+    NonceFilter filter(1024);
+    BOOST_CHECK(!filter.mayContain("nonce1"));
+    filter.insert("nonce1");
+    filter.insert("nonce2");
+    BOOST_CHECK(filter.mayContain("nonce1"));
+    BOOST_CHECK(filter.mayContain("nonce2"));
+
+    filter.remove("nonce1");
+    BOOST_CHECK(!filter.mayContain("nonce1"));
+    BOOST_CHECK(filter.mayContain("nonce2"));
+    filter.remove("nonce2");
+    BOOST_CHECK(!filter.mayContain("nonce2"));
+}
+
+BOOST_AUTO_TEST_CASE(ledgerNonceExpiry)
+{
+    int64_t blockLimit = 3;
+    auto initialNonces = std::make_shared<std::map<int64_t, NonceListPtr>>();
+    for (int64_t number = 1; number <= blockLimit; ++number)
+    {
+        initialNonces->emplace(
+            number, std::make_shared<NonceList>(NonceList{"nonce" + std::to_string(number)}));
+    }
+    LedgerNonceChecker checker(initialNonces, blockLimit, blockLimit, 1024);
+    for (int64_t number = 1; number <= blockLimit; ++number)
+    {
+        BOOST_CHECK(checker.exists("nonce" + std::to_string(number)));
+    }
+
+    // block 4 expires the nonces of block 1
+    checker.batchInsert(4, std::make_shared<NonceList>(NonceList{"nonce4"}));
+    BOOST_CHECK(!checker.exists("nonce1"));
+    BOOST_CHECK(checker.exists("nonce2"));
+    BOOST_CHECK(checker.exists("nonce4"));
+
+    // skip to block 8, the stale blocks are evicted when their epochs are taken
+    checker.batchInsert(8, std::make_shared<NonceList>(NonceList{"nonce8"}));
+    BOOST_CHECK(!checker.exists("nonce4"));
+    BOOST_CHECK(checker.exists("nonce8"));
+    checker.batchInsert(9, std::make_shared<NonceList>(NonceList{"nonce9"}));
+    checker.batchInsert(10, std::make_shared<NonceList>(NonceList{"nonce10"}));
+    checker.batchInsert(11, std::make_shared<NonceList>(NonceList{"nonce11"}));
+    BOOST_CHECK(!checker.exists("nonce2"));
+    BOOST_CHECK(!checker.exists("nonce3"));
+    BOOST_CHECK(checker.exists("nonce9"));
+    BOOST_CHECK(checker.exists("nonce11"));
+
+    // the epoch of block 7 is taken by block 11, its nonces are not kept
+    checker.batchInsert(7, std::make_shared<NonceList>(NonceList{"nonce7"}));
+    BOOST_CHECK(!checker.exists("nonce7"));
+    BOOST_CHECK(checker.exists("nonce11"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -0,0 +1,79 @@
+#include "bcos-framework/bcos-framework/testutils/faker/FakeTransaction.h"
+#include "bcos-txpool/txpool/utilities/SealingQueue.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(TestSealingQueue, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(sealingOrder)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+
+    // the txs are ordered by import time, the txs with the same import time keep the push order
+    std::vector<Transaction::Ptr> transactions;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        auto transaction = fakeTransaction(cryptoSuite, std::to_string(utcTime() + 1000 + i));
+        transaction->setImportTime(1000 + static_cast<int64_t>(i / 2));
+        transactions.push_back(transaction);
+    }
+
+    SealingQueue queue;
+    for (auto const& transaction : transactions | RANGES::views::reverse)
+    {
+        BOOST_CHECK(queue.push(transaction));
+    }
+    BOOST_CHECK(!queue.push(transactions[0]));
+    BOOST_CHECK_EQUAL(queue.size(), transactions.size());
+
+    std::vector<HashType> expected{transactions[1]->hash(), transactions[0]->hash(),
+        transactions[3]->hash(), transactions[2]->hash(), transactions[5]->hash(),
+        transactions[4]->hash()};
+    std::vector<HashType> traversed;
+    queue.traverse([&](Transaction::Ptr const& transaction) {
+        traversed.push_back(transaction->hash());
+        return std::make_tuple(SealingQueue::Action::KEEP, true);
+    });
+    BOOST_CHECK(traversed == expected);
+
+    // remove the first two txs and stop at the third one
+    traversed.clear();
+    queue.traverse([&](Transaction::Ptr const& transaction) {
+        traversed.push_back(transaction->hash());
+        return std::make_tuple(traversed.size() <= 2 ? SealingQueue::Action::REMOVE :
+                                                       SealingQueue::Action::KEEP,
+            traversed.size() < 3);
+    });
+    BOOST_CHECK_EQUAL(traversed.size(), 3);
+    BOOST_CHECK_EQUAL(queue.size(), 4);
+
+    BOOST_CHECK(queue.erase(transactions[3]->hash()));
+    BOOST_CHECK(!queue.erase(transactions[3]->hash()));
+    queue.batchErase(std::vector<HashType>{transactions[5]->hash(), transactions[1]->hash()});
+    BOOST_CHECK_EQUAL(queue.size(), 2);
+
+    traversed.clear();
+    queue.traverse([&](Transaction::Ptr const& transaction) {
+        traversed.push_back(transaction->hash());
+        return std::make_tuple(SealingQueue::Action::KEEP, true);
+    });
+    BOOST_CHECK(
+        traversed == (std::vector<HashType>{transactions[2]->hash(), transactions[4]->hash()}));
+
+    queue.clear();
+    BOOST_CHECK_EQUAL(queue.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
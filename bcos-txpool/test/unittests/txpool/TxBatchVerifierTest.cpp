@@ -0,0 +1,69 @@
+#include "bcos-framework/bcos-framework/testutils/faker/FakeTransaction.h"
+#include "bcos-txpool/txpool/validator/TxBatchVerifier.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(TestTxBatchVerifier, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(verifyInBatches)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+
+    size_t txsNum = 50;
+    Transactions transactions;
+    for (size_t i = 0; i < txsNum; ++i)
+    {
+        auto transaction = fakeTransaction(
+            cryptoSuite, std::to_string(utcTime() + 1000 + i), 1000, "chainId", "groupId");
+        BOOST_CHECK(!transaction->sender().empty());
+        // clear the sender to recover it from the signature again
+        transaction->forceSender(bytes());
+        transactions.push_back(transaction);
+    }
+
+    // small batches to make the submissions queue up
+    TxBatchVerifier verifier(cryptoSuite, 4, nullptr, 8);
+    std::atomic_size_t verified = 0;
+    std::promise<void> finished;
+    for (auto const& transaction : transactions)
+    {
+        verifier.verify(transaction, [&]() {
+            if (++verified == txsNum)
+            {
+                finished.set_value();
+            }
+        });
+    }
+    finished.get_future().get();
+    for (auto const& transaction : transactions)
+    {
+        BOOST_CHECK(!transaction->sender().empty());
+        BOOST_CHECK(!transaction->invalid());
+    }
+
+    for (auto const& transaction : transactions)
+    {
+        transaction->forceSender(bytes());
+    }
+    verifier.batchVerify(transactions);
+    for (auto const& transaction : transactions)
+    {
+        BOOST_CHECK(!transaction->sender().empty());
+        BOOST_CHECK(!transaction->invalid());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
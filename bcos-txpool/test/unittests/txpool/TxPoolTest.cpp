@@ -29,9 +29,13 @@
 #include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 #include <exception>
+#include <future>
 using namespace bcos;
 using namespace bcos::txpool;
 using namespace bcos::protocol;
@@ -602,6 +606,249 @@ BOOST_AUTO_TEST_CASE(testSMTxPoolInitAndSubmitTransaction)
     txPoolInitAndSubmitTransactionTest(true, cryptoSuite);
 }
 
+BOOST_AUTO_TEST_CASE(verifyProposalWithHitTxs)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    int64_t blockLimit = 10;
+    auto faker = std::make_shared<TxPoolFixture>(signatureImpl->generateKeyPair()->publicKey(),
+        cryptoSuite, "group_test_for_txpool", "chain_test_for_txpool", blockLimit,
+        std::make_shared<FakeGateWay>());
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto txpool = faker->txpool();
+    auto txpoolStorage = txpool->txpoolStorage();
+    auto blockFactory = txpool->txpoolConfig()->blockFactory();
+
+    Transactions transactions;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto tx = fakeTransaction(cryptoSuite, std::to_string(utcTime() + 4000000 + i),
+            faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+        BOOST_CHECK_EQUAL(txpoolStorage->insert(tx), TransactionStatus::None);
+        transactions.push_back(tx);
+    }
+    auto createProposal = [&](BlockNumber _number) {
+        auto block = blockFactory->createBlock();
+        auto blockHeader = blockFactory->blockHeaderFactory()->createBlockHeader();
+        blockHeader->setNumber(_number);
+        block->setBlockHeader(blockHeader);
+        for (auto const& tx : transactions)
+        {
+            auto txMetaData = blockFactory->createTransactionMetaData();
+            txMetaData->setHash(tx->hash());
+            txMetaData->setTo(std::string(tx->to()));
+            block->appendTransactionMetaData(txMetaData);
+        }
+        blockHeader->calculateHash(*hashImpl);
+        return block;
+    };
+
+    // the txs hit are handed back by their index, the missed ones are left null
+    auto block = createProposal(faker->ledger()->blockNumber() + 1);
+    auto missedHash = hashImpl->hash(std::string("missed"));
+    auto txMetaData = blockFactory->createTransactionMetaData();
+    txMetaData->setHash(missedHash);
+    block->appendTransactionMetaData(txMetaData);
+    auto hitTxs = std::make_shared<Transactions>();
+    auto missedTxs = txpoolStorage->batchVerifyProposal(block, hitTxs);
+    BOOST_REQUIRE(missedTxs);
+    BOOST_REQUIRE_EQUAL(missedTxs->size(), 1);
+    BOOST_CHECK_EQUAL((*missedTxs)[0], missedHash);
+    BOOST_REQUIRE_EQUAL(hitTxs->size(), transactions.size() + 1);
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL((*hitTxs)[i].get(), transactions[i].get());
+    }
+    BOOST_CHECK(!hitTxs->back());
+
+    // a miss still fails the verification, and nothing is stored
+    auto verify = [&](Block::Ptr const& _block) {
+        bytes blockData;
+        _block->encode(blockData);
+        std::promise<std::tuple<Error::Ptr, bool>> promise;
+        txpool->asyncVerifyBlock(
+            faker->nodeID(), ref(blockData), [&promise](Error::Ptr _error, bool _result) {
+                promise.set_value({std::move(_error), _result});
+            });
+        return promise.get_future().get();
+    };
+    auto [error, result] = verify(block);
+    BOOST_REQUIRE(error);
+    BOOST_CHECK(error->errorCode() == CommonError::TransactionsMissing);
+    BOOST_CHECK(!result);
+
+    // the txs hit when verifying are the ones stored for the proposal
+    block = createProposal(faker->ledger()->blockNumber() + 2);
+    std::tie(error, result) = verify(block);
+    BOOST_CHECK(!error);
+    BOOST_CHECK(result);
+    auto startT = utcTime();
+    TransactionsPtr storedTxs;
+    while (!(storedTxs = faker->ledger()->preStoredTxs(block->blockHeader()->number())) &&
+           utcTime() - startT <= 5000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_REQUIRE(storedTxs);
+    BOOST_REQUIRE_EQUAL(storedTxs->size(), transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL((*storedTxs)[i].get(), transactions[i].get());
+    }
+    BOOST_CHECK(!faker->ledger()->preStoredTxs(faker->ledger()->blockNumber() + 1));
+
+    txpoolStorage->clear();
+}
+
+BOOST_AUTO_TEST_CASE(spillAndRehydrate)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    int64_t blockLimit = 10;
+    auto faker = std::make_shared<TxPoolFixture>(signatureImpl->generateKeyPair()->publicKey(),
+        cryptoSuite, "group_test_for_txpool", "chain_test_for_txpool", blockLimit,
+        std::make_shared<FakeGateWay>());
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+
+    auto txpoolConfig = faker->txpool()->txpoolConfig();
+    auto txpoolStorage = std::dynamic_pointer_cast<MemoryStorage>(faker->txpool()->txpoolStorage());
+    auto path = (boost::filesystem::temp_directory_path() / "txpool_memory_spill_test").string();
+    auto spillStore = std::make_shared<TxSpillStore>(path, 10, txpoolConfig->txFactory());
+    txpoolStorage->setSpillStore(spillStore);
+    txpoolConfig->setPoolLimit(1);
+
+    // the first tx goes into the pool, the others are spilled
+    Transactions transactions;
+    std::vector<Error::Ptr> errors(4);
+    for (size_t i = 0; i < errors.size(); ++i)
+    {
+        auto tx = fakeTransaction(cryptoSuite, std::to_string(utcTime() + 3000000 + i),
+            faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+        auto result = txpoolStorage->verifyAndSubmitTransaction(
+            tx,
+            [&errors, i](Error::Ptr error, TransactionSubmitResult::Ptr) {
+                errors[i] = std::move(error);
+            },
+            true, true);
+        BOOST_CHECK_EQUAL(result, TransactionStatus::None);
+        transactions.push_back(tx);
+    }
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 4);
+    BOOST_CHECK_EQUAL(spillStore->size(), 3);
+    BOOST_CHECK(txpoolStorage->exist(transactions[3]->hash()));
+
+    // the spilled tx asked by a proposal is moved back into the pool
+    HashList missedTxs;
+    auto fetchedTxs = txpoolStorage->fetchTxs(missedTxs, HashList{transactions[2]->hash()});
+    BOOST_REQUIRE_EQUAL(fetchedTxs->size(), 1);
+    BOOST_CHECK_EQUAL((*fetchedTxs)[0]->hash(), transactions[2]->hash());
+    BOOST_CHECK(missedTxs.empty());
+    BOOST_CHECK_EQUAL(spillStore->size(), 2);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 4);
+
+    // the spilled txs missed by a proposal are read back, the unknown ones are left missed
+    auto unknownHash = hashImpl->hash(std::string("unknown"));
+    HashList proposalMissedTxs{transactions[1]->hash(), unknownHash};
+    txpoolStorage->rehydrateTxs(proposalMissedTxs);
+    BOOST_REQUIRE_EQUAL(proposalMissedTxs.size(), 1);
+    BOOST_CHECK_EQUAL(proposalMissedTxs[0], unknownHash);
+    BOOST_CHECK_EQUAL(spillStore->size(), 1);
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), 4);
+
+    // the spilled tx can't be read back is rejected, and its nonce can be submitted again
+    auto nonceChecker = txpoolConfig->txPoolNonceChecker();
+    BOOST_CHECK(nonceChecker->exists(transactions[3]->nonce()));
+    boost::filesystem::resize_file(path, 0);
+    fetchedTxs = txpoolStorage->fetchTxs(missedTxs, HashList{transactions[3]->hash()});
+    BOOST_CHECK(fetchedTxs->empty());
+    BOOST_REQUIRE_EQUAL(missedTxs.size(), 1);
+    BOOST_CHECK_EQUAL(missedTxs[0], transactions[3]->hash());
+    BOOST_REQUIRE(errors[3]);
+    BOOST_CHECK_EQUAL(errors[3]->errorCode(), (int32_t)TransactionStatus::Malformed);
+    BOOST_CHECK(!nonceChecker->exists(transactions[3]->nonce()));
+    BOOST_CHECK(!txpoolStorage->exist(transactions[3]->hash()));
+    BOOST_CHECK_EQUAL(spillStore->size(), 0);
+    BOOST_CHECK(!errors[1]);
+
+    txpoolStorage->clear();
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(batchVerifyWithInvalidSignature)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    int64_t blockLimit = 10;
+    auto faker = std::make_shared<TxPoolFixture>(signatureImpl->generateKeyPair()->publicKey(),
+        cryptoSuite, "group_test_for_txpool", "chain_test_for_txpool", blockLimit,
+        std::make_shared<FakeGateWay>());
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto txpool = faker->txpool();
+
+    Transactions transactions;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        transactions.push_back(fakeTransaction(cryptoSuite,
+            std::to_string(utcTime() + 4000000 + i),
+            faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId()));
+    }
+    // one tx submitted with the others carries a signature that can't be recovered
+    size_t invalidIndex = 7;
+    auto invalidTx =
+        std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(transactions[invalidIndex]);
+    bcos::bytes invalidSignature(65, 0);
+    invalidTx->setSignatureData(invalidSignature);
+    invalidTx->forceSender(bcos::bytes());
+
+    std::promise<int32_t> invalidStatus;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, transactions.size()), [&](auto const& range) {
+        for (auto i = range.begin(); i < range.end(); ++i)
+        {
+            task::wait([](decltype(txpool) txpool, Transaction::Ptr transaction,
+                           std::promise<int32_t>* status) -> task::Task<void> {
+                try
+                {
+                    // the valid txs are resumed once they are committed
+                    co_await txpool->submitTransaction(std::move(transaction));
+                }
+                catch (bcos::Error& e)
+                {
+                    BOOST_CHECK(status != nullptr);
+                    if (status != nullptr)
+                    {
+                        status->set_value(e.errorCode());
+                    }
+                }
+            }(txpool, transactions[i], i == invalidIndex ? &invalidStatus : nullptr));
+        }
+    });
+
+    BOOST_CHECK_EQUAL(
+        invalidStatus.get_future().get(), (int32_t)TransactionStatus::InvalidSignature);
+    auto txpoolStorage = txpool->txpoolStorage();
+    auto startT = utcTime();
+    while (txpoolStorage->size() < transactions.size() - 1 && (utcTime() - startT <= 10000))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_CHECK_EQUAL(txpoolStorage->size(), transactions.size() - 1);
+    BOOST_CHECK(!txpoolStorage->exist(transactions[invalidIndex]->hash()));
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        if (i != invalidIndex)
+        {
+            BOOST_CHECK(txpoolStorage->exist(transactions[i]->hash()));
+        }
+    }
+    txpoolStorage->clear();
+}
+
 BOOST_AUTO_TEST_CASE(fillWithSubmit)
 {
     // auto hashImpl = std::make_shared<SM3>();
@@ -0,0 +1,124 @@
+#include "bcos-framework/bcos-framework/testutils/faker/FakeTransaction.h"
+#include "bcos-txpool/txpool/storage/TxSpillStore.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(TestTxSpillStore, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(spillAndLoad)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto txFactory = std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite);
+
+    auto path = (boost::filesystem::temp_directory_path() / "txpool_spill_test").string();
+    // compact as soon as the dead records exceed the live ones
+    TxSpillStore spillStore(path, 8, txFactory, 0);
+
+    Transactions transactions;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto transaction = fakeTransaction(
+            cryptoSuite, std::to_string(utcTime() + 1000 + i), 1000, "chainId", "groupId");
+        transactions.push_back(transaction);
+    }
+    size_t notified = 0;
+    transactions[1]->setSubmitCallback([&](Error::Ptr, TransactionSubmitResult::Ptr) {
+        ++notified;
+    });
+    for (size_t i = 0; i < 8; ++i)
+    {
+        BOOST_CHECK(spillStore.spill(transactions[i]));
+    }
+    // full or duplicated
+    BOOST_CHECK(spillStore.full());
+    BOOST_CHECK(!spillStore.spill(transactions[8]));
+    BOOST_CHECK(!spillStore.spill(transactions[0]));
+    BOOST_CHECK_EQUAL(spillStore.size(), 8);
+    BOOST_CHECK(spillStore.contains(transactions[7]->hash()));
+    BOOST_CHECK(!spillStore.contains(transactions[8]->hash()));
+
+    // the sender and the callback are kept
+    TxSpillStore::DroppedTxs droppedTxs;
+    auto tx = spillStore.take(transactions[1]->hash(), droppedTxs);
+    BOOST_REQUIRE(tx);
+    BOOST_CHECK_EQUAL(tx->hash(), transactions[1]->hash());
+    BOOST_CHECK(tx->sender() == transactions[1]->sender());
+    BOOST_CHECK_EQUAL(tx->nonce(), transactions[1]->nonce());
+    BOOST_REQUIRE(tx->submitCallback());
+    tx->submitCallback()(nullptr, nullptr);
+    BOOST_CHECK_EQUAL(notified, 1);
+    BOOST_CHECK(!spillStore.take(transactions[1]->hash(), droppedTxs));
+
+    // loaded in submission order, the file is compacted in background
+    auto fileSize = spillStore.fileSize();
+    auto txs = spillStore.load(4, droppedTxs);
+    BOOST_REQUIRE_EQUAL(txs.size(), 4);
+    std::vector<size_t> expected = {0, 2, 3, 4};
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(txs[i]->hash(), transactions[expected[i]]->hash());
+    }
+    auto startT = utcTime();
+    while (spillStore.fileSize() >= fileSize && utcTime() - startT <= 5000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    BOOST_CHECK_LT(spillStore.fileSize(), fileSize);
+    BOOST_CHECK(spillStore.spill(transactions[8]));
+
+    txs = spillStore.load(10, droppedTxs);
+    BOOST_REQUIRE_EQUAL(txs.size(), 4);
+    BOOST_CHECK_EQUAL(txs[0]->hash(), transactions[5]->hash());
+    BOOST_CHECK_EQUAL(txs[3]->hash(), transactions[8]->hash());
+    BOOST_CHECK_EQUAL(spillStore.size(), 0);
+    BOOST_CHECK_EQUAL(spillStore.fileSize(), 0);
+    BOOST_CHECK(droppedTxs.empty());
+
+    // taken in one batch, aligned with the hashes
+    BOOST_CHECK(spillStore.spill(transactions[9]));
+    BOOST_CHECK(spillStore.spill(transactions[1]));
+    BOOST_CHECK(spillStore.spill(transactions[2]));
+    bcos::crypto::HashList txsHash = {transactions[2]->hash(), transactions[8]->hash(),
+        transactions[9]->hash(), transactions[1]->hash()};
+    txs = spillStore.take(txsHash, droppedTxs);
+    BOOST_REQUIRE_EQUAL(txs.size(), 4);
+    BOOST_CHECK(!txs[1]);
+    for (size_t i : {0, 2, 3})
+    {
+        BOOST_REQUIRE(txs[i]);
+        BOOST_CHECK_EQUAL(txs[i]->hash(), txsHash[i]);
+    }
+    BOOST_CHECK(txs[3]->submitCallback());
+    BOOST_CHECK_EQUAL(spillStore.size(), 0);
+    BOOST_CHECK(droppedTxs.empty());
+
+    // the records can't be read back are dropped with the nonces and the callbacks
+    BOOST_CHECK(spillStore.spill(transactions[9]));
+    BOOST_CHECK(spillStore.spill(transactions[1]));
+    boost::filesystem::resize_file(path, 0);
+    txs = spillStore.load(10, droppedTxs);
+    BOOST_CHECK(txs.empty());
+    BOOST_REQUIRE_EQUAL(droppedTxs.size(), 2);
+    BOOST_CHECK_EQUAL(droppedTxs[0].txHash, transactions[9]->hash());
+    BOOST_CHECK_EQUAL(droppedTxs[1].nonce, transactions[1]->nonce());
+    BOOST_CHECK(droppedTxs[1].callback);
+
+    spillStore.clear();
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -81,6 +81,10 @@ struct ITT_DOMAINS
     __itt_string_handle* SINGLE_PASS = __itt_string_handle_create("singlePass");
     __itt_string_handle* DETECT_RAW = __itt_string_handle_create("detectRAW");
     __itt_string_handle* EXECUTE_CHUNK = __itt_string_handle_create("executeChunk");
+    __itt_string_handle* REEXECUTE_CHUNK = __itt_string_handle_create("reexecuteChunk");
+    __itt_string_handle* PREDICT_CONFLICT = __itt_string_handle_create("predictConflict");
+    __itt_string_handle* EXECUTE_PREDICTED = __itt_string_handle_create("executePredicted");
+    __itt_string_handle* PREFETCH_CHUNK = __itt_string_handle_create("prefetchChunk");
     __itt_string_handle* MERGE_RWSET = __itt_string_handle_create("mergeRWSet");
     __itt_string_handle* MERGE_CHUNK = __itt_string_handle_create("mergeChunk");
     __itt_string_handle* MERGE_LAST_CHUNK = __itt_string_handle_create("mergeLastChunk");
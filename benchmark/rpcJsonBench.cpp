@@ -0,0 +1,119 @@
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h>
+#include <bcos-rpc/jsonrpc/JsonRpcInterface.h>
+#include <bcos-rpc/jsonrpc/JsonWriter.h>
+#include <bcos-tars-protocol/protocol/BlockFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
+#include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
+#include <json/writer.h>
+#include <sys/resource.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+
+// the block of the response of getBlockByNumber with the full transactions
+bcos::protocol::Block::Ptr generateBlock(int count, int inputSize)
+{
+    auto cryptoSuite = std::make_shared<bcos::crypto::CryptoSuite>(
+        std::make_shared<bcos::crypto::Keccak256>(),
+        std::make_shared<bcos::crypto::Secp256k1Crypto>(), nullptr);
+    auto blockHeaderFactory =
+        std::make_shared<bcostars::protocol::BlockHeaderFactoryImpl>(cryptoSuite);
+    auto transactionFactory =
+        std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite);
+    auto receiptFactory =
+        std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite);
+    bcostars::protocol::BlockFactoryImpl blockFactory(
+        cryptoSuite, blockHeaderFactory, transactionFactory, receiptFactory);
+
+    auto block = blockFactory.createBlock();
+    auto blockHeader = blockHeaderFactory->createBlockHeader(1);
+    blockHeader->setSealerList(std::vector<bcos::bytes>(4, bcos::bytes(64, 'a')));
+    blockHeader->setConsensusWeights(std::vector<uint64_t>(4, 1));
+    block->setBlockHeader(blockHeader);
+
+    auto keyPair = cryptoSuite->signatureImpl()->generateKeyPair();
+    bcos::bytes input(inputSize, 'i');
+    for (int i = 0; i < count; ++i)
+    {
+        block->appendTransaction(transactionFactory->createTransaction(0,
+            "0x0000000000000000000000000000000000001000", input, std::to_string(i), 500,
+            "chain0", "group0", 0, *keyPair));
+    }
+    return block;
+}
+
+long maxRSS()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// the Json::Value of the block serialized by jsoncpp, as the responses were written before
+bcos::bytes testDOM(bcos::protocol::Block& block)
+{
+    bcos::rpc::JsonResponse response;
+    response.jsonrpc = "2.0";
+    response.id = 1;
+    bcos::rpc::toJsonResp(response.result, block, false);
+    auto json = Json::writeString(
+        Json::StreamWriterBuilder(), bcos::rpc::toJsonResponse(std::move(response)));
+    return {json.begin(), json.end()};
+}
+
+bcos::bytes testStream(bcos::protocol::Block& block)
+{
+    bcos::rpc::JsonResponse response;
+    response.jsonrpc = "2.0";
+    response.id = 1;
+    return bcos::rpc::toStringResponse(response,
+        [&block](bcos::rpc::JsonWriter& writer) { bcos::rpc::toJsonStream(writer, block, false); });
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("RPC json response benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for Json::Value, 1 for stream")
+        ("count,c", boost::program_options::value<int>()->default_value(10000), "Count of the transactions of the block")
+        ("input,i", boost::program_options::value<int>()->default_value(256), "Input size of the transactions")
+        ("round,r", boost::program_options::value<int>()->default_value(10), "Rounds of writing the response")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    if (vm.empty())
+    {
+        options.print(std::cout);
+        return -1;
+    }
+
+    auto type = vm["type"].as<int>();
+    auto count = vm["count"].as<int>();
+    auto rounds = vm["round"].as<int>();
+    auto block = generateBlock(count, vm["input"].as<int>());
+
+    // the peak memory is of the process, run the types in separate processes to compare
+    auto baseRSS = maxRSS();
+    size_t responseSize = 0;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        auto response = type ? testStream(*block) : testDOM(*block);
+        responseSize = response.size();
+    }
+    auto duration = std::chrono::high_resolution_clock::now() - timePoint;
+
+    std::cout << (type ? "[stream]" : "[Json::Value]") << " transactions: " << count
+              << " response: " << responseSize << " bytes, " << rounds << " rounds "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() / rounds
+              << "ms/round, peak memory +" << (maxRSS() - baseRSS) / 1024 << "MB" << std::endl;
+}
@@ -69,7 +69,52 @@ public:
         m_multiLayerStorage(m_rocksDBStorage, m_cacheStorage),
         m_precompiledManager(m_blockFactory->cryptoSuite()->hashImpl()),
         m_transactionExecutor(*m_blockFactory->receiptFactory(), m_precompiledManager)
-    {}
+    {
+        m_multiLayerStorage.setEnableFilter(true);
+        m_multiLayerStorage.setEnableStatistic(true);
+    }
+
+    void setBackgroundMerge(bool backgroundMerge)
+    {
+        m_multiLayerStorage.setBackgroundMerge(backgroundMerge);
+    }
+
+    // Re-execute only the conflicting chunks instead of retrying all the following ones
+    void setConflictAware(bool conflictAware)
+    {
+        if constexpr (enableParallel)
+        {
+            m_scheduler.setConflictAware(conflictAware);
+        }
+    }
+    // Group the transactions of the precompileds by the conflict keys predicted from calldata
+    void setPredict(bool predict)
+    {
+        if constexpr (enableParallel)
+        {
+            m_scheduler.setPredict(predict);
+        }
+    }
+    // Read the predicted keys of each chunk into the cache in one batch before it executes
+    void setPrefetch(bool prefetch)
+    {
+        if constexpr (enableParallel)
+        {
+            m_scheduler.setPrefetch(prefetch);
+        }
+    }
+    // Tune the chunk size and the max token from the conflict rate of the recent blocks
+    void setAdaptive(bool adaptive)
+    {
+        if constexpr (enableParallel)
+        {
+            m_scheduler.setAdaptive(adaptive);
+        }
+    }
+    void setAnalysisPolicy(transaction_executor::AnalysisPolicy policy)
+    {
+        m_transactionExecutor.setAnalysisPolicy(policy);
+    }
 
     auto buildScheduler()
     {
@@ -265,7 +265,24 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         }
         std::visit(
             [&, this](auto& initializer) {
+                initializer->setBackgroundMerge(baselineSchedulerConfig.backgroundMerge);
+                initializer->setConflictAware(baselineSchedulerConfig.conflictAware);
+                initializer->setPredict(baselineSchedulerConfig.predict);
+                initializer->setPrefetch(baselineSchedulerConfig.prefetch);
+                initializer->setAdaptive(baselineSchedulerConfig.adaptive);
+                initializer->setAnalysisPolicy(transaction_executor::AnalysisPolicy{
+                    .interpreter =
+                        baselineSchedulerConfig.vmInterpreter == "baseline" ?
+                            transaction_executor::Interpreter::baseline :
+                        baselineSchedulerConfig.vmInterpreter == "advanced" ?
+                            transaction_executor::Interpreter::advanced :
+                            transaction_executor::Interpreter::adaptive,
+                    .maxCacheBytes = baselineSchedulerConfig.vmAnalysisCacheSize,
+                    .advancedCalls = baselineSchedulerConfig.vmAdvancedCalls,
+                    .maxAdvancedCodeSize = baselineSchedulerConfig.vmAdvancedMaxCodeSize});
                 auto scheduler = initializer->buildScheduler();
+                scheduler->setMaxInflightBlocks(baselineSchedulerConfig.maxInflightBlocks);
+                scheduler->setCallConcurrency(baselineSchedulerConfig.callConcurrency);
                 if constexpr (std::same_as<decltype(initializer),
                                   std::shared_ptr<transaction_scheduler::
                                           BaselineSchedulerInitializer<Hasher, true>>>)
@@ -446,6 +463,11 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         m_archiveService = std::make_shared<bcos::archive::ArchiveService>(
             storage, ledger, m_nodeConfig->archiveListenIP(), m_nodeConfig->archiveListenPort());
     }
+    if (m_nodeConfig->enableLogIndex())
+    {
+        INITIALIZER_LOG(INFO) << LOG_BADGE("create log indexer");
+        m_logIndexer = std::make_shared<bcos::ledger::LogIndexer>(ledger, storage);
+    }
 #ifdef WITH_LIGHTNODE
     bcos::storage::StorageImpl<bcos::storage::StorageInterface::Ptr> storageWrapper(storage);
 
@@ -483,12 +505,17 @@ void Initializer::initNotificationHandlers(bcos::rpc::RPCInterface::Ptr _rpc)
         auto schedulerFactory =
             dynamic_pointer_cast<scheduler::SchedulerManager>(m_scheduler)->getFactory();
         // notify blockNumber
-        schedulerFactory->setBlockNumberReceiver(
-            [_rpc, groupID, nodeName](bcos::protocol::BlockNumber number) {
-                INITIALIZER_LOG(DEBUG) << "Notify blocknumber: " << number;
-                // Note: the interface will notify blockNumber to all rpc nodes in pro/max mode
-                _rpc->asyncNotifyBlockNumber(groupID, nodeName, number, [](bcos::Error::Ptr) {});
-            });
+        schedulerFactory->setBlockNumberReceiver([_rpc, groupID, nodeName,
+                                                     logIndexer = m_logIndexer](
+                                                     bcos::protocol::BlockNumber number) {
+            INITIALIZER_LOG(DEBUG) << "Notify blocknumber: " << number;
+            // Note: the interface will notify blockNumber to all rpc nodes in pro/max mode
+            _rpc->asyncNotifyBlockNumber(groupID, nodeName, number, [](bcos::Error::Ptr) {});
+            if (logIndexer)
+            {
+                logIndexer->notifyBlockNumber(number);
+            }
+        });
         // notify transactions
         schedulerFactory->setTransactionNotifier(
             [txpool = m_txpoolInitializer->txpool()](bcos::protocol::BlockNumber _blockNumber,
@@ -501,12 +528,17 @@ void Initializer::initNotificationHandlers(bcos::rpc::RPCInterface::Ptr _rpc)
     }
     else
     {
-        m_setBaselineSchedulerBlockNumberNotifier(
-            [_rpc, groupID, nodeName](bcos::protocol::BlockNumber number) {
-                INITIALIZER_LOG(DEBUG) << "Notify blocknumber: " << number;
-                // Note: the interface will notify blockNumber to all rpc nodes in pro/max mode
-                _rpc->asyncNotifyBlockNumber(groupID, nodeName, number, [](bcos::Error::Ptr) {});
-            });
+        m_setBaselineSchedulerBlockNumberNotifier([_rpc, groupID, nodeName,
+                                                      logIndexer = m_logIndexer](
+                                                      bcos::protocol::BlockNumber number) {
+            INITIALIZER_LOG(DEBUG) << "Notify blocknumber: " << number;
+            // Note: the interface will notify blockNumber to all rpc nodes in pro/max mode
+            _rpc->asyncNotifyBlockNumber(groupID, nodeName, number, [](bcos::Error::Ptr) {});
+            if (logIndexer)
+            {
+                logIndexer->notifyBlockNumber(number);
+            }
+        });
     }
 
     m_pbftInitializer->initNotificationHandlers(_rpc);
@@ -620,6 +652,10 @@ void Initializer::start()
     {
         m_archiveService->start();
     }
+    if (m_logIndexer)
+    {
+        m_logIndexer->start();
+    }
 }
 
 void Initializer::stop()
@@ -646,6 +682,10 @@ void Initializer::stop()
         {
             m_archiveService->stop();
         }
+        if (m_logIndexer)
+        {
+            m_logIndexer->stop();
+        }
     }
     catch (std::exception const& e)
     {
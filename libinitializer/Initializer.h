@@ -26,6 +26,7 @@
 #include "ProtocolInitializer.h"
 #include "TxPoolInitializer.h"
 #include "tools/archive-tool/ArchiveService.h"
+#include <bcos-ledger/src/libledger/LogIndexer.h>
 #include <bcos-executor/src/executor/SwitchExecutorManager.h>
 #include <bcos-scheduler/src/SchedulerManager.h>
 #include <bcos-utilities/BoostLogInitializer.h>
@@ -102,6 +103,7 @@ private:
     std::string const c_consensusStorageDBName = "consensus_log";
     std::string const c_fileSeparator = "/";
     std::shared_ptr<bcos::archive::ArchiveService> m_archiveService = nullptr;
+    bcos::ledger::LogIndexer::Ptr m_logIndexer = nullptr;
 
     std::function<void()> m_baselineSchedulerInitializerHolder;
     std::function<void(std::function<void(protocol::BlockNumber)>)>
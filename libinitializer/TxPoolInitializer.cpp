@@ -45,8 +45,14 @@ TxPoolInitializer::TxPoolInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
         m_frontService, m_ledger, m_nodeConfig->groupId(), m_nodeConfig->chainId(),
         m_nodeConfig->blockLimit(), m_nodeConfig->txpoolLimit());
 
+    auto spillPath = m_nodeConfig->txpoolSpillPath();
+    if (spillPath.empty())
+    {
+        spillPath = m_nodeConfig->storagePath() + "/txpool_spill";
+    }
     m_txpool = txpoolFactory->createTxPool(m_nodeConfig->notifyWorkerNum(),
-        m_nodeConfig->verifierWorkerNum(), m_nodeConfig->txsExpirationTime());
+        m_nodeConfig->verifierWorkerNum(), m_nodeConfig->txsExpirationTime(), spillPath,
+        m_nodeConfig->txpoolSpillLimit());
 
     if (m_nodeConfig->enableSendTxByTree())
     {
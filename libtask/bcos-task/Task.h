@@ -4,8 +4,10 @@
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
 #include <concepts>
+#include <cstring>
 #include <exception>
 #include <functional>
+#include <memory_resource>
 #include <type_traits>
 #include <variant>
 
@@ -16,15 +18,36 @@ namespace bcos::task
 struct NoReturnValue : public bcos::error::Exception {};
 // clang-format on
 
+// The frames of the member coroutines of such an object, or of the coroutines taking it as the
+// first argument, are allocated from its memory resource
+template <class Object>
+concept HasMemoryResource = requires(Object const& object) {
+                                // clang-format off
+    { object.memoryResource() } -> std::convertible_to<std::pmr::memory_resource*>;
+                                // clang-format on
+                            };
+
 template <class Value>
     requires(!std::is_rvalue_reference_v<Value>)
 class [[nodiscard]] Task
 {
 public:
     using ReturnType = Value;
+    struct PromiseState;
+    struct DefaultFrame;
+    template <class Object, class... Args>
+    struct ResourceFrame;
+    template <class Frame>
     struct PromiseVoid;
+    template <class Frame>
     struct PromiseValue;
-    using promise_type = std::conditional_t<std::is_same_v<Value, void>, PromiseVoid, PromiseValue>;
+    template <class Frame>
+    using Promise = std::conditional_t<std::is_same_v<Value, void>, PromiseVoid<Frame>,
+        PromiseValue<Frame>>;
+    using promise_type = Promise<DefaultFrame>;
+    // picked by the coroutine_traits below for the coroutines with a memory resource
+    template <class Object, class... Args>
+    using ResourcePromise = Promise<ResourceFrame<Object, Args...>>;
 
     constexpr static bool isReferenceValue = std::is_reference_v<Value>;
     using ValueType = std::conditional_t<std::is_reference_v<Value>,
@@ -35,7 +58,7 @@ public:
 
     struct Awaitable
     {
-        Awaitable(Task const& task) : m_handle(task.m_handle){};
+        Awaitable(Task const& task) : m_handle(task.m_handle), m_promise(task.m_promise){};
         Awaitable(const Awaitable&) = delete;
         Awaitable(Awaitable&&) noexcept = default;
         Awaitable& operator=(const Awaitable&) = delete;
@@ -47,8 +70,8 @@ public:
         template <class Promise>
         CO_STD::coroutine_handle<> await_suspend(CO_STD::coroutine_handle<Promise> handle)
         {
-            m_handle.promise().m_continuationHandle = handle;
-            m_handle.promise().m_awaitable = this;
+            m_promise->m_continuationHandle = handle;
+            m_promise->m_awaitable = this;
 
             return m_handle;
         }
@@ -76,13 +99,20 @@ public:
             }
         }
 
-        CO_STD::coroutine_handle<promise_type> m_handle;
+        CO_STD::coroutine_handle<> m_handle;
+        PromiseState* m_promise;
         VariantType m_value;
     };
     Awaitable operator co_await() { return Awaitable(*static_cast<Task*>(this)); }
 
+    // the part of the promises the awaitable sets, whatever the frame allocation
+    struct PromiseState
+    {
+        CO_STD::coroutine_handle<> m_continuationHandle;
+        Awaitable* m_awaitable = nullptr;
+    };
     template <class PromiseImpl>
-    struct PromiseBase
+    struct PromiseBase : public PromiseState
     {
         constexpr CO_STD::suspend_always initial_suspend() const noexcept { return {}; }
         constexpr auto final_suspend() noexcept
@@ -105,52 +135,107 @@ public:
         }
         constexpr Task get_return_object()
         {
-            auto handle = CO_STD::coroutine_handle<promise_type>::from_promise(
+            auto handle = CO_STD::coroutine_handle<PromiseImpl>::from_promise(
                 *static_cast<PromiseImpl*>(this));
-            return Task(handle);
+            return Task(handle, this);
         }
         void unhandled_exception()
         {
-            if (m_awaitable)
+            if (PromiseState::m_awaitable)
             {
-                m_awaitable->m_value.template emplace<std::exception_ptr>(std::current_exception());
+                PromiseState::m_awaitable->m_value.template emplace<std::exception_ptr>(
+                    std::current_exception());
             }
         }
-
-        CO_STD::coroutine_handle<> m_continuationHandle;
-        Awaitable* m_awaitable = nullptr;
     };
-    struct PromiseVoid : public PromiseBase<PromiseVoid>
+    // the frames come from the global operator new
+    struct DefaultFrame
+    {
+    };
+    // the frames come from the memory resource of the first argument, the coroutine_traits below
+    // only pick it if the first argument has one. The operator new is not a template, gcc reports
+    // a template one with the usual operator delete as mismatched
+    template <class Object, class... Args>
+    struct ResourceFrame
+    {
+        // The resource of the frame is stored behind it for the deallocation
+        static void* allocateFrame(size_t size, std::pmr::memory_resource* resource)
+        {
+            auto offset = frameOffset(size);
+            auto* frame = resource->allocate(
+                offset + sizeof(std::pmr::memory_resource*), __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            std::memcpy(static_cast<char*>(frame) + offset, &resource, sizeof(resource));
+            return frame;
+        }
+        static void* operator new(size_t size, const std::remove_reference_t<Object>& object,
+            const std::remove_reference_t<Args>&... /*unused*/)
+        {
+            return allocateFrame(size, object.memoryResource());
+        }
+        static void operator delete(void* frame, size_t size) noexcept
+        {
+            auto offset = frameOffset(size);
+            std::pmr::memory_resource* resource = nullptr;
+            std::memcpy(&resource, static_cast<char*>(frame) + offset, sizeof(resource));
+            resource->deallocate(frame, offset + sizeof(std::pmr::memory_resource*),
+                __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        }
+        constexpr static size_t frameOffset(size_t size)
+        {
+            constexpr auto alignment = alignof(std::pmr::memory_resource*);
+            return (size + alignment - 1) / alignment * alignment;
+        }
+    };
+    template <class Frame>
+    struct PromiseVoid : public PromiseBase<PromiseVoid<Frame>>, public Frame
     {
         constexpr void return_void() noexcept {}
     };
-    struct PromiseValue : public PromiseBase<PromiseValue>
+    template <class Frame>
+    struct PromiseValue : public PromiseBase<PromiseValue<Frame>>, public Frame
     {
         template <class ReturnValue>
         void return_value(ReturnValue&& value)
         {
-            if (PromiseBase<PromiseValue>::m_awaitable)
+            if (PromiseState::m_awaitable)
             {
-                PromiseBase<PromiseValue>::m_awaitable->m_value.template emplace<ValueType>(
+                PromiseState::m_awaitable->m_value.template emplace<ValueType>(
                     std::forward<ReturnValue>(value));
             }
         }
     };
 
-    explicit Task(CO_STD::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+    Task(CO_STD::coroutine_handle<> handle, PromiseState* promise)
+      : m_handle(handle), m_promise(promise)
+    {}
     Task(const Task&) = default;
-    Task(Task&& task) noexcept : m_handle(task.m_handle) { task.m_handle = nullptr; }
+    Task(Task&& task) noexcept : m_handle(task.m_handle), m_promise(task.m_promise)
+    {
+        task.m_handle = nullptr;
+    }
     Task& operator=(const Task&) = default;
     Task& operator=(Task&& task) noexcept
     {
         m_handle = task.m_handle;
+        m_promise = task.m_promise;
         task.m_handle = nullptr;
     }
     ~Task() noexcept = default;
     void start() { m_handle.resume(); }
 
 private:
-    CO_STD::coroutine_handle<promise_type> m_handle;
+    CO_STD::coroutine_handle<> m_handle;
+    PromiseState* m_promise = nullptr;
 };
 
-}  // namespace bcos::task
\ No newline at end of file
+}  // namespace bcos::task
+
+// Only the coroutines whose first argument, the object of a member coroutine, has a memory
+// resource pay for the allocation from it, the others keep the default operator new
+template <class Value, class Object, class... Args>
+    requires bcos::task::HasMemoryResource<std::remove_cvref_t<Object>>
+struct CO_STD::coroutine_traits<bcos::task::Task<Value>, Object, Args...>
+{
+    using promise_type =
+        typename bcos::task::Task<Value>::template ResourcePromise<Object, Args...>;
+};
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <boost/test/unit_test.hpp>
 #include <chrono>
 #include <iostream>
+#include <memory_resource>
 #include <thread>
 
 using namespace bcos::task;
@@ -165,6 +166,58 @@ BOOST_AUTO_TEST_CASE(referenceTask)
     BOOST_CHECK_EQUAL(std::addressof(result2), std::addressof(topNumber));
 }
 
+struct CountingResource : public std::pmr::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+struct WithMemoryResource
+{
+    CountingResource* resource;
+    std::pmr::memory_resource* memoryResource() const { return resource; }
+
+    Task<int> inner(int num) const { co_return num + 1; }
+    Task<int> outer(int num) const
+    {
+        auto result = co_await inner(num);
+        co_return co_await returnIntReference(result) * 2;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(frameResource)
+{
+    CountingResource resource;
+    WithMemoryResource object{.resource = std::addressof(resource)};
+    BOOST_CHECK_EQUAL(bcos::task::syncWait(object.outer(1)), 4);
+
+    // the frame of the free coroutine comes from the heap
+    BOOST_CHECK_EQUAL(resource.allocations, 2);
+    BOOST_CHECK_EQUAL(resource.deallocations, 2);
+
+    // only the coroutines with a memory resource use the promise allocating from it
+    static_assert(std::is_same_v<CO_STD::coroutine_traits<Task<int>, const WithMemoryResource&,
+                                     int>::promise_type,
+        Task<int>::ResourcePromise<const WithMemoryResource&, int>>);
+    static_assert(std::is_same_v<CO_STD::coroutine_traits<Task<int>, int>::promise_type,
+        Task<int>::promise_type>);
+}
+
 struct SleepTask
 {
     inline static oneapi::tbb::concurrent_vector<std::future<void>> futures;
@@ -535,6 +535,13 @@ public:
         _respFunc(BCOS_ERROR_PTR(-1, "Unspported method!"), value);
     }
 
+    void getLogs(std::string_view _groupID, std::string_view _nodeName,
+        const Json::Value& _filter, RespFunc _respFunc) override
+    {
+        Json::Value value;
+        _respFunc(BCOS_ERROR_PTR(-1, "Unspported method!"), value);
+    }
+
     void getGroupPeers(std::string_view _groupID, RespFunc _respFunc) override
     {
         Json::Value value;
@@ -1339,6 +1339,8 @@ generate_common_ini() {
     enable_archive=false
     archive_ip=127.0.0.1
     archive_port=
+    ; index the logs by address and topic for getLogs, the blocks before are indexed in background
+    enable_log_index=false
 
 [txpool]
     ; size of the txpool, default is 15000
@@ -1349,6 +1351,10 @@ generate_common_ini() {
     ;verify_worker_num=2
     ; txs expiration time, in seconds, default is 10 minutes
     txs_expiration_time = 600
+    ; txs accepted to disk when the txpool is full, default is 0 to reject them
+    ;spill_limit=1000000
+    ; path of the spill file, default is txpool_spill under the storage path
+    ;spill_path=data/txpool_spill
 
 [sync]
     ; send transaction by tree-topology
@@ -0,0 +1,221 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the tool to backfill the log index of the blocks committed before it was enabled
+ * @file logIndexTool.cpp
+ */
+
+#include "bcos-framework/ledger/LedgerTypeDef.h"
+#include "bcos-framework/storage/StorageInterface.h"
+#include "bcos-ledger/src/libledger/Ledger.h"
+#include "bcos-ledger/src/libledger/LogIndexer.h"
+#include "bcos-utilities/BoostLogInitializer.h"
+#include "boost/filesystem.hpp"
+#include "libinitializer/ProtocolInitializer.h"
+#include "libinitializer/StorageInitializer.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/security/DataEncryptInterface.h>
+#include <bcos-security/bcos-security/DataEncryption.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::storage;
+using namespace bcos::initializer;
+
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+
+po::options_description main_options(
+    "log index tool used to backfill the log index of FISCO BCOS v3, the node must be stopped");
+
+po::variables_map initCommandLine(int argc, const char* argv[])
+{
+    main_options.add_options()("help,h", "help of log index tool")("config,c",
+        boost::program_options::value<std::string>()->default_value("./config.ini"),
+        "config file path")("genesis,g",
+        boost::program_options::value<std::string>()->default_value("./config.genesis"),
+        "genesis config file path")("to,t", boost::program_options::value<int64_t>(),
+        "the last block to index, default is the current block")("batch,b",
+        boost::program_options::value<int64_t>()->default_value(
+            bcos::ledger::LogIndexer::BATCH_BLOCKS),
+        "the number of blocks indexed by one write");
+    po::variables_map varMap;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, main_options), varMap);
+        po::notify(varMap);
+    }
+    catch (...)
+    {
+        std::cout << "parse_command_line failed" << std::endl;
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    if ((varMap.count("help") != 0U) || (varMap.count("h") != 0U))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    return varMap;
+}
+
+TransactionalStorageInterface::Ptr createBackendStorage(
+    std::shared_ptr<bcos::tool::NodeConfig> nodeConfig, const std::string& logPath)
+{
+    bcos::storage::TransactionalStorageInterface::Ptr storage = nullptr;
+    if (boost::iequals(nodeConfig->storageType(), "RocksDB"))
+    {
+        bcos::security::DataEncryptInterface::Ptr dataEncryption = nullptr;
+        if (nodeConfig->storageSecurityEnable())
+        {
+            dataEncryption = std::make_shared<bcos::security::DataEncryption>(nodeConfig);
+        }
+        RocksDBOption option;
+        option.maxWriteBufferNumber = nodeConfig->maxWriteBufferNumber();
+        option.maxBackgroundJobs = nodeConfig->maxBackgroundJobs();
+        option.writeBufferSize = nodeConfig->writeBufferSize();
+        option.minWriteBufferNumberToMerge = nodeConfig->minWriteBufferNumberToMerge();
+        option.blockCacheSize = nodeConfig->blockCacheSize();
+        storage = StorageInitializer::build(
+            nodeConfig->storagePath(), option, dataEncryption, nodeConfig->keyPageSize());
+    }
+    else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
+    {
+#ifdef WITH_TIKV
+        storage = StorageInitializer::build(nodeConfig->pdAddrs(), logPath, nodeConfig->pdCaPath(),
+            nodeConfig->pdCertPath(), nodeConfig->pdKeyPath());
+#endif
+    }
+    else
+    {
+        throw std::runtime_error("storage type not support");
+    }
+    return storage;
+}
+
+int main(int argc, const char* argv[])
+{
+    boost::property_tree::ptree propertyTree;
+    auto params = initCommandLine(argc, argv);
+    // parse config file
+    std::string configPath("./config.ini");
+    if (params.count("config") != 0U)
+    {
+        configPath = params["config"].as<std::string>();
+    }
+    if (!fs::exists(configPath))
+    {
+        cout << "config file not found:" << configPath << endl;
+        return 1;
+    }
+    std::string genesisFilePath("./config.genesis");
+    if (params.count("genesis") != 0U)
+    {
+        genesisFilePath = params["genesis"].as<std::string>();
+    }
+    auto batch = params["batch"].as<int64_t>();
+    if (batch <= 0)
+    {
+        cerr << "invalid batch: " << batch << endl;
+        return 1;
+    }
+    cout << "config file: " << configPath << " | genesis file: " << genesisFilePath << endl;
+
+    boost::property_tree::read_ini(configPath, propertyTree);
+    auto logInitializer = std::make_shared<BoostLogInitializer>();
+    logInitializer->initLog(propertyTree);
+
+    // load node config
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto nodeConfig = std::make_shared<bcos::tool::NodeConfig>(keyFactory);
+    nodeConfig->loadConfig(configPath);
+    if (fs::exists(genesisFilePath))
+    {
+        nodeConfig->loadGenesisConfig(genesisFilePath);
+    }
+
+    auto storage = createBackendStorage(nodeConfig, logInitializer->logPath());
+    auto protocolInitializer = std::make_shared<ProtocolInitializer>();
+    protocolInitializer->init(nodeConfig);
+    auto ledger =
+        std::make_shared<bcos::ledger::Ledger>(protocolInitializer->blockFactory(), storage);
+    std::promise<int64_t> promise;
+    ledger->asyncGetBlockNumber(
+        [&promise](const Error::Ptr& error, bcos::protocol::BlockNumber number) {
+            if (error)
+            {
+                cout << "get block number failed: " << error->errorMessage() << endl;
+                exit(1);
+            }
+            promise.set_value(number);
+            cout << "current block number is " << number << endl;
+        });
+    auto currentBlockNumber = promise.get_future().get();
+    auto toBlockNumber = currentBlockNumber;
+    if (params.count("to") != 0U)
+    {
+        toBlockNumber = params["to"].as<int64_t>();
+        if (toBlockNumber < 0 || toBlockNumber > currentBlockNumber)
+        {
+            cerr << "invalid block number, to: " << toBlockNumber
+                 << ", current: " << currentBlockNumber << endl;
+            return 1;
+        }
+    }
+
+    // resume from the last indexed block, of the node or of the last run of the tool
+    bcos::ledger::LogIndexer logIndexer(ledger, storage);
+    auto error = logIndexer.init();
+    if (error)
+    {
+        cerr << "get log indexed number failed: " << error->errorMessage() << endl;
+        return 1;
+    }
+    auto fromBlockNumber = logIndexer.indexedNumber() + 1;
+    if (fromBlockNumber > toBlockNumber)
+    {
+        cout << "the blocks up to " << logIndexer.indexedNumber() << " have been indexed" << endl;
+        return 0;
+    }
+    cout << "index the logs of the blocks [" << fromBlockNumber << "," << toBlockNumber << "]"
+         << endl;
+    while (logIndexer.indexedNumber() < toBlockNumber)
+    {
+        auto batchToBlock = std::min(toBlockNumber, logIndexer.indexedNumber() + batch);
+        error = logIndexer.indexBlocks(batchToBlock);
+        if (error)
+        {
+            cerr << endl
+                 << "index the logs failed, indexed block: " << logIndexer.indexedNumber()
+                 << ", message: " << error->errorMessage() << endl;
+            return 1;
+        }
+        cout << "\r"
+             << "indexed block " << batchToBlock << "/" << toBlockNumber << std::flush;
+    }
+    cout << endl
+         << "index the logs success, block range [" << fromBlockNumber << "," << toBlockNumber
+         << "]" << endl;
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "bcos-task/Trait.h"
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <boost/container/small_vector.hpp>
+#include <memory_resource>
 
 namespace bcos::transaction_executor
 {
@@ -27,7 +28,9 @@ private:
         StateKey key;
         std::optional<StateValue> oldValue;
     };
-    boost::container::small_vector<Record, MOSTLY_STEPS> m_records;
+    std::pmr::memory_resource* m_memoryResource;
+    boost::container::small_vector<Record, MOSTLY_STEPS, std::pmr::polymorphic_allocator<Record>>
+        m_records;
     Storage& m_storage;
 
 public:
@@ -35,9 +38,16 @@ public:
     using Key = typename Storage::Key;
     using Value = typename Storage::Value;
 
-    Rollbackable(Storage& storage) : m_storage(storage) {}
+    // The records and the coroutine frames of the transaction are allocated from memoryResource
+    Rollbackable(Storage& storage,
+        std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource())
+      : m_memoryResource(memoryResource),
+        m_records(std::pmr::polymorphic_allocator<Record>(memoryResource)),
+        m_storage(storage)
+    {}
 
     Storage& storage() { return m_storage; }
+    std::pmr::memory_resource* memoryResource() const { return m_memoryResource; }
     Savepoint current() const { return static_cast<int64_t>(m_records.size()); }
     task::Task<void> rollback(Savepoint savepoint)
     {
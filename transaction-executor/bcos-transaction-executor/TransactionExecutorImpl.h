@@ -15,6 +15,7 @@
 #include <boost/exception/diagnostic_information.hpp>
 #include <gsl/util>
 #include <iterator>
+#include <memory_resource>
 #include <type_traits>
 
 namespace bcos::transaction_executor
@@ -35,14 +36,77 @@ public:
       : m_receiptFactory(receiptFactory), m_precompiledManager(precompiledManager)
     {}
 
+    void setAnalysisPolicy(AnalysisPolicy policy) { m_vmFactory.setAnalysisPolicy(policy); }
+    CodeAnalysisStatistic const& codeAnalysisStatistic() const
+    {
+        return m_vmFactory.codeAnalysisStatistic();
+    }
+    // The codes set by the blocks up to the committed one can be cached
+    void setCommittedBlock(protocol::BlockNumber blockNumber)
+    {
+        m_vmFactory.codeCache().setCommittedBlock(blockNumber);
+    }
+
 private:
     VMFactory m_vmFactory;
     protocol::TransactionReceiptFactory const& m_receiptFactory;
     PrecompiledManager const& m_precompiledManager;
 
+    friend std::optional<std::vector<StateKey>> tag_invoke(
+        tag_t<predictConflictKeys> /*unused*/, TransactionExecutorImpl& executor,
+        protocol::Transaction const& transaction)
+    {
+        // The prediction runs inside the scheduler's parallel_for, a malformed calldata must not
+        // escape from there, the transaction is executed without prediction instead
+        try
+        {
+            constexpr static unsigned long MAX_PRECOMPILED_ADDRESS = 100000;
+            if (transaction.to().empty())
+            {
+                return {};
+            }
+
+            auto toAddress = unhexAddress(transaction.to());
+            auto address =
+                fromBigEndian<u160>(bcos::bytesConstRef(toAddress.bytes, sizeof(toAddress.bytes)));
+            if (address == 0 || address >= MAX_PRECOMPILED_ADDRESS)
+            {
+                return {};
+            }
+
+            auto const* precompiled =
+                executor.m_precompiledManager.getPrecompiled(address.convert_to<unsigned long>());
+            if (precompiled == nullptr)
+            {
+                return {};
+            }
+            auto tags = precompiled->parallelTags(transaction.input());
+            if (tags.empty())
+            {
+                return {};
+            }
+
+            // The rows read by the precompiled when the tags name them, so that the keys can be
+            // read ahead of the execution as well
+            auto table =
+                precompiled->tagTable().empty() ? transaction.to() : precompiled->tagTable();
+            return tags | RANGES::views::transform([&](std::string const& tag) {
+                return StateKey{SmallString(table), SmallString(tag)};
+            }) | RANGES::to<std::vector<StateKey>>();
+        }
+        catch (std::exception const& e)
+        {
+            TRANSACTION_EXECUTOR_LOG(DEBUG)
+                << "Predict conflict keys failed: " << transaction.hash().hex() << " "
+                << boost::diagnostic_information(e);
+            return {};
+        }
+    }
+
     friend task::Task<protocol::TransactionReceipt::Ptr> tag_invoke(tag_t<execute> /*unused*/,
         TransactionExecutorImpl& executor, auto& storage, protocol::BlockHeader const& blockHeader,
-        protocol::Transaction const& transaction, int contextID)
+        protocol::Transaction const& transaction, int contextID,
+        std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource())
     {
         try
         {
@@ -52,7 +116,8 @@ private:
                     << "Execte transaction: " << transaction.hash().hex();
             }
 
-            Rollbackable<std::remove_reference_t<decltype(storage)>> rollbackableStorage(storage);
+            Rollbackable<std::remove_reference_t<decltype(storage)>> rollbackableStorage(
+                storage, memoryResource);
 
             auto toAddress = unhexAddress(transaction.to());
             evmc_message evmcMessage = {.kind = transaction.to().empty() ? EVMC_CREATE : EVMC_CALL,
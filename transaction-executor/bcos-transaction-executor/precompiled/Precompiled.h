@@ -26,9 +26,28 @@ class Precompiled
 private:
     std::variant<executor::PrecompiledContract, std::shared_ptr<precompiled::Precompiled>>
         m_precompiled;
+    std::string_view m_tagTable;
 
 public:
-    Precompiled(decltype(m_precompiled) precompiled) : m_precompiled(std::move(precompiled)) {}
+    Precompiled(decltype(m_precompiled) precompiled, std::string_view tagTable = {})
+      : m_precompiled(std::move(precompiled)), m_tagTable(tagTable)
+    {}
+
+    // The table whose row keys are the parallel tags, empty if the tags are no storage keys
+    std::string_view tagTable() const { return m_tagTable; }
+
+    // Conflict tags derived from the calldata, empty if the precompiled can't tell
+    std::vector<std::string> parallelTags(bytesConstRef input) const
+    {
+        auto const* precompiled =
+            std::get_if<std::shared_ptr<precompiled::Precompiled>>(std::addressof(m_precompiled));
+        if (precompiled != nullptr && (*precompiled)->isParallelPrecompiled())
+        {
+            return (*precompiled)->getParallelTag(input, false);
+        }
+        return {};
+    }
+
     EVMCResult call(auto& storage, protocol::BlockHeader const& blockHeader,
         evmc_message const& message, evmc_address const& origin, auto externalCaller) const
     {
@@ -60,8 +60,10 @@ bcos::transaction_executor::PrecompiledManager::PrecompiledManager(crypto::Hash:
         0x1009, std::make_shared<precompiled::KVTablePrecompiled>(m_hashImpl));
     m_address2Precompiled.emplace_back(
         0x1001, std::make_shared<precompiled::TablePrecompiled>(m_hashImpl));
+    // The tags of the dag transfer are the users, which are the row keys of its table
     m_address2Precompiled.emplace_back(
-        0x100c, std::make_shared<precompiled::DagTransferPrecompiled>(m_hashImpl));
+        0x100c, Precompiled(std::make_shared<precompiled::DagTransferPrecompiled>(m_hashImpl),
+                    ledger::DAG_TRANSFER));
     m_address2Precompiled.emplace_back(
         0x100a, std::make_shared<precompiled::CryptoPrecompiled>(m_hashImpl));
     m_address2Precompiled.emplace_back(
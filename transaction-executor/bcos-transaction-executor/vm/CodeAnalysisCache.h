@@ -0,0 +1,278 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief byte budgeted cache of the code analysis, choosing the interpreter per contract
+ * @file CodeAnalysisCache.h
+ */
+
+#pragma once
+#include <bcos-utilities/FixedBytes.h>
+#include <bcos-utilities/Overloaded.h>
+#include <evmc/evmc.h>
+#include <evmone/advanced_analysis.hpp>
+#include <evmone/baseline.hpp>
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+
+namespace bcos::transaction_executor
+{
+
+enum class Interpreter
+{
+    // start on the baseline interpreter, move the hot and small contracts to the advanced one
+    adaptive,
+    baseline,
+    advanced,
+};
+
+// The analysis of a code for the interpreter running it
+using CodeAnalysis = std::variant<std::shared_ptr<evmone::baseline::CodeAnalysis const>,
+    std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>>;
+
+struct AnalysisPolicy
+{
+    constexpr static int64_t DEFAULT_CACHE_BYTES = 64 * 1024 * 1024;
+    constexpr static uint32_t DEFAULT_ADVANCED_CALLS = 16;
+    constexpr static size_t DEFAULT_ADVANCED_CODE_SIZE = 24 * 1024;
+
+    Interpreter interpreter = Interpreter::adaptive;
+    int64_t maxCacheBytes = DEFAULT_CACHE_BYTES;
+    // The calls of a code before it is analyzed for the advanced interpreter, adaptive only
+    uint32_t advancedCalls = DEFAULT_ADVANCED_CALLS;
+    // The larger codes stay on the baseline interpreter, adaptive only. The advanced analysis
+    // takes about twenty times the code size and is made before the first instruction runs
+    size_t maxAdvancedCodeSize = DEFAULT_ADVANCED_CODE_SIZE;
+};
+
+// Reported as a METRIC line after each commit
+struct CodeAnalysisStatistic
+{
+    std::atomic_uint64_t hits = 0;
+    std::atomic_uint64_t misses = 0;
+    std::atomic_uint64_t evictions = 0;
+    // baseline analyses replaced by advanced ones
+    std::atomic_uint64_t promotions = 0;
+    // analyses larger than the budget of a shard, returned without being cached
+    std::atomic_uint64_t uncached = 0;
+    std::atomic_int64_t bytes = 0;
+};
+
+// Code analyses by code hash, evicted in LRU order once the estimated bytes of the analyses exceed
+// the budget. The cache is split into shards by code hash, each with its own lock and an equal part
+// of the budget
+class CodeAnalysisCache
+{
+public:
+    explicit CodeAnalysisCache(AnalysisPolicy policy = {}) { setPolicy(policy); }
+    CodeAnalysisCache(const CodeAnalysisCache&) = delete;
+    CodeAnalysisCache(CodeAnalysisCache&&) = delete;
+    CodeAnalysisCache& operator=(const CodeAnalysisCache&) = delete;
+    CodeAnalysisCache& operator=(CodeAnalysisCache&&) = delete;
+    ~CodeAnalysisCache() noexcept = default;
+
+    // Must be set before the executions, drop the cached analyses whose interpreter may no longer
+    // fit the policy
+    void setPolicy(AnalysisPolicy policy)
+    {
+        for (auto& shard : m_shards)
+        {
+            std::unique_lock lock(shard.mutex);
+            m_statistic.bytes -= shard.bytes;
+            shard.index.clear();
+            shard.entries.clear();
+            shard.bytes = 0;
+        }
+        m_policy = policy;
+    }
+    AnalysisPolicy const& policy() const { return m_policy; }
+    CodeAnalysisStatistic const& statistic() const { return m_statistic; }
+
+    CodeAnalysis get(const h256& codeHash, std::string_view code, evmc_revision mode)
+    {
+        auto& shard = m_shards[std::hash<h256>{}(codeHash) % SHARDS];
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.index.find(codeHash);
+        if (it != shard.index.end() && it->second->mode == mode)
+        {
+            ++m_statistic.hits;
+            auto entryIt = it->second;
+            shard.entries.splice(shard.entries.begin(), shard.entries, entryIt);
+            ++entryIt->calls;
+            if (!std::holds_alternative<BaselineAnalysis>(entryIt->analysis) ||
+                !useAdvanced(code.size(), entryIt->calls))
+            {
+                return entryIt->analysis;
+            }
+
+            // Promote the hot code, the other callers keep running the baseline analysis meanwhile
+            auto calls = entryIt->calls;
+            lock.unlock();
+            CodeAnalysis analysis = analyzeAdvanced(code, mode);
+            lock.lock();
+            if (auto promoted = shard.index.find(codeHash);
+                promoted != shard.index.end() && promoted->second->mode == mode &&
+                !std::holds_alternative<BaselineAnalysis>(promoted->second->analysis))
+            {
+                // promoted by another caller
+                return promoted->second->analysis;
+            }
+            if (store(shard, codeHash, mode, analysis, calls))
+            {
+                ++m_statistic.promotions;
+            }
+            return analysis;
+        }
+        ++m_statistic.misses;
+        lock.unlock();
+
+        auto analysis = useAdvanced(code.size(), 1) ? CodeAnalysis{analyzeAdvanced(code, mode)} :
+                                                      CodeAnalysis{analyzeBaseline(code, mode)};
+        lock.lock();
+        store(shard, codeHash, mode, analysis, 1);
+        return analysis;
+    }
+
+    size_t size() const
+    {
+        size_t size = 0;
+        for (auto const& shard : m_shards)
+        {
+            std::unique_lock lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+    // Estimated memory of the analysis, the padded code and the jumpdest bitmap for the baseline
+    // interpreter, the instructions, the push values and the jump tables for the advanced one
+    static int64_t analysisBytes(CodeAnalysis const& analysis)
+    {
+        constexpr static size_t CODE_PADDING = 33;
+        return std::visit(
+            overloaded{[](std::shared_ptr<evmone::baseline::CodeAnalysis const> const& baseline) {
+                           return static_cast<int64_t>(sizeof(*baseline) +
+                                                       baseline->executable_code.size() +
+                                                       CODE_PADDING +
+                                                       baseline->jumpdest_map.size() / 8);
+                       },
+                [](std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const> const& advanced) {
+                    return static_cast<int64_t>(
+                        sizeof(*advanced) +
+                        advanced->instrs.capacity() * sizeof(advanced->instrs[0]) +
+                        advanced->push_values.capacity() * sizeof(advanced->push_values[0]) +
+                        advanced->jumpdest_offsets.capacity() * sizeof(int32_t) +
+                        advanced->jumpdest_targets.capacity() * sizeof(int32_t));
+                }},
+            analysis);
+    }
+
+private:
+    constexpr static size_t SHARDS = 16;
+    using BaselineAnalysis = std::shared_ptr<evmone::baseline::CodeAnalysis const>;
+
+    struct Entry
+    {
+        h256 codeHash;
+        evmc_revision mode;
+        CodeAnalysis analysis;
+        int64_t bytes;
+        uint32_t calls;
+    };
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        // most recently used first
+        std::list<Entry> entries;
+        std::unordered_map<h256, std::list<Entry>::iterator, std::hash<h256>> index;
+        int64_t bytes = 0;
+    };
+
+    bool useAdvanced(size_t codeSize, uint32_t calls) const
+    {
+        switch (m_policy.interpreter)
+        {
+        case Interpreter::advanced:
+            return true;
+        case Interpreter::baseline:
+            return false;
+        default:
+            return calls >= m_policy.advancedCalls && codeSize <= m_policy.maxAdvancedCodeSize;
+        }
+    }
+
+    static std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const> analyzeAdvanced(
+        std::string_view code, evmc_revision mode)
+    {
+        return std::make_shared<evmone::advanced::AdvancedCodeAnalysis>(evmone::advanced::analyze(
+            mode, evmone::bytes_view((const uint8_t*)code.data(), code.size())));
+    }
+    static BaselineAnalysis analyzeBaseline(std::string_view code, evmc_revision mode)
+    {
+        return std::make_shared<evmone::baseline::CodeAnalysis>(evmone::baseline::analyze(
+            mode, evmone::bytes_view((const uint8_t*)code.data(), code.size())));
+    }
+
+    // Insert or replace the entry of the code with the lock held, evicting the least recently
+    // used ones over the budget. Return false if the analysis does not fit in the shard
+    bool store(Shard& shard, const h256& codeHash, evmc_revision mode,
+        CodeAnalysis const& analysis, uint32_t calls)
+    {
+        auto bytes = analysisBytes(analysis);
+        auto shardBytes = m_policy.maxCacheBytes / static_cast<int64_t>(SHARDS);
+        if (bytes > shardBytes)
+        {
+            ++m_statistic.uncached;
+            return false;
+        }
+
+        if (auto it = shard.index.find(codeHash); it != shard.index.end())
+        {
+            shard.bytes -= it->second->bytes;
+            m_statistic.bytes -= it->second->bytes;
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+        shard.entries.push_front(Entry{.codeHash = codeHash,
+            .mode = mode,
+            .analysis = analysis,
+            .bytes = bytes,
+            .calls = calls});
+        shard.index.emplace(codeHash, shard.entries.begin());
+        shard.bytes += bytes;
+        m_statistic.bytes += bytes;
+
+        while (shard.bytes > shardBytes)
+        {
+            auto& evicted = shard.entries.back();
+            shard.bytes -= evicted.bytes;
+            m_statistic.bytes -= evicted.bytes;
+            shard.index.erase(evicted.codeHash);
+            shard.entries.pop_back();
+            ++m_statistic.evictions;
+        }
+        return true;
+    }
+
+    AnalysisPolicy m_policy;
+    std::array<Shard, SHARDS> m_shards;
+    CodeAnalysisStatistic m_statistic;
+};
+}  // namespace bcos::transaction_executor
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache of the contract code by address
+ * @file CodeCache.h
+ */
+
+#pragma once
+#include <bcos-framework/storage/Entry.h>
+#include <bcos-utilities/FixedBytes.h>
+#include <evmc/evmc.h>
+#include <boost/container_hash/hash.hpp>
+#include <algorithm>
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace bcos::transaction_executor
+{
+
+// Code hash and code of the contracts by address, shared by all the host contexts of an
+// executor so calling a hot contract skips the two storage reads of its code. Evicted in LRU
+// order, the cache is split into shards by address, each with its own lock and an equal part of
+// the capacity.
+//
+// The code of an address only changes by setCode, which marks the address as created in the
+// block. The marked addresses are not cached until the block creating them is committed, up to
+// that the block may be reverted or replaced by another proposal while the newer blocks execute
+// on top of it. So a cached code always comes from a committed state and can be served to any
+// transaction without entering its read set
+class CodeCache
+{
+public:
+    struct Code
+    {
+        h256 codeHash;
+        storage::Entry code;
+    };
+
+    explicit CodeCache(size_t capacity = DEFAULT_CAPACITY)
+      : m_shardCapacity(capacity == 0 ? 0 : std::max<size_t>(capacity / SHARDS, 1))
+    {}
+
+    std::shared_ptr<Code const> get(const evmc_address& address)
+    {
+        auto& shard = m_shards[AddressHash{}(address) % SHARDS];
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.index.find(address);
+        if (it == shard.index.end())
+        {
+            return {};
+        }
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return it->second->second;
+    }
+
+    void put(const evmc_address& address, std::shared_ptr<Code const> code)
+    {
+        if (m_shardCapacity == 0)
+        {
+            return;
+        }
+        {
+            std::shared_lock createdLock(m_createdMutex);
+            if (m_createdBlocks.contains(address))
+            {
+                return;
+            }
+        }
+
+        auto& shard = m_shards[AddressHash{}(address) % SHARDS];
+        std::unique_lock lock(shard.mutex);
+        if (auto it = shard.index.find(address); it != shard.index.end())
+        {
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+        shard.entries.emplace_front(address, std::move(code));
+        shard.index.emplace(address, shard.entries.begin());
+        while (shard.entries.size() > m_shardCapacity)
+        {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+        }
+    }
+
+    // Must be called before the code of the address is written
+    void invalidate(const evmc_address& address, int64_t blockNumber)
+    {
+        {
+            std::unique_lock createdLock(m_createdMutex);
+            auto [it, inserted] = m_createdBlocks.try_emplace(address, blockNumber);
+            if (!inserted)
+            {
+                it->second = std::max(it->second, blockNumber);
+            }
+        }
+        auto& shard = m_shards[AddressHash{}(address) % SHARDS];
+        std::unique_lock lock(shard.mutex);
+        if (auto it = shard.index.find(address); it != shard.index.end())
+        {
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+
+    // Release the marks of the blocks up to the committed one, the blocks executed but not
+    // committed keep their marks
+    void setCommittedBlock(int64_t blockNumber)
+    {
+        std::unique_lock createdLock(m_createdMutex);
+        std::erase_if(m_createdBlocks, [blockNumber](auto const& createdBlock) {
+            return createdBlock.second <= blockNumber;
+        });
+    }
+
+    size_t size() const
+    {
+        size_t size = 0;
+        for (auto const& shard : m_shards)
+        {
+            std::unique_lock lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+private:
+    constexpr static size_t DEFAULT_CAPACITY = 4096;
+    constexpr static size_t SHARDS = 16;
+
+    struct AddressHash
+    {
+        size_t operator()(const evmc_address& address) const
+        {
+            return boost::hash_range(address.bytes, address.bytes + sizeof(address.bytes));
+        }
+    };
+    struct AddressEqual
+    {
+        bool operator()(const evmc_address& lhs, const evmc_address& rhs) const
+        {
+            return std::equal(lhs.bytes, lhs.bytes + sizeof(lhs.bytes), rhs.bytes);
+        }
+    };
+    using Entries = std::list<std::pair<evmc_address, std::shared_ptr<Code const>>>;
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        // most recently used first
+        Entries entries;
+        std::unordered_map<evmc_address, Entries::iterator, AddressHash, AddressEqual> index;
+    };
+
+    size_t m_shardCapacity;
+    std::array<Shard, SHARDS> m_shards;
+    mutable std::shared_mutex m_createdMutex;
+    // the block numbers of the addresses whose code has been set by the uncommitted blocks
+    std::unordered_map<evmc_address, int64_t, AddressHash, AddressEqual> m_createdBlocks;
+};
+}  // namespace bcos::transaction_executor
@@ -45,6 +45,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string_view>
 
@@ -177,26 +178,46 @@ public:
             std::move(entry));
     }
 
-    task::Task<std::optional<storage::Entry>> code(const evmc_address& address)
+    // The code hash and the code of the contract, served by the code cache of the vm factory when
+    // cached
+    task::Task<std::shared_ptr<CodeCache::Code const>> code(const evmc_address& address)
     {
+        auto& codeCache = m_vmFactory.codeCache();
+        if (auto cachedCode = codeCache.get(address))
+        {
+            co_return cachedCode;
+        }
+
         // Need block version >= 3.1
         auto tableName = getTableName(address);
         auto codeHashEntry = co_await storage2::readOne(
             m_rollbackableStorage, StateKeyView{tableName, ACCOUNT_CODE_HASH});
-        if (codeHashEntry)
+        if (!codeHashEntry)
         {
-            auto codeEntry = co_await storage2::readOne(
-                m_rollbackableStorage, StateKeyView{ledger::SYS_CODE_BINARY, codeHashEntry->get()});
-            if (codeEntry)
-            {
-                co_return codeEntry;
-            }
+            co_return std::shared_ptr<CodeCache::Code const>{};
+        }
+        auto codeEntry = co_await storage2::readOne(
+            m_rollbackableStorage, StateKeyView{ledger::SYS_CODE_BINARY, codeHashEntry->get()});
+        if (!codeEntry)
+        {
+            co_return std::shared_ptr<CodeCache::Code const>{};
         }
-        co_return std::optional<storage::Entry>{};
+        auto codeHashView = codeHashEntry->get();
+        auto code = std::make_shared<CodeCache::Code const>(CodeCache::Code{
+            .codeHash = h256((const bcos::byte*)codeHashView.data(), codeHashView.size()),
+            .code = std::move(*codeEntry)});
+        codeCache.put(address, code);
+        co_return code;
     }
 
     task::Task<void> setCode(const crypto::HashType& codeHash, bytesConstRef code)
     {
+        m_vmFactory.codeCache().invalidate(
+            (m_message.kind == EVMC_CREATE || m_message.kind == EVMC_CREATE2) ?
+                m_newContractAddress :
+                m_message.recipient,
+            blockNumber());
+
         storage::Entry codeHashEntry;
         codeHashEntry.set(std::string_view((const char*)codeHash.data(), codeHash.size()));
 
@@ -243,13 +264,17 @@ public:
         auto codeEntry = co_await code(address);
         if (codeEntry)
         {
-            co_return codeEntry->get().size();
+            co_return codeEntry->code.size();
         }
         co_return 0;
     }
 
     task::Task<h256> codeHashAt(const evmc_address& address)
     {
+        if (auto cachedCode = m_vmFactory.codeCache().get(address))
+        {
+            co_return cachedCode->codeHash;
+        }
         auto tableName = getTableName(address);
         auto codeHashEntry = co_await storage2::readOne(
             m_rollbackableStorage, StateKeyView{tableName, ACCOUNT_CODE_HASH});
@@ -358,19 +383,18 @@ public:
             }
         }
 
-        auto codeEntry = co_await code(m_message.code_address);
-        if (!codeEntry || codeEntry->size() == 0)
+        auto codeEntry = co_await this->code(m_message.code_address);
+        if (!codeEntry || codeEntry->code.size() == 0)
         {
             BOOST_THROW_EXCEPTION(NotFoundCodeError{} << bcos::Error::ErrorMessage(
                                       std::string("Not found contract code: ")
                                           .append(toHexStringWithPrefix(
                                               static_cast<std::string_view>(m_myContractTable)))));
         }
-        auto code = codeEntry->get();
+        auto code = codeEntry->code.get();
         auto mode = toRevision(vmSchedule());
 
-        auto codeHash = co_await codeHashAt(m_message.code_address);
-        auto vmInstance = m_vmFactory.create(VMKind::evmone, codeHash, code, mode);
+        auto vmInstance = m_vmFactory.create(VMKind::evmone, codeEntry->codeHash, code, mode);
         auto savepoint = m_rollbackableStorage.current();
         auto result = vmInstance.execute(
             interface, this, mode, &m_message, (const uint8_t*)code.data(), code.size());
@@ -417,6 +441,13 @@ public:
     }
 
     std::vector<protocol::LogEntry>& logs() & { return m_logs; }
+
+    // The coroutine frames of the host context are allocated with the ones of the transaction
+    std::pmr::memory_resource* memoryResource() const
+        requires requires(Storage& storage) { storage.memoryResource(); }
+    {
+        return m_rollbackableStorage.memoryResource();
+    }
 };
 
 }  // namespace bcos::transaction_executor
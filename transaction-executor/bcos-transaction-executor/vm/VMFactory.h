@@ -20,8 +20,9 @@
  */
 
 #pragma once
+#include "CodeAnalysisCache.h"
+#include "CodeCache.h"
 #include "VMInstance.h"
-#include "bcos-framework/storage2/MemoryStorage.h"
 #include <evmone/evmone.h>
 #include <boost/throw_exception.hpp>
 #include <memory>
@@ -43,12 +44,8 @@ struct UnknownVMError : public bcos::Error {};
 class VMFactory
 {
 private:
-    storage2::memory_storage::MemoryStorage<crypto::HashType,
-        std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>,
-        storage2::memory_storage::Attribute(
-            storage2::memory_storage::CONCURRENT | storage2::memory_storage::MRU),
-        std::hash<crypto::HashType>>
-        m_evmoneCodeAnalysisCache;
+    CodeAnalysisCache m_codeAnalysisCache;
+    CodeCache m_codeCache;
 
 public:
     /// Creates a VM instance of the global kind.
@@ -72,30 +69,25 @@ public:
         switch (kind)
         {
         case VMKind::evmone:
-        {
-            std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const> codeAnalysis;
-            auto it = m_evmoneCodeAnalysisCache.read(RANGES::views::single(codeHash)).toValue();
-            it.next().toValue();
-            if (it.hasValue().toValue())
-            {
-                codeAnalysis = it.value().toValue();
-                it.release();
-            }
-            else
-            {
-                it.release();
-                codeAnalysis = std::make_shared<evmone::advanced::AdvancedCodeAnalysis>(
-                    evmone::advanced::analyze(
-                        mode, evmone::bytes_view((const uint8_t*)code.data(), code.size())));
-                (void)m_evmoneCodeAnalysisCache.write(RANGES::views::single(codeHash),
-                    RANGES::views::single(std::as_const(codeAnalysis)));
-            }
-
-            return VMInstance{std::move(codeAnalysis)};
-        }
+            return VMInstance{analyze(codeHash, code, mode)};
         default:
             BOOST_THROW_EXCEPTION(UnknownVMError{});
         }
     }
+
+    // The analysis for the interpreter chosen by the analysis policy, served by the analysis cache
+    CodeAnalysis analyze(const bcos::h256& codeHash, std::string_view code, evmc_revision mode)
+    {
+        return m_codeAnalysisCache.get(codeHash, code, mode);
+    }
+
+    void setAnalysisPolicy(AnalysisPolicy policy) { m_codeAnalysisCache.setPolicy(policy); }
+    CodeAnalysisStatistic const& codeAnalysisStatistic() const
+    {
+        return m_codeAnalysisCache.statistic();
+    }
+    CodeAnalysisCache& codeAnalysisCache() & { return m_codeAnalysisCache; }
+
+    CodeCache& codeCache() & { return m_codeCache; }
 };
 }  // namespace bcos::transaction_executor
\ No newline at end of file
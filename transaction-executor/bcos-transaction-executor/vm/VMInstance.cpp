@@ -1,4 +1,6 @@
 #include "VMInstance.h"
+#include <evmone/execution_state.hpp>
+#include <evmone/vm.hpp>
 
 void bcos::transaction_executor::VMInstance::ReleaseEVMC::operator()(evmc_vm* ptr) const noexcept
 {
@@ -29,6 +31,15 @@ bcos::transaction_executor::EVMCResult bcos::transaction_executor::VMInstance::e
                               auto state = evmone::advanced::AdvancedExecutionState(*msg, rev,
                                   *host, context, std::basic_string_view<uint8_t>(code, codeSize));
                               return EVMCResult(evmone::advanced::execute(state, *instance));
+                          },
+                          [&](EVMC_BASELINE_ANALYSIS const& instance) {
+                              // The baseline interpreter reads its options from the vm only
+                              static EVMC_VM const baselineVM{evmc_create_evmone()};
+                              evmone::ExecutionState state(*msg, rev, *host, context,
+                                  std::basic_string_view<uint8_t>(code, codeSize));
+                              return EVMCResult(evmone::baseline::execute(
+                                  *static_cast<evmone::VM const*>(baselineVM.get()), msg->gas,
+                                  state, *instance));
                           }},
         m_instance);
 }
@@ -23,11 +23,13 @@
 
 #pragma once
 #include "../Common.h"
+#include "CodeAnalysisCache.h"
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Overloaded.h>
 #include <evmc/evmc.h>
 #include <evmone/advanced_analysis.hpp>
 #include <evmone/advanced_execution.hpp>
+#include <evmone/baseline.hpp>
 #include <variant>
 
 namespace bcos::transaction_executor
@@ -46,14 +48,15 @@ private:
     };
     using EVMC_VM = std::unique_ptr<evmc_vm, ReleaseEVMC>;
     using EVMC_ANALYSIS_RESULT = std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>;
-    std::variant<EVMC_VM, EVMC_ANALYSIS_RESULT> m_instance;
+    using EVMC_BASELINE_ANALYSIS = std::shared_ptr<evmone::baseline::CodeAnalysis const>;
+    std::variant<EVMC_VM, EVMC_ANALYSIS_RESULT, EVMC_BASELINE_ANALYSIS> m_instance;
 
 public:
     template <class Instance>
     explicit VMInstance(Instance instance) noexcept
         requires std::same_as<Instance, evmc_vm*> ||
-                 std::same_as<Instance,
-                     std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>>
+                 std::same_as<Instance, EVMC_ANALYSIS_RESULT> ||
+                 std::same_as<Instance, EVMC_BASELINE_ANALYSIS>
     {
         if constexpr (std::is_same_v<Instance, evmc_vm*>)
         {
@@ -68,9 +71,13 @@ public:
         }
         else
         {
-            m_instance.emplace<EVMC_ANALYSIS_RESULT>(std::move(instance));
+            m_instance.emplace<Instance>(std::move(instance));
         }
     }
+    explicit VMInstance(CodeAnalysis analysis) noexcept
+    {
+        std::visit([this](auto& analysis) { m_instance = std::move(analysis); }, analysis);
+    }
     ~VMInstance() noexcept = default;
 
     VMInstance(VMInstance const&) = delete;
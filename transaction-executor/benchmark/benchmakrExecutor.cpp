@@ -2,6 +2,7 @@
 #include "../tests/TestBytecode.h"
 #include "bcos-codec/bcos-codec/abi/ContractABICodec.h"
 #include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-framework/transaction-executor/ExecutionArena.h"
 #include "bcos-framework/protocol/Protocol.h"
 #include "bcos-tars-protocol/protocol/BlockHeaderImpl.h"
 #include "bcos-tars-protocol/protocol/TransactionImpl.h"
@@ -12,6 +13,9 @@
 #include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
 #include <bcos-task/Wait.h>
 #include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 
 using namespace bcos;
 using namespace bcos::storage2::memory_storage;
@@ -22,6 +26,26 @@ using ReceiptFactory = bcostars::protocol::TransactionReceiptFactoryImpl;
 
 bcos::crypto::Hash::Ptr bcos::transaction_executor::GlobalHashImpl::g_hashImpl;
 
+// Count the heap allocations, reported per iteration by the benchmarks comparing the arena
+static std::atomic_int64_t g_allocations = 0;
+void* operator new(size_t size)
+{
+    ++g_allocations;
+    if (auto* pointer = std::malloc(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+void operator delete(void* pointer, size_t /*unused*/) noexcept
+{
+    std::free(pointer);
+}
+
 struct Fixture
 {
     Fixture()
@@ -88,7 +112,7 @@ static void create(benchmark::State& state)
     }(state, transaction));
 }
 
-static void call_setInt(benchmark::State& state)
+static void setInt(benchmark::State& state, bool withArena)
 {
     Fixture fixture;
     std::string contractAddress = fixture.deployContract();
@@ -98,9 +122,11 @@ static void call_setInt(benchmark::State& state)
 
     bcos::codec::abi::ContractABICodec abiCodec(
         bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+    ExecutionArena arena;
 
     task::syncWait([&](benchmark::State& state) -> task::Task<void> {
         int contextID = 0;
+        auto allocations = g_allocations.load();
         for (auto const& it : state)
         {
             auto input = abiCodec.abiIn("setInt(int256)", bcos::s256(contextID));
@@ -109,13 +135,36 @@ static void call_setInt(benchmark::State& state)
             transaction.mutableInner().dataHash.resize(1);
 
             ++contextID;
-            [[maybe_unused]] auto receipt =
-                co_await bcos::transaction_executor::execute(fixture.m_executor,
-                    fixture.m_backendStorage, fixture.blockHeader, transaction, contextID);
+            if (withArena)
+            {
+                [[maybe_unused]] auto receipt = co_await bcos::transaction_executor::execute(
+                    fixture.m_executor, fixture.m_backendStorage, fixture.blockHeader,
+                    transaction, contextID, arena.resource());
+                arena.reset();
+            }
+            else
+            {
+                [[maybe_unused]] auto receipt =
+                    co_await bcos::transaction_executor::execute(fixture.m_executor,
+                        fixture.m_backendStorage, fixture.blockHeader, transaction, contextID);
+            }
         }
+        state.counters["allocations"] = benchmark::Counter(
+            static_cast<double>(g_allocations.load() - allocations),
+            benchmark::Counter::kAvgIterations);
     }(state));
 }
 
+static void call_setInt(benchmark::State& state)
+{
+    setInt(state, false);
+}
+
+static void call_setInt_arena(benchmark::State& state)
+{
+    setInt(state, true);
+}
+
 static void call_setString(benchmark::State& state)
 {
     Fixture fixture;
@@ -198,6 +247,7 @@ static void call_deployAndCall(benchmark::State& state)
 
 BENCHMARK(create);
 BENCHMARK(call_setInt);
+BENCHMARK(call_setInt_arena);
 BENCHMARK(call_setString);
 BENCHMARK(call_delegateCall);
 BENCHMARK(call_deployAndCall);
@@ -78,6 +78,7 @@ public:
 
         bcostars::protocol::BlockHeaderImpl blockHeader(
             [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        blockHeader.setNumber(blockNumber);
         evmc_message message = {.kind = EVMC_CALL,
             .flags = 0,
             .depth = 0,
@@ -107,6 +108,7 @@ public:
     evmc_address helloworldAddress;
     VMFactory vmFactory;
     int64_t seq = 0;
+    int64_t blockNumber = 0;
     std::optional<PrecompiledManager> precompiledManager;
 };
 
@@ -173,6 +175,87 @@ BOOST_AUTO_TEST_CASE(contractDeploy)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(codeCache)
+{
+    syncWait([this]() -> Task<void> {
+        // the contract created in block 0 is not cached before block 0 is committed
+        auto result1 = co_await call("getInt()");
+        BOOST_CHECK_EQUAL(result1.status_code, 0);
+        BOOST_CHECK_EQUAL(vmFactory.codeCache().size(), 0);
+
+        vmFactory.codeCache().setCommittedBlock(0);
+        blockNumber = 2;
+        auto result2 = co_await call("setInt(int256)", bcos::s256(10000));
+        BOOST_CHECK_EQUAL(result2.status_code, 0);
+        BOOST_CHECK_EQUAL(vmFactory.codeCache().size(), 1);
+        auto cachedCode = vmFactory.codeCache().get(helloworldAddress);
+        BOOST_REQUIRE(cachedCode);
+        BOOST_CHECK_GT(cachedCode->code.size(), 0);
+
+        auto result3 = co_await call("getInt()");
+        BOOST_CHECK_EQUAL(result3.status_code, 0);
+        bcos::s256 getIntResult = -1;
+        bcos::codec::abi::ContractABICodec abiCodec(
+            bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+        abiCodec.abiOut(
+            bcos::bytesConstRef(result3.output_data, result3.output_size), getIntResult);
+        BOOST_CHECK_EQUAL(getIntResult, 10000);
+
+        // the contract created and called in the same block is read from the storage
+        auto result4 = co_await call("deployAndCall(int256)", bcos::s256(999));
+        BOOST_CHECK_EQUAL(result4.status_code, 0);
+        BOOST_CHECK_EQUAL(vmFactory.codeCache().size(), 1);
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(interpreterSelection)
+{
+    // the hello world code runs on the baseline interpreter until its third call
+    vmFactory.setAnalysisPolicy(
+        AnalysisPolicy{.interpreter = Interpreter::adaptive, .advancedCalls = 3});
+    syncWait([this]() -> Task<void> {
+        auto const& statistic = vmFactory.codeAnalysisStatistic();
+        auto misses = statistic.misses.load();
+        auto promotions = statistic.promotions.load();
+
+        auto result1 = co_await call("setInt(int256)", bcos::s256(10000));
+        BOOST_CHECK_EQUAL(result1.status_code, 0);
+        BOOST_CHECK_EQUAL(statistic.misses, misses + 1);
+        auto result2 = co_await call("getInt()");
+        BOOST_CHECK_EQUAL(result2.status_code, 0);
+        BOOST_CHECK_EQUAL(statistic.promotions, promotions);
+        auto result3 = co_await call("getInt()");
+        BOOST_CHECK_EQUAL(result3.status_code, 0);
+        BOOST_CHECK_EQUAL(statistic.promotions, promotions + 1);
+        BOOST_CHECK_EQUAL(vmFactory.codeAnalysisCache().size(), 1);
+
+        bcos::s256 getIntResult = -1;
+        bcos::codec::abi::ContractABICodec abiCodec(
+            bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+        auto result4 = co_await call("getInt()");
+        abiCodec.abiOut(
+            bcos::bytesConstRef(result4.output_data, result4.output_size), getIntResult);
+        BOOST_CHECK_EQUAL(getIntResult, 10000);
+
+        // the analysis over the budget is not cached
+        vmFactory.setAnalysisPolicy(
+            AnalysisPolicy{.interpreter = Interpreter::baseline, .maxCacheBytes = 16});
+        BOOST_CHECK_EQUAL(vmFactory.codeAnalysisCache().size(), 0);
+        auto uncached = statistic.uncached.load();
+        auto result5 = co_await call("getInt()");
+        abiCodec.abiOut(
+            bcos::bytesConstRef(result5.output_data, result5.output_size), getIntResult);
+        BOOST_CHECK_EQUAL(getIntResult, 10000);
+        BOOST_CHECK_EQUAL(statistic.uncached, uncached + 1);
+        BOOST_CHECK_EQUAL(vmFactory.codeAnalysisCache().size(), 0);
+        BOOST_CHECK_EQUAL(statistic.promotions, promotions + 1);
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_CASE(createTwice)
 {
     syncWait([this]() -> Task<void> {
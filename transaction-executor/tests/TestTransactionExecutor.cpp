@@ -1,6 +1,8 @@
 #include "../bcos-transaction-executor/TransactionExecutorImpl.h"
 #include "TestBytecode.h"
 #include "bcos-codec/bcos-codec/abi/ContractABICodec.h"
+#include "bcos-framework/executor/PrecompiledTypeDef.h"
+#include "bcos-framework/transaction-executor/ExecutionArena.h"
 #include <bcos-crypto/hash/Keccak256.h>
 #include <bcos-tars-protocol/protocol/BlockHeaderImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
@@ -77,4 +79,96 @@ BOOST_AUTO_TEST_CASE(execute)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(executeWithArena)
+{
+    task::syncWait([this]() mutable -> task::Task<void> {
+        memory_storage::MemoryStorage<StateKey, StateValue, memory_storage::ORDERED> storage;
+
+        auto cryptoSuite = std::make_shared<bcos::crypto::CryptoSuite>(
+            bcos::transaction_executor::GlobalHashImpl::g_hashImpl, nullptr, nullptr);
+        bcostars::protocol::TransactionReceiptFactoryImpl receiptFactory(cryptoSuite);
+
+        bcos::transaction_executor::TransactionExecutorImpl executor(
+            receiptFactory, *precompiledManager);
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        blockHeader.setVersion((uint32_t)bcos::protocol::BlockVersion::V3_1_VERSION);
+
+        bcostars::protocol::TransactionFactoryImpl transactionFactory(cryptoSuite);
+        ExecutionArena arena;
+
+        bcos::bytes helloworldBytecodeBinary;
+        boost::algorithm::unhex(helloworldBytecode, std::back_inserter(helloworldBytecodeBinary));
+        auto transaction =
+            transactionFactory.createTransaction(0, "", helloworldBytecodeBinary, {}, 0, "", "", 0);
+        auto receipt = co_await bcos::transaction_executor::execute(
+            executor, storage, blockHeader, *transaction, 0, arena.resource());
+        arena.reset();
+        BOOST_CHECK_EQUAL(receipt->status(), 0);
+
+        // The receipts and the storage do not refer to the reset arena
+        bcos::codec::abi::ContractABICodec abiCodec(
+            bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+        for (auto value : {bcos::s256(10099), bcos::s256(-1)})
+        {
+            auto input = abiCodec.abiIn("setInt(int256)", value);
+            auto transaction2 = transactionFactory.createTransaction(
+                0, std::string(receipt->contractAddress()), input, {}, 0, "", "", 0);
+            auto receipt2 = co_await bcos::transaction_executor::execute(
+                executor, storage, blockHeader, *transaction2, 1, arena.resource());
+            arena.reset();
+            BOOST_CHECK_EQUAL(receipt2->status(), 0);
+
+            auto input2 = abiCodec.abiIn("getInt()");
+            auto transaction3 = transactionFactory.createTransaction(
+                0, std::string(receipt->contractAddress()), input2, {}, 0, "", "", 0);
+            auto receipt3 = co_await bcos::transaction_executor::execute(
+                executor, storage, blockHeader, *transaction3, 2, arena.resource());
+            arena.reset();
+            BOOST_CHECK_EQUAL(receipt3->status(), 0);
+            bcos::s256 getIntResult = 0;
+            abiCodec.abiOut(receipt3->output(), getIntResult);
+            BOOST_CHECK_EQUAL(getIntResult, value);
+        }
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(predictWithTruncatedCalldata)
+{
+    auto cryptoSuite = std::make_shared<bcos::crypto::CryptoSuite>(
+        bcos::transaction_executor::GlobalHashImpl::g_hashImpl, nullptr, nullptr);
+    bcostars::protocol::TransactionReceiptFactoryImpl receiptFactory(cryptoSuite);
+    bcos::transaction_executor::TransactionExecutorImpl executor(
+        receiptFactory, *precompiledManager);
+    bcostars::protocol::TransactionFactoryImpl transactionFactory(cryptoSuite);
+
+    bcos::codec::abi::ContractABICodec abiCodec(
+        bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+    auto input = abiCodec.abiIn("userTransfer(string,string,uint256)", std::string("alice"),
+        std::string("bob"), bcos::u256(1));
+    auto transaction = transactionFactory.createTransaction(
+        0, bcos::precompiled::DAG_TRANSFER_ADDRESS, input, {}, 0, "", "", 0);
+    auto keys = bcos::transaction_executor::predictConflictKeys(executor, *transaction);
+    BOOST_REQUIRE(keys);
+    BOOST_REQUIRE_EQUAL(keys->size(), 2);
+    // The users are the row keys of the dag transfer table
+    for (auto user : {"alice", "bob"})
+    {
+        BOOST_CHECK(std::find(keys->begin(), keys->end(),
+                        StateKey{bcos::ledger::DAG_TRANSFER, user}) != keys->end());
+    }
+
+    // Cut in the middle of the arguments and in the middle of the selector
+    for (auto size : {input.size() / 2, 2LU})
+    {
+        auto truncated = bcos::bytes(input.begin(), input.begin() + (long)size);
+        auto truncatedTransaction = transactionFactory.createTransaction(
+            0, bcos::precompiled::DAG_TRANSFER_ADDRESS, truncated, {}, 0, "", "", 0);
+        std::optional<std::vector<StateKey>> truncatedKeys;
+        BOOST_CHECK_NO_THROW(truncatedKeys = bcos::transaction_executor::predictConflictKeys(
+                                 executor, *truncatedTransaction));
+        BOOST_CHECK(!truncatedKeys);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
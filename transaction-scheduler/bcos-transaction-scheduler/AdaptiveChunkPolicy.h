@@ -0,0 +1,97 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace bcos::transaction_scheduler
+{
+
+// Choose chunk size and pipeline token count of the parallel scheduler from the RAW conflict rate
+// and chunk execution time of the recent blocks
+class AdaptiveChunkPolicy
+{
+private:
+    constexpr static double SMOOTHING_FACTOR = 0.5;
+    constexpr static double HIGH_CONFLICT_RATE = 0.2;
+    constexpr static double LOW_CONFLICT_RATE = 0.02;
+    constexpr static int64_t MIN_CHUNK_TIME_US = 200;
+    constexpr static int64_t MAX_CHUNK_TIME_US = 20000;
+
+    size_t m_minChunkSize;
+    size_t m_maxChunkSize;
+    size_t m_maxToken;
+
+    size_t m_chunkSize;
+    size_t m_token;
+    double m_conflictRate = 0;
+    double m_chunkTime = 0;
+    bool m_initialized = false;
+
+public:
+    AdaptiveChunkPolicy(
+        size_t minChunkSize, size_t maxChunkSize, size_t maxToken, size_t initialChunkSize)
+      : m_minChunkSize(minChunkSize),
+        m_maxChunkSize(maxChunkSize),
+        m_maxToken(std::max<size_t>(maxToken, 1)),
+        m_chunkSize(std::clamp(initialChunkSize, minChunkSize, maxChunkSize)),
+        m_token(m_maxToken)
+    {}
+
+    size_t chunkSize() const { return m_chunkSize; }
+    double conflictRate() const { return m_conflictRate; }
+    double chunkTime() const { return m_chunkTime; }
+
+    // No more tokens than chunks in the block
+    size_t maxToken(size_t transactionCount) const
+    {
+        auto chunkCount = (transactionCount + m_chunkSize - 1) / m_chunkSize;
+        return std::clamp<size_t>(chunkCount, 1, m_token);
+    }
+
+    void setMaxToken(size_t maxToken)
+    {
+        m_maxToken = std::max<size_t>(maxToken, 1);
+        m_token = std::min(m_token, m_maxToken);
+    }
+
+    void update(size_t chunkCount, size_t conflictChunkCount, int64_t totalChunkTimeUS)
+    {
+        if (chunkCount == 0)
+        {
+            return;
+        }
+
+        auto conflictRate = static_cast<double>(conflictChunkCount) / chunkCount;
+        auto chunkTime = static_cast<double>(totalChunkTimeUS) / chunkCount;
+        if (!m_initialized)
+        {
+            m_conflictRate = conflictRate;
+            m_chunkTime = chunkTime;
+            m_initialized = true;
+        }
+        else
+        {
+            m_conflictRate =
+                SMOOTHING_FACTOR * conflictRate + (1 - SMOOTHING_FACTOR) * m_conflictRate;
+            m_chunkTime = SMOOTHING_FACTOR * chunkTime + (1 - SMOOTHING_FACTOR) * m_chunkTime;
+        }
+
+        // Smaller chunks lose less work on conflict, bigger chunks amortize the pipeline overhead
+        if (m_conflictRate > HIGH_CONFLICT_RATE && m_chunkTime > MIN_CHUNK_TIME_US)
+        {
+            m_chunkSize = std::max(m_minChunkSize, m_chunkSize / 2);
+        }
+        else if ((m_conflictRate < LOW_CONFLICT_RATE || m_chunkTime < MIN_CHUNK_TIME_US) &&
+                 m_chunkTime < MAX_CHUNK_TIME_US)
+        {
+            m_chunkSize = std::min(m_maxChunkSize, m_chunkSize * 2);
+        }
+
+        // Chunks executed ahead of a conflict are wasted, keep less of them in flight
+        m_token = std::clamp<size_t>(
+            static_cast<size_t>(std::lround(m_maxToken * (1 - m_conflictRate))), 1, m_maxToken);
+    }
+};
+
+}  // namespace bcos::transaction_scheduler
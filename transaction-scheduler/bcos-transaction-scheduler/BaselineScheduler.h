@@ -1,5 +1,7 @@
 #pragma once
 
+#include "CallStorage.h"
+#include "bcos-framework/Common.h"
 #include "bcos-framework/ledger/LedgerConfig.h"
 #include "bcos-framework/protocol/BlockHeader.h"
 #include "bcos-framework/protocol/BlockHeaderFactory.h"
@@ -16,16 +18,19 @@
 #include <bcos-framework/protocol/BlockFactory.h>
 #include <bcos-framework/protocol/TransactionSubmitResultFactory.h>
 #include <bcos-framework/txpool/TxPoolInterface.h>
+#include <bcos-task/Coroutine.h>
 #include <bcos-task/Wait.h>
 #include <bcos-utilities/ITTAPI.h>
 #include <fmt/format.h>
 #include <ittnotify.h>
 #include <oneapi/tbb/combinable.h>
 #include <oneapi/tbb/parallel_invoke.h>
+#include <oneapi/tbb/task_arena.h>
 #include <oneapi/tbb/task_group.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
 #include <chrono>
+#include <deque>
 #include <exception>
 #include <memory>
 #include <type_traits>
@@ -44,6 +49,9 @@ template <class MultiLayerStorage, class Executor, class SchedulerImpl,
 class BaselineScheduler : public scheduler::SchedulerInterface
 {
 private:
+    constexpr static size_t DEFAULT_MAX_INFLIGHT_BLOCKS = 4;
+    constexpr static int DEFAULT_CALL_CONCURRENCY = 4;
+
     MultiLayerStorage& m_multiLayerStorage;
     SchedulerImpl& m_schedulerImpl;
     Executor& m_executor;
@@ -71,6 +79,72 @@ private:
     };
     std::list<ExecuteResult> m_results;
     std::mutex m_resultsMutex;
+    size_t m_maxInflightBlocks = DEFAULT_MAX_INFLIGHT_BLOCKS;
+    // The executes waiting for a free slot of the pipeline, guarded by m_resultsMutex, each
+    // commit resumes the oldest one on m_executeGroup
+    std::deque<CO_STD::coroutine_handle<>> m_slotWaiters;
+    tbb::task_group m_executeGroup;
+
+    // Suspend the execute until fewer than m_maxInflightBlocks blocks are uncommitted, the
+    // thread of the caller is not blocked meanwhile
+    struct FreeSlotAwaitable
+    {
+        BaselineScheduler& m_scheduler;
+
+        constexpr static bool await_ready() noexcept { return false; }
+        bool await_suspend(CO_STD::coroutine_handle<> handle)
+        {
+            std::unique_lock resultsLock(m_scheduler.m_resultsMutex);
+            if (m_scheduler.m_results.size() < m_scheduler.m_maxInflightBlocks)
+            {
+                return false;
+            }
+            m_scheduler.m_slotWaiters.push_back(handle);
+            return true;
+        }
+        constexpr static void await_resume() noexcept {}
+    };
+
+    // Snapshot of the last committed state shared by the calls, replaced by every commit. The
+    // view pins a snapshot of the backend, so a call never sees a half merged later block
+    struct CallContext
+    {
+        typename MultiLayerStorage::View m_view;
+        protocol::BlockHeader::ConstPtr m_blockHeader;
+    };
+    std::shared_ptr<CallContext> m_callContext;
+    std::mutex m_callContextMutex;
+    // Calls run on their own arena, so that they can't starve block execution
+    std::unique_ptr<tbb::task_arena> m_callArena;
+    tbb::task_group m_callGroup;
+
+    std::shared_ptr<CallContext> callContext()
+    {
+        std::unique_lock lock(m_callContextMutex);
+        if (!m_callContext)
+        {
+            // Nothing committed since started, call on the current block of the ledger
+            auto view = m_multiLayerStorage.forkCommitted(false);
+            auto status = task::syncWait(m_ledger.getStatus());
+            auto blockHeader = task::syncWait(m_ledger.getBlockHeader(status.blockNumber));
+            if (!blockHeader)
+            {
+                BOOST_THROW_EXCEPTION(std::runtime_error(
+                    fmt::format("Missing header of the current block: {}", status.blockNumber)));
+            }
+            m_callContext = std::make_shared<CallContext>(
+                CallContext{std::move(view), std::move(blockHeader)});
+        }
+        return m_callContext;
+    }
+    void setCallContext(protocol::BlockHeader::ConstPtr blockHeader)
+    {
+        // The oldest layer is the block committing, taken before it is merged and popped
+        auto context = std::make_shared<CallContext>(
+            CallContext{m_multiLayerStorage.forkCommitted(true), std::move(blockHeader)});
+        std::unique_lock lock(m_callContextMutex);
+        m_callContext = std::move(context);
+    }
 
     task::Task<std::vector<protocol::Transaction::ConstPtr>> getTransactions(
         protocol::Block& block) const
@@ -144,13 +218,23 @@ private:
                               [&block](uint64_t index) { return block.transactionHash(index); });
             merkle.generateMerkle(hashes, merkleTrie);
         }
-        // TODO: write merkle into storage
+        // The tree is stored by the ledger with the block, see setMerkleTree in LedgerImpl2
         return *RANGES::rbegin(merkleTrie);
     }
 
     task::Task<bcos::h256> calcauteStateRoot(
         auto& storage, protocol::BlockHeader const& blockHeader, crypto::Hash const& hashImpl)
     {
+        if constexpr (requires { m_schedulerImpl.lastStateHash(); })
+        {
+            // Accumulated by the scheduler while merging the chunks
+            if (auto const& stateHash = m_schedulerImpl.lastStateHash())
+            {
+                m_multiLayerStorage.pushMutableToImmutableFront();
+                co_return *stateHash;
+            }
+        }
+
         auto it = co_await storage.seek(storage2::STORAGE_BEGIN);
 
         static constexpr int HASH_CHUNK_SIZE = 32;
@@ -249,6 +333,11 @@ private:
         try
         {
             auto blockHeader = block->blockHeaderConst();
+            // Backpressure, wait for the oldest block to commit when the pipeline is full, the
+            // execute lock is not held meanwhile so that the wait can resume on another thread
+            co_await FreeSlotAwaitable{*this};
+
+            // Blocks are executed one by one, each on top of the uncommitted blocks before it
             std::unique_lock executeLock(m_executeMutex, std::try_to_lock);
             if (!executeLock.owns_lock())
             {
@@ -385,19 +474,62 @@ private:
 
             auto result = std::move(m_results.back());
             m_results.pop_back();
+            // The next block executes while this one is committing
+            if (!m_slotWaiters.empty())
+            {
+                m_executeGroup.run([handle = m_slotWaiters.front()]() { handle.resume(); });
+                m_slotWaiters.pop_front();
+            }
             resultsLock.unlock();
+            setCallContext(header);
 
             result.m_block->setBlockHeader(header);
-            auto lastStorage = m_multiLayerStorage.lastImmutableStorage();
+            // Block data goes with the oldest layer in one write, without touching the layer
+            // which may be encoding in background
+            typename MultiLayerStorage::MutableStorage blockStorage;
             co_await writeBlockAndTransactions(
-                *lastStorage, m_ledger, *(result.m_block), result.m_transactions);
-            co_await m_multiLayerStorage.mergeAndPopImmutableBack();
+                blockStorage, m_ledger, *(result.m_block), result.m_transactions);
+            co_await m_multiLayerStorage.mergeAndPopImmutableBack(blockStorage);
+            if constexpr (requires { m_executor.setCommittedBlock(header->number()); })
+            {
+                m_executor.setCommittedBlock(header->number());
+            }
 
             // Write states
             auto ledgerConfig =
                 std::make_shared<ledger::LedgerConfig>(co_await m_ledger.getConfig());
             ledgerConfig->setHash(header->hash());
             BASELINE_SCHEDULER_LOG(INFO) << "Commit block finished: " << header->number();
+            if constexpr (requires { m_multiLayerStorage.layerHitStatistic(); })
+            {
+                if (auto const* statistic = m_multiLayerStorage.layerHitStatistic())
+                {
+                    std::string immutableHits;
+                    for (size_t depth = 0;
+                         depth < std::remove_cvref_t<decltype(*statistic)>::MAX_IMMUTABLE_DEPTH;
+                         ++depth)
+                    {
+                        immutableHits += std::to_string(statistic->immutableHits(depth)) + ",";
+                    }
+                    BASELINE_SCHEDULER_LOG(DEBUG)
+                        << METRIC << "Layer hits, mutable: " << statistic->mutableHits()
+                        << " immutable: " << immutableHits
+                        << " filterSkips: " << statistic->filterSkips()
+                        << " cache: " << statistic->cacheHits()
+                        << " backend: " << statistic->backendReads();
+                }
+            }
+            if constexpr (requires { m_executor.codeAnalysisStatistic(); })
+            {
+                auto const& statistic = m_executor.codeAnalysisStatistic();
+                BASELINE_SCHEDULER_LOG(DEBUG)
+                    << METRIC << "Code analysis cache, hits: " << statistic.hits.load()
+                    << " misses: " << statistic.misses.load()
+                    << " evictions: " << statistic.evictions.load()
+                    << " promotions: " << statistic.promotions.load()
+                    << " uncached: " << statistic.uncached.load()
+                    << " bytes: " << statistic.bytes.load();
+            }
             commitLock.unlock();
 
             m_notifyGroup.run([this, result = std::move(result)]() {
@@ -466,13 +598,32 @@ public:
         m_ledger(ledger),
         m_txpool(txPool),
         m_transactionSubmitResultFactory(transactionSubmitResultFactory),
-        m_hashImpl(hashImpl)
-    {}
+        m_hashImpl(hashImpl),
+        m_callArena(std::make_unique<tbb::task_arena>(DEFAULT_CALL_CONCURRENCY))
+    {
+        if constexpr (requires { m_schedulerImpl.setStateHashImpl(std::addressof(hashImpl)); })
+        {
+            m_schedulerImpl.setStateHashImpl(std::addressof(m_hashImpl));
+        }
+    }
     BaselineScheduler(const BaselineScheduler&) = delete;
     BaselineScheduler(BaselineScheduler&&) noexcept = default;
     BaselineScheduler& operator=(const BaselineScheduler&) = delete;
     BaselineScheduler& operator=(BaselineScheduler&&) noexcept = default;
-    ~BaselineScheduler() noexcept override = default;
+    ~BaselineScheduler() noexcept override
+    {
+        m_callArena->execute([this]() { m_callGroup.wait(); });
+        m_executeGroup.wait();
+        m_notifyGroup.wait();
+    }
+
+    // At most maxInflightBlocks executed but uncommitted blocks, executing one more waits for
+    // the oldest one to be committed before it starts
+    void setMaxInflightBlocks(size_t maxInflightBlocks)
+    {
+        std::unique_lock resultsLock(m_resultsMutex);
+        m_maxInflightBlocks = std::max<size_t>(maxInflightBlocks, 1);
+    }
 
     void executeBlock(bcos::protocol::Block::Ptr block, bool verify,
         std::function<void(bcos::Error::Ptr&&, bcos::protocol::BlockHeader::Ptr&&, bool sysBlock)>
@@ -500,21 +651,39 @@ public:
         callback({}, {});
     }
 
+    // Max threads of the calls, must be set before any call
+    void setCallConcurrency(int concurrency)
+    {
+        m_callArena = std::make_unique<tbb::task_arena>(std::max(concurrency, 1));
+    }
+
     void call(protocol::Transaction::Ptr transaction,
         std::function<void(Error::Ptr&&, protocol::TransactionReceipt::Ptr&&)> callback) override
     {
-        task::wait([](decltype(this) self, protocol::Transaction::Ptr transaction,
-                       decltype(callback) callback) -> task::Task<void> {
-            // TODO: Use real block number and storage block header version
-            auto blockHeader = self->m_blockHeaderFactory.createBlockHeader();
-            blockHeader->setVersion((uint32_t)bcos::protocol::BlockVersion::V3_3_VERSION);
-            auto view = self->m_multiLayerStorage.fork(false);
-            view.newTemporaryMutable();
-            auto receipt = co_await transaction_executor::execute(
-                self->m_executor, view, *blockHeader, *transaction, 0);
-
-            callback(nullptr, std::move(receipt));
-        }(this, std::move(transaction), std::move(callback)));
+        m_callArena->execute([&, this]() {
+            m_callGroup.run([this, transaction = std::move(transaction),
+                                callback = std::move(callback)]() mutable {
+                try
+                {
+                    auto context = callContext();
+                    CallStorage<typename MultiLayerStorage::View,
+                        typename MultiLayerStorage::MutableStorage>
+                        storage(context->m_view);
+                    auto receipt = task::syncWait(transaction_executor::execute(
+                        m_executor, storage, *context->m_blockHeader, *transaction, 0));
+                    callback(nullptr, std::move(receipt));
+                }
+                catch (std::exception& e)
+                {
+                    auto message =
+                        fmt::format("Call failed! {}", boost::diagnostic_information(e));
+                    BASELINE_SCHEDULER_LOG(ERROR) << message;
+                    callback(
+                        BCOS_ERROR_UNIQUE_PTR(scheduler::SchedulerError::UnknownError, message),
+                        nullptr);
+                }
+            });
+        });
     }
 
     void reset([[maybe_unused]] std::function<void(Error::Ptr&&)> callback) override
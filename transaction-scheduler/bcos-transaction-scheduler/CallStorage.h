@@ -0,0 +1,131 @@
+#pragma once
+#include "bcos-framework/storage2/Storage.h"
+#include <bcos-task/AwaitableValue.h>
+#include <bcos-task/Task.h>
+#include <boost/container/small_vector.hpp>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace bcos::transaction_scheduler
+{
+
+// Storage of a read only call over a snapshot shared by the concurrent calls. The writes of the
+// call are kept in a private overlay created on the first write, so a call that only reads never
+// allocates one
+template <class Snapshot, class OverlayStorage>
+class CallStorage
+{
+private:
+    using KeyType = std::remove_cvref_t<typename OverlayStorage::Key>;
+    using ValueType = std::remove_cvref_t<typename OverlayStorage::Value>;
+
+    Snapshot& m_snapshot;
+    std::unique_ptr<OverlayStorage> m_overlay;
+
+    OverlayStorage& overlay()
+    {
+        if (!m_overlay)
+        {
+            m_overlay = std::make_unique<OverlayStorage>();
+        }
+        return *m_overlay;
+    }
+
+public:
+    class ReadIterator
+    {
+        friend class CallStorage;
+
+    private:
+        boost::container::small_vector<std::tuple<KeyType, std::optional<ValueType>>, 1>
+            m_keyValues;
+        int64_t m_index = -1;
+
+    public:
+        using Key = KeyType const&;
+        using Value = ValueType const&;
+
+        task::AwaitableValue<bool> next()
+        {
+            return {static_cast<size_t>(++m_index) != m_keyValues.size()};
+        }
+        task::AwaitableValue<Key> key() const { return {std::get<0>(m_keyValues[m_index])}; }
+        task::AwaitableValue<Value> value() const
+        {
+            return {*(std::get<1>(m_keyValues[m_index]))};
+        }
+        task::AwaitableValue<bool> hasValue() const
+        {
+            return {std::get<1>(m_keyValues[m_index]).has_value()};
+        }
+    };
+
+    using Key = KeyType;
+    using Value = ValueType;
+
+    explicit CallStorage(Snapshot& snapshot) : m_snapshot(snapshot) {}
+
+    bool hasWrites() const { return m_overlay != nullptr; }
+
+    task::Task<ReadIterator> read(RANGES::input_range auto const& keys)
+    {
+        ReadIterator iterator;
+        iterator.m_keyValues = RANGES::views::transform(keys, [](auto&& key) {
+            return std::tuple<KeyType, std::optional<ValueType>>(
+                std::forward<decltype(key)>(key), std::optional<ValueType>{});
+        }) | RANGES::to<decltype(iterator.m_keyValues)>();
+
+        if (m_overlay)
+        {
+            auto it = co_await m_overlay->read(keys);
+            auto keyValueIt = RANGES::begin(iterator.m_keyValues);
+            while (co_await it.next())
+            {
+                if (co_await it.hasValue())
+                {
+                    std::get<1>(*keyValueIt).emplace(co_await it.value());
+                }
+                RANGES::advance(keyValueIt, 1);
+            }
+        }
+
+        auto missingIndexes =
+            RANGES::views::iota(size_t{0}, iterator.m_keyValues.size()) |
+            RANGES::views::filter(
+                [&](size_t index) { return !std::get<1>(iterator.m_keyValues[index]); }) |
+            RANGES::to<boost::container::small_vector<size_t, 1>>();
+        if (!missingIndexes.empty())
+        {
+            auto it = co_await m_snapshot.read(
+                RANGES::views::transform(missingIndexes, [&](size_t index) -> auto& {
+                    return std::get<0>(iterator.m_keyValues[index]);
+                }));
+            auto indexIt = RANGES::begin(missingIndexes);
+            while (co_await it.next())
+            {
+                if (co_await it.hasValue())
+                {
+                    std::get<1>(iterator.m_keyValues[*indexIt]).emplace(co_await it.value());
+                }
+                RANGES::advance(indexIt, 1);
+            }
+        }
+
+        co_return iterator;
+    }
+
+    task::Task<void> write(RANGES::input_range auto&& keys, RANGES::input_range auto&& values)
+    {
+        co_await overlay().write(
+            std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
+    }
+
+    task::Task<void> remove(RANGES::input_range auto const& keys)
+    {
+        co_await overlay().remove(keys);
+    }
+};
+
+}  // namespace bcos::transaction_scheduler
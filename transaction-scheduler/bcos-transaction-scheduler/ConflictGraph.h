@@ -0,0 +1,113 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::transaction_scheduler
+{
+
+// Group transactions sharing any predicted conflict key, the groups are independent of each other
+// and the transactions of a group must be executed in order
+template <class KeyType>
+class ConflictGraph
+{
+private:
+    size_t m_begin;
+    std::vector<size_t> m_parents;
+    std::unordered_map<KeyType, size_t> m_keyOwners;
+
+    size_t find(size_t index)
+    {
+        while (m_parents[index] != index)
+        {
+            m_parents[index] = m_parents[m_parents[index]];
+            index = m_parents[index];
+        }
+        return index;
+    }
+
+    void unite(size_t lhs, size_t rhs)
+    {
+        lhs = find(lhs);
+        rhs = find(rhs);
+        if (lhs != rhs)
+        {
+            // Keep the earliest transaction as root
+            if (lhs < rhs)
+            {
+                m_parents[rhs] = lhs;
+            }
+            else
+            {
+                m_parents[lhs] = rhs;
+            }
+        }
+    }
+
+public:
+    // predictions[begin, end) must all have value
+    ConflictGraph(std::vector<std::optional<std::vector<KeyType>>> const& predictions,
+        size_t begin, size_t end)
+      : m_begin(begin), m_parents(end - begin)
+    {
+        std::iota(m_parents.begin(), m_parents.end(), 0);
+        for (auto index = begin; index < end; ++index)
+        {
+            for (auto const& key : *predictions[index])
+            {
+                auto [it, inserted] = m_keyOwners.try_emplace(key, index - begin);
+                if (!inserted)
+                {
+                    unite(index - begin, it->second);
+                }
+            }
+        }
+    }
+
+    // Transaction indexes of each group, in execution order
+    std::vector<std::vector<size_t>> groups()
+    {
+        std::vector<std::vector<size_t>> groups;
+        std::vector<size_t> rootToGroup(m_parents.size(), std::numeric_limits<size_t>::max());
+        for (size_t index = 0; index < m_parents.size(); ++index)
+        {
+            auto root = find(index);
+            if (rootToGroup[root] == std::numeric_limits<size_t>::max())
+            {
+                rootToGroup[root] = groups.size();
+                groups.emplace_back();
+            }
+            groups[rootToGroup[root]].emplace_back(index + m_begin);
+        }
+        return groups;
+    }
+
+    // Pack the groups into at most binCount bins with balanced transaction count, largest groups
+    // first
+    std::vector<std::vector<size_t>> bins(size_t binCount)
+    {
+        auto allGroups = groups();
+        std::sort(allGroups.begin(), allGroups.end(),
+            [](auto const& lhs, auto const& rhs) { return lhs.size() > rhs.size(); });
+
+        std::vector<std::vector<size_t>> bins(std::max<size_t>(
+            std::min<size_t>(binCount, allGroups.size()), allGroups.empty() ? 0 : 1));
+        for (auto& group : allGroups)
+        {
+            auto& bin = *std::min_element(bins.begin(), bins.end(),
+                [](auto const& lhs, auto const& rhs) { return lhs.size() < rhs.size(); });
+            bin.insert(bin.end(), group.begin(), group.end());
+        }
+        for (auto& bin : bins)
+        {
+            std::sort(bin.begin(), bin.end());
+        }
+        return bins;
+    }
+};
+
+}  // namespace bcos::transaction_scheduler
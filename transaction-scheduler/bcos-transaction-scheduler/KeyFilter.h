@@ -0,0 +1,75 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace bcos::transaction_scheduler
+{
+
+// Bloom filter over the keys of a frozen storage layer, about 1% false positive rate. One thread
+// may insert keys while the others query
+template <class KeyType>
+class KeyFilter
+{
+private:
+    constexpr static size_t BITS_PER_KEY = 10;
+    constexpr static size_t HASH_COUNT = 3;
+    constexpr static size_t WORD_BITS = 64;
+
+    uint64_t m_mask = 0;
+    std::vector<std::atomic_uint64_t> m_words;
+
+    static uint64_t hash(auto const& key)
+    {
+        uint64_t value = std::hash<KeyType>{}(key);
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+public:
+    explicit KeyFilter(size_t expectedKeys)
+      : m_mask(std::bit_ceil(std::max<size_t>(expectedKeys * BITS_PER_KEY, WORD_BITS)) - 1),
+        m_words((m_mask + 1) / WORD_BITS)
+    {}
+
+    void insert(auto const& key)
+    {
+        auto value = hash(key);
+        auto delta = (value >> 32) | 1;
+        for (size_t i = 0; i < HASH_COUNT; ++i)
+        {
+            auto bit = value & m_mask;
+            auto& word = m_words[bit / WORD_BITS];
+            word.store(word.load(std::memory_order_relaxed) | (1ULL << (bit % WORD_BITS)),
+                std::memory_order_relaxed);
+            value += delta;
+        }
+    }
+
+    bool mayContain(auto const& key) const
+    {
+        auto value = hash(key);
+        auto delta = (value >> 32) | 1;
+        for (size_t i = 0; i < HASH_COUNT; ++i)
+        {
+            auto bit = value & m_mask;
+            if ((m_words[bit / WORD_BITS].load(std::memory_order_relaxed) &
+                    (1ULL << (bit % WORD_BITS))) == 0)
+            {
+                return false;
+            }
+            value += delta;
+        }
+        return true;
+    }
+};
+
+}  // namespace bcos::transaction_scheduler
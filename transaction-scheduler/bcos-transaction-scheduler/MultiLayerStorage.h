@@ -1,4 +1,5 @@
 #pragma once
+#include "KeyFilter.h"
 #include "bcos-framework/storage2/Storage.h"
 #include "bcos-task/Trait.h"
 #include "bcos-task/Wait.h"
@@ -6,9 +7,14 @@
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <bcos-task/AwaitableValue.h>
 #include <oneapi/tbb/parallel_invoke.h>
+#include <oneapi/tbb/task_arena.h>
 #include <oneapi/tbb/task_group.h>
 #include <boost/container/small_vector.hpp>
 #include <boost/throw_exception.hpp>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <future>
 #include <iterator>
 #include <stdexcept>
 #include <type_traits>
@@ -26,6 +32,89 @@ struct NotExistsImmutableStorageError : public bcos::Error {};
 struct UnsupportedMethod : public bcos::Error {};
 // clang-format on
 
+// Count of keys found in each layer, used to size the pipeline of uncommitted blocks. Each thread
+// counts on its own stripe so the reads share no cache line, the stripes are summed on query. It
+// takes a few KB, so only the top level storage of a scheduler keeps one
+class LayerHitStatistic
+{
+public:
+    constexpr static size_t MAX_IMMUTABLE_DEPTH = 8;
+    enum Counter : size_t
+    {
+        MUTABLE_HITS,
+        // Depth beyond MAX_IMMUTABLE_DEPTH is counted into the last one
+        IMMUTABLE_HITS,
+        FILTER_SKIPS = IMMUTABLE_HITS + MAX_IMMUTABLE_DEPTH,
+        CACHE_HITS,
+        BACKEND_READS,
+        COUNTER_COUNT
+    };
+
+    void add(size_t counter, uint64_t count)
+    {
+        m_stripes[stripeIndex()].counters[counter].fetch_add(count, std::memory_order_relaxed);
+    }
+    uint64_t get(size_t counter) const
+    {
+        uint64_t sum = 0;
+        for (auto const& stripe : m_stripes)
+        {
+            sum += stripe.counters[counter].load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    uint64_t mutableHits() const { return get(MUTABLE_HITS); }
+    uint64_t immutableHits(size_t depth) const
+    {
+        return get(IMMUTABLE_HITS + std::min(depth, MAX_IMMUTABLE_DEPTH - 1));
+    }
+    uint64_t filterSkips() const { return get(FILTER_SKIPS); }
+    uint64_t cacheHits() const { return get(CACHE_HITS); }
+    uint64_t backendReads() const { return get(BACKEND_READS); }
+
+private:
+    constexpr static size_t STRIPE_COUNT = 32;
+    struct alignas(64) Stripe
+    {
+        std::array<std::atomic_uint64_t, COUNTER_COUNT> counters = {};
+    };
+    std::array<Stripe, STRIPE_COUNT> m_stripes;
+
+    static size_t stripeIndex()
+    {
+        static std::atomic_size_t nextIndex = 0;
+        thread_local size_t index = nextIndex++ % STRIPE_COUNT;
+        return index;
+    }
+};
+
+// Backend storages with prepareMerge/commitMerge can encode a layer ahead of the durable write
+template <class BackendStorage>
+struct MergeBatchTrait
+{
+    using type = std::monostate;
+};
+template <class BackendStorage>
+    requires requires { typename BackendStorage::MergeBatch; }
+struct MergeBatchTrait<BackendStorage>
+{
+    using type = typename BackendStorage::MergeBatch;
+};
+
+// Backend storages with snapshot() can pin the committed state for a long living view
+template <class BackendStorage>
+struct BackendSnapshotTrait
+{
+    using type = std::monostate;
+};
+template <class BackendStorage>
+    requires requires { typename BackendStorage::Snapshot; }
+struct BackendSnapshotTrait<BackendStorage>
+{
+    using type = typename BackendStorage::Snapshot;
+};
+
 template <class MutableStorageType, class CachedStorage, class BackendStorage>
     requires((std::is_void_v<CachedStorage> || (!std::is_void_v<CachedStorage>)) &&
              storage2::SeekableStorage<MutableStorageType>)
@@ -38,10 +127,34 @@ private:
     static_assert(std::same_as<typename MutableStorageType::Key, typename BackendStorage::Key>);
     static_assert(std::same_as<typename MutableStorageType::Value, typename BackendStorage::Value>);
 
+    using Filter = KeyFilter<KeyType>;
+    constexpr static bool withPreparedMerge =
+        requires { typename BackendStorage::MergeBatch; };
+    using MergeBatch = typename MergeBatchTrait<BackendStorage>::type;
+    constexpr static bool withBackendSnapshot =
+        requires { typename BackendStorage::Snapshot; };
+    using BackendSnapshot = typename BackendSnapshotTrait<BackendStorage>::type;
+
+    struct PreparedMerge
+    {
+        MergeBatch m_batch;
+        std::promise<void> m_promise;
+        std::future<void> m_future = m_promise.get_future();
+    };
+
     std::shared_ptr<MutableStorageType> m_mutableStorage;
     std::deque<std::shared_ptr<MutableStorageType>> m_immutableStorages;
+    // Same order as m_immutableStorages, nullptr if the layer has no filter
+    std::deque<std::shared_ptr<Filter>> m_immutableFilters;
+    // Same order as m_immutableStorages, nullptr if the layer is merged in the foreground
+    std::deque<std::shared_ptr<PreparedMerge>> m_preparedMerges;
     std::mutex m_listMutex;
     std::mutex m_mergeMutex;
+    bool m_enableFilter = false;
+    bool m_backgroundMerge = false;
+    // Only created with background merge, the nested storages of the chunks never need one
+    std::unique_ptr<tbb::task_arena> m_mergeArena;
+    std::unique_ptr<LayerHitStatistic> m_statistic;
 
     BackendStorage& m_backendStorage;
     [[no_unique_address]] std::conditional_t<withCacheStorage,
@@ -60,7 +173,11 @@ public:
     private:
         std::shared_ptr<MutableStorageType> m_mutableStorage;
         std::deque<std::shared_ptr<MutableStorageType>> m_immutableStorages;
+        std::deque<std::shared_ptr<const Filter>> m_immutableFilters;
+        LayerHitStatistic* m_statistic = nullptr;
         BackendStorage& m_backendStorage;
+        // Read instead of the backend if set, shared by the copies of the view
+        std::shared_ptr<BackendSnapshot> m_backendSnapshot;
         [[no_unique_address]] std::conditional_t<withCacheStorage,
             std::add_lvalue_reference_t<CachedStorage>, std::monostate>
             m_cacheStorage;
@@ -78,34 +195,40 @@ public:
           : m_backendStorage(backendStorage), m_cacheStorage(cacheStorage)
         {}
 
-        static auto readStorage(auto& storage,
-            boost::container::small_vector<std::tuple<KeyType, std::optional<ValueType>>, 1>&
-                keyValues) -> task::Task<bool>
+        using KeyValues =
+            boost::container::small_vector<std::tuple<KeyType, std::optional<ValueType>>, 1>;
+
+        // Read the missing keys from the storage, skip the keys rejected by the filter, return the
+        // count of keys found
+        static auto readStorage(auto& storage, KeyValues& keyValues,
+            const Filter* filter = nullptr) -> task::Task<size_t>
         {
             auto keyIndexes =
-                RANGES::views::enumerate(keyValues) | RANGES::views::filter([](auto&& tuple) {
-                    return !std::get<1>(std::get<1>(tuple));
+                RANGES::views::enumerate(keyValues) | RANGES::views::filter([&](auto&& tuple) {
+                    auto& [key, value] = std::get<1>(tuple);
+                    return !value && (filter == nullptr || filter->mayContain(key));
                 }) |
                 RANGES::views::transform([](auto&& tuple) -> auto{ return std::get<0>(tuple); }) |
                 RANGES::to<boost::container::small_vector<size_t, 1>>();
+            if (RANGES::empty(keyIndexes))
+            {
+                co_return 0;
+            }
             auto it = co_await storage.read(RANGES::views::transform(
                 keyIndexes, [&](auto& index) -> auto& { return std::get<0>(keyValues[index]); }));
 
-            bool finished = true;
+            size_t found = 0;
             auto indexIt = RANGES::begin(keyIndexes);
             while (co_await it.next())
             {
                 if (co_await it.hasValue())
                 {
                     std::get<1>(keyValues[*indexIt]).emplace(co_await it.value());
-                }
-                else
-                {
-                    finished = false;
+                    ++found;
                 }
                 RANGES::advance(indexIt, 1);
             }
-            co_return finished;
+            co_return found;
         }
 
     public:
@@ -175,28 +298,70 @@ public:
                     std::forward<decltype(key)>(key), std::optional<ValueType>{});
             }) | RANGES::to<decltype(iterator.m_keyValues)>();
 
+            auto& keyValues = iterator.m_keyValues;
+            size_t found = 0;
+            // Count the keys found in the last layer, return true if all keys are found
+            auto updateFound = [&](size_t counter, size_t count) {
+                if (m_statistic != nullptr && count > 0)
+                {
+                    m_statistic->add(counter, count);
+                }
+                found += count;
+                return found == keyValues.size();
+            };
+
             if (m_mutableStorage)
             {
-                if (co_await readStorage(*m_mutableStorage, iterator.m_keyValues))
+                if (updateFound(LayerHitStatistic::MUTABLE_HITS,
+                        co_await readStorage(*m_mutableStorage, keyValues)))
                 {
                     co_return iterator;
                 }
             }
 
-            if (!RANGES::empty(m_immutableStorages))
+            for (size_t depth = 0; depth < m_immutableStorages.size(); ++depth)
             {
-                for (auto& immutableStorage : m_immutableStorages)
+                auto const* filter = m_immutableFilters[depth].get();
+                if (filter != nullptr)
                 {
-                    if (co_await readStorage(*immutableStorage, iterator.m_keyValues))
+                    // Skip the layer when no missing key may exist in it
+                    auto skip = RANGES::none_of(keyValues, [&](auto const& keyValue) {
+                        return !std::get<1>(keyValue) && filter->mayContain(std::get<0>(keyValue));
+                    });
+                    if (skip)
                     {
-                        co_return iterator;
+                        if (m_statistic != nullptr)
+                        {
+                            m_statistic->add(LayerHitStatistic::FILTER_SKIPS, 1);
+                        }
+                        continue;
                     }
                 }
+
+                if (updateFound(LayerHitStatistic::IMMUTABLE_HITS +
+                                    std::min(depth, LayerHitStatistic::MAX_IMMUTABLE_DEPTH - 1),
+                        co_await readStorage(*m_immutableStorages[depth], keyValues, filter)))
+                {
+                    co_return iterator;
+                }
+            }
+
+            if constexpr (withBackendSnapshot)
+            {
+                if (m_backendSnapshot)
+                {
+                    // The cache may already hold the states newer than the snapshot, neither
+                    // read nor fill it
+                    updateFound(LayerHitStatistic::BACKEND_READS,
+                        co_await readStorage(*m_backendSnapshot, keyValues));
+                    co_return iterator;
+                }
             }
 
             if constexpr (withCacheStorage)
             {
-                if (co_await readStorage(m_cacheStorage, iterator.m_keyValues))
+                if (updateFound(LayerHitStatistic::CACHE_HITS,
+                        co_await readStorage(m_cacheStorage, keyValues)))
                 {
                     co_return iterator;
                 }
@@ -208,7 +373,8 @@ public:
                     [](auto&& tuple) { return !std::get<1>(std::get<1>(tuple)); }) |
                 RANGES::views::transform([](auto&& tuple) -> auto{ return std::get<0>(tuple); }) |
                 RANGES::to<boost::container::small_vector<size_t, 1>>();
-            co_await readStorage(m_backendStorage, iterator.m_keyValues);
+            updateFound(LayerHitStatistic::BACKEND_READS,
+                co_await readStorage(m_backendStorage, iterator.m_keyValues));
             // Write data into cache
             if constexpr (withCacheStorage)
             {
@@ -279,43 +445,55 @@ public:
     MultiLayerStorage(MultiLayerStorage&&) noexcept = delete;
     MultiLayerStorage& operator=(const MultiLayerStorage&) = delete;
     MultiLayerStorage& operator=(MultiLayerStorage&&) noexcept = delete;
-    ~MultiLayerStorage() noexcept = default;
+    ~MultiLayerStorage() noexcept
+    {
+        for (auto& prepared : m_preparedMerges)
+        {
+            if (prepared)
+            {
+                prepared->m_future.wait();
+            }
+        }
+    }
 
     View fork(bool withMutable)
     {
         std::unique_lock lock(m_listMutex);
-        if constexpr (withCacheStorage)
+        auto view = newView();
+        if (withMutable)
         {
-            View view(m_backendStorage, m_cacheStorage);
-            if (withMutable)
+            view.m_mutableLock = {m_mutableMutex, std::try_to_lock};
+            if (!view.m_mutableLock.owns_lock())
             {
-                view.m_mutableLock = {m_mutableMutex, std::try_to_lock};
-                if (!view.m_mutableLock.owns_lock())
-                {
-                    BOOST_THROW_EXCEPTION(DuplicateMutableViewError{});
-                }
-                view.m_mutableStorage = m_mutableStorage;
+                BOOST_THROW_EXCEPTION(DuplicateMutableViewError{});
             }
-            view.m_immutableStorages = m_immutableStorages;
+            view.m_mutableStorage = m_mutableStorage;
+        }
+        view.m_immutableStorages = m_immutableStorages;
+        view.m_immutableFilters.assign(m_immutableFilters.begin(), m_immutableFilters.end());
 
-            return view;
+        return view;
+    }
+
+    // Read only view of the committed state, without the layers of the newer blocks. With
+    // withImmutableBack the oldest immutable layer, the block being committed, is kept over the
+    // backend. The backend is read through a snapshot if it supports one, so that the view
+    // doesn't change while the later blocks are merged
+    View forkCommitted(bool withImmutableBack)
+    {
+        std::unique_lock lock(m_listMutex);
+        auto view = newView();
+        if constexpr (withBackendSnapshot)
+        {
+            view.m_backendSnapshot = std::make_shared<BackendSnapshot>(m_backendStorage.snapshot());
         }
-        else
+        if (withImmutableBack && !m_immutableStorages.empty())
         {
-            View view(m_backendStorage);
-            if (withMutable)
-            {
-                view.m_mutableLock = {m_mutableMutex, std::try_to_lock};
-                if (!view.m_mutableLock.owns_lock())
-                {
-                    BOOST_THROW_EXCEPTION(DuplicateMutableViewError{});
-                }
-                view.m_mutableStorage = m_mutableStorage;
-            }
-            view.m_immutableStorages = m_immutableStorages;
-
-            return view;
+            view.m_immutableStorages.push_back(m_immutableStorages.back());
+            view.m_immutableFilters.push_back(m_immutableFilters.back());
         }
+
+        return view;
     }
 
     template <class... Args>
@@ -330,41 +508,76 @@ public:
         m_mutableStorage = std::make_shared<MutableStorageType>(args...);
     }
 
-    void pushMutableToImmutableFront()
+    // Build a key filter for every immutable layer, so that reading a key absent from the
+    // uncommitted blocks goes straight to the cache and backend
+    void setEnableFilter(bool enableFilter) { m_enableFilter = enableFilter; }
+    // Count the keys found in each layer by the views forked after, nullptr if not enabled
+    void setEnableStatistic(bool enableStatistic)
     {
-        if (!m_mutableStorage)
+        m_statistic = enableStatistic ? std::make_unique<LayerHitStatistic>() : nullptr;
+    }
+    LayerHitStatistic const* layerHitStatistic() const { return m_statistic.get(); }
+
+    // Encode every immutable layer for the backend on a low priority arena as soon as it is
+    // pushed, so that merging it only waits for the durable write. The immutable layers must not
+    // be modified after pushed, write the extra data of the block with
+    // mergeAndPopImmutableBack(extraStorage) instead. No effect if the backend can't prepare merge
+    void setBackgroundMerge(bool backgroundMerge)
+    {
+        m_backgroundMerge = backgroundMerge;
+        if (m_backgroundMerge && !m_mergeArena)
         {
-            BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
+            m_mergeArena = std::make_unique<tbb::task_arena>(
+                tbb::task_arena::automatic, 1, tbb::task_arena::priority::low);
         }
-        std::unique_lock lock(m_listMutex);
-        m_immutableStorages.push_front(std::move(m_mutableStorage));
-        m_mutableStorage.reset();
     }
 
-    task::Task<void> mergeAndPopImmutableBack()
+    void pushMutableToImmutableFront()
     {
-        std::unique_lock mergeLock(m_mergeMutex);
-        std::unique_lock immutablesLock(m_listMutex);
-        if (m_immutableStorages.empty())
+        if (!m_mutableStorage)
         {
-            BOOST_THROW_EXCEPTION(NotExistsImmutableStorageError{});
+            BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
         }
-        auto immutableStorage = m_immutableStorages.back();
-        immutablesLock.unlock();
 
-        if constexpr (withCacheStorage)
+        std::shared_ptr<Filter> filter;
+        if (m_enableFilter)
         {
-            tbb::parallel_invoke(
-                [&]() { task::syncWait(storage2::merge(*immutableStorage, m_backendStorage)); },
-                [&]() { task::syncWait(storage2::merge(*immutableStorage, m_cacheStorage)); });
+            filter = task::syncWait(buildFilter(*m_mutableStorage));
         }
-        else
+        std::shared_ptr<PreparedMerge> prepared;
+        if constexpr (withPreparedMerge)
         {
-            co_await storage2::merge(*immutableStorage, m_backendStorage);
+            if (m_backgroundMerge)
+            {
+                prepared = std::make_shared<PreparedMerge>();
+                m_mergeArena->enqueue([this, prepared, storage = m_mutableStorage]() {
+                    try
+                    {
+                        task::syncWait(m_backendStorage.prepareMerge(*storage, prepared->m_batch));
+                        prepared->m_promise.set_value();
+                    }
+                    catch (...)
+                    {
+                        prepared->m_promise.set_exception(std::current_exception());
+                    }
+                });
+            }
         }
 
-        immutablesLock.lock();
-        m_immutableStorages.pop_back();
+        std::unique_lock lock(m_listMutex);
+        m_immutableStorages.push_front(std::move(m_mutableStorage));
+        m_immutableFilters.push_front(std::move(filter));
+        m_preparedMerges.push_front(std::move(prepared));
+        m_mutableStorage.reset();
+    }
+
+    task::Task<void> mergeAndPopImmutableBack() { co_await mergeBack(nullptr); }
+
+    // Merge the oldest immutable layer and the extra storage into the backend in one write, the
+    // extra storage overrides the layer on the same key
+    task::Task<void> mergeAndPopImmutableBack(MutableStorageType& extraStorage)
+    {
+        co_await mergeBack(std::addressof(extraStorage));
     }
 
     std::shared_ptr<MutableStorageType> frontImmutableStorage()
@@ -397,5 +610,122 @@ public:
         return *m_mutableStorage;
     }
     BackendStorage& backendStorage() { return m_backendStorage; }
+
+private:
+    View newView()
+    {
+        if constexpr (withCacheStorage)
+        {
+            View view(m_backendStorage, m_cacheStorage);
+            view.m_statistic = m_statistic.get();
+            return view;
+        }
+        else
+        {
+            View view(m_backendStorage);
+            view.m_statistic = m_statistic.get();
+            return view;
+        }
+    }
+
+    task::Task<void> mergeBack(MutableStorageType* extraStorage)
+    {
+        std::unique_lock mergeLock(m_mergeMutex);
+        std::unique_lock immutablesLock(m_listMutex);
+        if (m_immutableStorages.empty())
+        {
+            BOOST_THROW_EXCEPTION(NotExistsImmutableStorageError{});
+        }
+        auto immutableStorage = m_immutableStorages.back();
+        auto filter = m_immutableFilters.back();
+        auto prepared = m_preparedMerges.back();
+        immutablesLock.unlock();
+
+        if (prepared)
+        {
+            if constexpr (withPreparedMerge)
+            {
+                try
+                {
+                    prepared->m_future.get();
+                    if (extraStorage != nullptr)
+                    {
+                        co_await m_backendStorage.prepareMerge(*extraStorage, prepared->m_batch);
+                    }
+                    co_await m_backendStorage.commitMerge(prepared->m_batch);
+                }
+                catch (...)
+                {
+                    // The future is consumed and the batch may hold part of the extra storage,
+                    // merge the layer in the foreground on retry
+                    immutablesLock.lock();
+                    m_preparedMerges.back().reset();
+                    throw;
+                }
+                if constexpr (withCacheStorage)
+                {
+                    co_await storage2::merge(*immutableStorage, m_cacheStorage);
+                    if (extraStorage != nullptr)
+                    {
+                        co_await storage2::merge(*extraStorage, m_cacheStorage);
+                    }
+                }
+            }
+        }
+        else
+        {
+            if (extraStorage != nullptr)
+            {
+                // The views forked before still read the layer, add the extra keys to its filter
+                // ahead of them
+                if (filter)
+                {
+                    co_await insertFilter(*filter, *extraStorage);
+                }
+                co_await storage2::merge(*extraStorage, *immutableStorage);
+            }
+            if constexpr (withCacheStorage)
+            {
+                tbb::parallel_invoke(
+                    [&]() { task::syncWait(storage2::merge(*immutableStorage, m_backendStorage)); },
+                    [&]() { task::syncWait(storage2::merge(*immutableStorage, m_cacheStorage)); });
+            }
+            else
+            {
+                co_await storage2::merge(*immutableStorage, m_backendStorage);
+            }
+        }
+
+        immutablesLock.lock();
+        m_immutableStorages.pop_back();
+        m_immutableFilters.pop_back();
+        m_preparedMerges.pop_back();
+    }
+
+    static task::Task<void> insertFilter(Filter& filter, MutableStorageType& storage)
+    {
+        auto it = co_await storage.seek(storage2::STORAGE_BEGIN);
+        while (co_await it.next())
+        {
+            filter.insert(co_await it.key());
+        }
+    }
+
+    static task::Task<std::shared_ptr<Filter>> buildFilter(MutableStorageType& storage)
+    {
+        std::vector<KeyType const*> keys;
+        auto it = co_await storage.seek(storage2::STORAGE_BEGIN);
+        while (co_await it.next())
+        {
+            keys.emplace_back(std::addressof(co_await it.key()));
+        }
+
+        auto filter = std::make_shared<Filter>(keys.size());
+        for (auto const* key : keys)
+        {
+            filter->insert(*key);
+        }
+        co_return filter;
+    }
 };
 }  // namespace bcos::transaction_scheduler
\ No newline at end of file
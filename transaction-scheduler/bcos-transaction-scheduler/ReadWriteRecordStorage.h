@@ -0,0 +1,85 @@
+#pragma once
+#include <bcos-framework/transaction-executor/TransactionExecutor.h>
+#include <bcos-task/Trait.h>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace bcos::transaction_scheduler
+{
+
+// Per transaction read keys and written values, used to validate and replay a transaction without
+// executing it again
+template <class KeyType, class ValueType>
+struct ReadWriteRecord
+{
+    std::vector<KeyType> reads;
+    std::vector<std::tuple<KeyType, std::optional<ValueType>>> writes;
+
+    void clear()
+    {
+        reads.clear();
+        writes.clear();
+    }
+};
+
+template <class Storage, class KeyType, class ValueType>
+class ReadWriteRecordStorage
+{
+private:
+    Storage& m_storage;
+    ReadWriteRecord<KeyType, ValueType>& m_record;
+
+public:
+    using Key = KeyType;
+    using Value = ValueType;
+
+    ReadWriteRecordStorage(Storage& storage, ReadWriteRecord<KeyType, ValueType>& record)
+      : m_storage(storage), m_record(record)
+    {}
+
+    auto read(RANGES::input_range auto const& keys, bool direct = false)
+        -> task::Task<task::AwaitableReturnType<decltype(m_storage.read(keys))>>
+    {
+        if (!direct)
+        {
+            for (auto&& key : keys)
+            {
+                m_record.reads.emplace_back(key);
+            }
+        }
+        if constexpr (requires { m_storage.read(keys, direct); })
+        {
+            co_return co_await m_storage.read(keys, direct);
+        }
+        else
+        {
+            co_return co_await m_storage.read(keys);
+        }
+    }
+
+    auto write(RANGES::input_range auto&& keys, RANGES::input_range auto&& values)
+        -> task::Task<task::AwaitableReturnType<decltype(m_storage.write(
+            std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values)))>>
+    {
+        // Values may be moved by the underlying storage, keep a copy before forwarding
+        for (auto&& [key, value] : RANGES::views::zip(keys, values))
+        {
+            m_record.writes.emplace_back(KeyType{key}, std::optional<ValueType>{value});
+        }
+        co_return co_await m_storage.write(
+            std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
+    }
+
+    auto remove(RANGES::input_range auto const& keys)
+        -> task::Task<task::AwaitableReturnType<decltype(m_storage.remove(keys))>>
+    {
+        for (auto&& key : keys)
+        {
+            m_record.writes.emplace_back(KeyType{key}, std::optional<ValueType>{});
+        }
+        co_return co_await m_storage.remove(keys);
+    }
+};
+
+}  // namespace bcos::transaction_scheduler
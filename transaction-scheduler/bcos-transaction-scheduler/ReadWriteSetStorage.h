@@ -2,34 +2,134 @@
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <bcos-task/Trait.h>
 #include <oneapi/tbb.h>
+#include <algorithm>
+#include <bit>
 #include <compare>
+#include <cstdint>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace bcos::transaction_scheduler
 {
 
+// Keys are recorded with a 64 bit fingerprint computed once, conflict detection and merge compare
+// fingerprints and only compare the keys on fingerprint hit
+template <class KeyType>
+struct ReadWriteSetKey
+{
+    uint64_t fingerprint;
+    KeyType key;
+
+    bool operator<(ReadWriteSetKey const& rhs) const { return fingerprint < rhs.fingerprint; }
+};
+
 template <class Storage, class KeyType>
 class ReadWriteSetStorage
 {
 private:
+    template <class, class>
+    friend class ReadWriteSetStorage;
+
     Storage& m_storage;
-    struct ReadWriteFlag
+
+    using KeyEntry = ReadWriteSetKey<KeyType>;
+    // The bloom filter grows with the writes, about 10 bits per key keeps the false positive
+    // rate of two probes under 5%
+    constexpr static size_t BLOOM_BITS_PER_KEY = 10;
+    constexpr static size_t MIN_BLOOM_BITS = 1 << 10;
+    constexpr static size_t MAX_BLOOM_BITS = 1 << 26;
+    constexpr static size_t BLOOM_WORD_BITS = 64;
+
+    std::vector<KeyEntry> m_reads;
+    mutable std::vector<KeyEntry> m_writes;
+    mutable size_t m_sortedWrites = 0;
+    mutable std::vector<uint64_t> m_writeBloom;
+
+    static uint64_t fingerprint(auto const& key)
     {
-        bool read = false;
-        bool write = false;
-    };
-    std::unordered_map<KeyType, ReadWriteFlag> m_readWriteSet;
+        // Mix the bits, std::hash of integers may be identity
+        uint64_t hash = std::hash<KeyType>{}(key);
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    std::tuple<size_t, size_t> bloomBits(uint64_t fingerprint) const
+    {
+        // The size is a power of 2
+        auto mask = m_writeBloom.size() * BLOOM_WORD_BITS - 1;
+        return {fingerprint & mask, (fingerprint >> 32) & mask};
+    }
+
+    void addBloom(uint64_t fingerprint) const
+    {
+        auto [first, second] = bloomBits(fingerprint);
+        m_writeBloom[first / BLOOM_WORD_BITS] |= (1ULL << (first % BLOOM_WORD_BITS));
+        m_writeBloom[second / BLOOM_WORD_BITS] |= (1ULL << (second % BLOOM_WORD_BITS));
+    }
 
     void putSet(bool write, auto const& key)
     {
-        auto [it, inserted] =
-            m_readWriteSet.try_emplace(key, ReadWriteFlag{.read = !write, .write = write});
-        if (!inserted)
+        auto& keys = write ? m_writes : m_reads;
+        keys.emplace_back(KeyEntry{.fingerprint = fingerprint(key), .key = KeyType(key)});
+    }
+
+    // Sort and deduplicate the writes appended since last call, and update the bloom filter
+    void normalizeWrites() const
+    {
+        if (m_sortedWrites == m_writes.size())
+        {
+            return;
+        }
+        // Double the filter and add all the writes again once it is too small for the count,
+        // otherwise only add the new writes
+        auto bits = std::bit_ceil(std::clamp(
+            m_writes.size() * BLOOM_BITS_PER_KEY, MIN_BLOOM_BITS, MAX_BLOOM_BITS));
+        auto begin = m_writes.begin() + static_cast<int64_t>(m_sortedWrites);
+        if (bits > m_writeBloom.size() * BLOOM_WORD_BITS)
+        {
+            m_writeBloom.assign(bits / BLOOM_WORD_BITS, 0);
+            begin = m_writes.begin();
+        }
+        for (auto it = begin; it != m_writes.end(); ++it)
         {
-            it->second.write |= write;
-            it->second.read |= (!write);
+            addBloom(it->fingerprint);
         }
+
+        auto middle = m_writes.begin() + static_cast<int64_t>(m_sortedWrites);
+        std::sort(middle, m_writes.end());
+        std::inplace_merge(m_writes.begin(), middle, m_writes.end());
+        m_writes.erase(std::unique(m_writes.begin(), m_writes.end(),
+                           [](KeyEntry const& lhs, KeyEntry const& rhs) {
+                               return lhs.fingerprint == rhs.fingerprint && lhs.key == rhs.key;
+                           }),
+            m_writes.end());
+        m_sortedWrites = m_writes.size();
+    }
+
+    bool containsWrite(uint64_t fingerprint, auto const& key) const
+    {
+        auto [first, second] = bloomBits(fingerprint);
+        if ((m_writeBloom[first / BLOOM_WORD_BITS] & (1ULL << (first % BLOOM_WORD_BITS))) == 0 ||
+            (m_writeBloom[second / BLOOM_WORD_BITS] & (1ULL << (second % BLOOM_WORD_BITS))) == 0)
+        {
+            return false;
+        }
+
+        for (auto it = std::lower_bound(m_writes.begin(), m_writes.end(), fingerprint,
+                 [](KeyEntry const& entry, uint64_t value) { return entry.fingerprint < value; });
+             it != m_writes.end() && it->fingerprint == fingerprint; ++it)
+        {
+            if (it->key == key)
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
 public:
@@ -39,40 +139,49 @@ public:
 
     ReadWriteSetStorage(Storage& storage) : m_storage(storage) {}
 
-    auto& readWriteSet() { return m_readWriteSet; }
-    auto const& readWriteSet() const { return m_readWriteSet; }
-    void mergeWriteSet(auto& inputWriteSet)
+    auto readKeys() const
+    {
+        return m_reads | RANGES::views::transform([](KeyEntry const& entry) -> KeyType const& {
+            return entry.key;
+        });
+    }
+    auto writeKeys() const
     {
-        auto& writeMap = inputWriteSet.readWriteSet();
-        for (auto& [key, flag] : writeMap)
+        normalizeWrites();
+        return m_writes | RANGES::views::transform([](KeyEntry const& entry) -> KeyType const& {
+            return entry.key;
+        });
+    }
+
+    bool hasWrite(KeyType const& key) const
+    {
+        if (m_writes.empty())
         {
-            if (flag.write)
-            {
-                putSet(true, key);
-            }
+            return false;
         }
+        normalizeWrites();
+        return containsWrite(fingerprint(key), key);
+    }
+
+    void mergeWriteSet(auto& inputWriteSet)
+    {
+        m_writes.insert(
+            m_writes.end(), inputWriteSet.m_writes.begin(), inputWriteSet.m_writes.end());
+        normalizeWrites();
     }
 
     // RAW: read after write
     bool hasRAWIntersection(const auto& rhs) const
     {
-        auto const& lhsSet = m_readWriteSet;
-        auto const& rhsSet = rhs.readWriteSet();
-
-        if (RANGES::empty(lhsSet) || RANGES::empty(rhsSet))
+        if (m_writes.empty() || rhs.m_reads.empty())
         {
             return false;
         }
 
-        for (auto const& [key, flag] : rhsSet)
-        {
-            if (flag.read && lhsSet.contains(key))
-            {
-                return true;
-            }
-        }
-
-        return false;
+        normalizeWrites();
+        return std::any_of(rhs.m_reads.begin(), rhs.m_reads.end(), [this](auto const& entry) {
+            return containsWrite(entry.fingerprint, entry.key);
+        });
     }
 
     auto read(RANGES::input_range auto const& keys, bool direct = false)
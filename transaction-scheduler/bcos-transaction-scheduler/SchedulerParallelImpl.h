@@ -1,12 +1,18 @@
 #pragma once
 
+#include "AdaptiveChunkPolicy.h"
+#include "ConflictGraph.h"
 #include "MultiLayerStorage.h"
+#include "ReadWriteRecordStorage.h"
 #include "ReadWriteSetStorage.h"
+#include "StateHashAccumulator.h"
+#include "bcos-framework/Common.h"
 #include "bcos-framework/protocol/Transaction.h"
 #include "bcos-framework/protocol/TransactionReceipt.h"
 #include "bcos-framework/protocol/TransactionReceiptFactory.h"
 #include "bcos-framework/storage2/MemoryStorage.h"
 #include "bcos-framework/storage2/Storage.h"
+#include "bcos-framework/transaction-executor/ExecutionArena.h"
 #include "bcos-framework/transaction-executor/TransactionExecutor.h"
 #include "bcos-framework/transaction-scheduler/TransactionScheduler.h"
 #include "bcos-tars-protocol/protocol/TransactionReceiptImpl.h"
@@ -14,15 +20,21 @@
 #include <bcos-task/TBBWait.h>
 #include <bcos-task/Wait.h>
 #include <bcos-utilities/ITTAPI.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/parallel_pipeline.h>
+#include <fmt/format.h>
 #include <oneapi/tbb/partitioner.h>
 #include <boost/exception/detail/exception_ptr.hpp>
 #include <boost/throw_exception.hpp>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <optional>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace bcos::transaction_scheduler
 {
@@ -35,10 +47,39 @@ class SchedulerParallelImpl
         transaction_executor::StateValue,
         storage2::memory_storage::Attribute(
             storage2::memory_storage::ORDERED | storage2::memory_storage::LOGICAL_DELETION)>;
+    // Outlives the chunks destroyed by the async task group
+    std::unique_ptr<transaction_executor::ExecutionArenaPool> m_arenaPool;
     std::unique_ptr<tbb::task_group> m_asyncTaskGroup;
     constexpr static size_t MIN_CHUNK_SIZE = 32;
+    constexpr static size_t MAX_CHUNK_SIZE = 4096;
     size_t m_chunkSize = MIN_CHUNK_SIZE;
     size_t m_maxToken = 0;
+    bool m_conflictAware = false;
+    bool m_predict = false;
+    bool m_prefetch = false;
+    std::optional<AdaptiveChunkPolicy> m_adaptivePolicy;
+    crypto::Hash const* m_stateHashImpl = nullptr;
+    std::optional<crypto::HashType> m_lastStateHash;
+
+public:
+    struct ExecuteStatistic
+    {
+        size_t retryCount = 0;
+        size_t conflictChunkCount = 0;
+        size_t reexecuteCount = 0;
+        size_t replayCount = 0;
+        size_t chunkSize = 0;
+        size_t maxToken = 0;
+        size_t chunkCount = 0;
+        int64_t chunkTime = 0;  // Total chunk execution time, in microseconds
+        size_t predictedCount = 0;
+        size_t predictionFallbackCount = 0;
+    };
+
+private:
+    ExecuteStatistic m_lastStatistic;
+
+    using Record = ReadWriteRecord<transaction_executor::StateKey, transaction_executor::StateValue>;
 
     template <class Storage, class Executor, class Range>
     class ChunkStatus
@@ -51,22 +92,30 @@ class SchedulerParallelImpl
             return view;
         }
 
+        transaction_executor::ExecutionArenaPool::Arena m_arena;
         int64_t m_chunkIndex = 0;
         std::atomic_int64_t* m_lastChunkIndex = nullptr;
         Range m_transactionAndReceiptsRange;
         Executor& m_executor;
+        Storage& m_storage;
+        std::vector<Record> m_records;
         MultiLayerStorage<ChunkStorage, void, Storage> m_localStorage;
         decltype(m_localStorage.fork(true)) m_localStorageView;
         ReadWriteSetStorage<decltype(m_localStorageView), transaction_executor::StateKey>
             m_localReadWriteSetStorage;
+        StateHashAccumulator::EntryHashes m_entryHashes;
 
     public:
         ChunkStatus(int64_t chunkIndex, std::atomic_int64_t& lastChunkIndex,
-            Range transactionAndReceiptsRange, Executor& executor, auto& storage)
-          : m_chunkIndex(chunkIndex),
+            Range transactionAndReceiptsRange, Executor& executor, Storage& storage,
+            bool recordReadWriteSet, transaction_executor::ExecutionArenaPool& arenaPool)
+          : m_arena(arenaPool.acquire()),
+            m_chunkIndex(chunkIndex),
             m_lastChunkIndex(std::addressof(lastChunkIndex)),
             m_transactionAndReceiptsRange(transactionAndReceiptsRange),
             m_executor(executor),
+            m_storage(storage),
+            m_records(recordReadWriteSet ? RANGES::size(transactionAndReceiptsRange) : 0),
             m_localStorage(storage),
             m_localStorageView(forkAndMutable(m_localStorage)),
             m_localReadWriteSetStorage(m_localStorageView)
@@ -76,12 +125,66 @@ class SchedulerParallelImpl
         auto count() { return RANGES::size(m_transactionAndReceiptsRange); }
         decltype(m_localStorage)& localStorage() & { return m_localStorage; }
         auto& readWriteSetStorage() & { return m_localReadWriteSetStorage; }
+        StateHashAccumulator::EntryHashes const& entryHashes() const { return m_entryHashes; }
+
+        // The temporaries of the transaction are allocated from the arena of the chunk, which is
+        // reset once the receipt is built since the transactions of a chunk run one by one
+        task::Task<protocol::TransactionReceipt::Ptr> executeTransaction(auto& storage,
+            protocol::BlockHeader const& blockHeader, protocol::Transaction const& transaction,
+            int contextID)
+        {
+            if constexpr (requires {
+                              transaction_executor::execute(m_executor, storage, blockHeader,
+                                  transaction, contextID, m_arena->resource());
+                          })
+            {
+                auto receipt = co_await transaction_executor::execute(m_executor, storage,
+                    blockHeader, transaction, contextID, m_arena->resource());
+                m_arena->reset();
+                co_return receipt;
+            }
+            else
+            {
+                co_return co_await transaction_executor::execute(
+                    m_executor, storage, blockHeader, transaction, contextID);
+            }
+        }
+
+        // Read the predicted keys of the chunk from the block storage in one batch, the backend
+        // loads the missing ones into the cache with one MultiGet instead of a Get per key during
+        // execution
+        task::Task<void> prefetch(
+            std::vector<std::optional<std::vector<transaction_executor::StateKey>>> const&
+                predictions)
+        {
+            ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
+                ittapi::ITT_DOMAINS::instance().PREFETCH_CHUNK);
+            std::unordered_set<transaction_executor::StateKey> keySet;
+            for (auto&& [contextID, transaction, receipt] : m_transactionAndReceiptsRange)
+            {
+                if (auto const& keys = predictions[contextID])
+                {
+                    keySet.insert(keys->begin(), keys->end());
+                }
+            }
+            if (!keySet.empty())
+            {
+                auto keys = keySet | RANGES::to<std::vector<transaction_executor::StateKey>>();
+                co_await m_storage.read(keys);
+            }
+        }
+
+        task::Task<void> hashEntries(StateHashAccumulator const& stateHash)
+        {
+            m_entryHashes = co_await stateHash.hashEntries(m_localStorage.mutableStorage());
+        }
 
         task::Task<void> execute(protocol::BlockHeader const& blockHeader)
         {
             ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
                 ittapi::ITT_DOMAINS::instance().EXECUTE_CHUNK);
             PARALLEL_SCHEDULER_LOG(DEBUG) << "Chunk " << m_chunkIndex << " executing...";
+            size_t index = 0;
             for (auto&& [contextID, transaction, receipt] : m_transactionAndReceiptsRange)
             {
                 if (m_chunkIndex >= *m_lastChunkIndex)
@@ -89,12 +192,110 @@ class SchedulerParallelImpl
                     PARALLEL_SCHEDULER_LOG(DEBUG) << "Chunk " << m_chunkIndex << " execute aborted";
                     co_return;
                 }
-                *receipt = co_await transaction_executor::execute(
-                    m_executor, m_localReadWriteSetStorage, blockHeader, *transaction, contextID);
+                if (m_records.empty())
+                {
+                    *receipt = co_await executeTransaction(
+                        m_localReadWriteSetStorage, blockHeader, *transaction, contextID);
+                }
+                else
+                {
+                    ReadWriteRecordStorage<decltype(m_localReadWriteSetStorage),
+                        transaction_executor::StateKey, transaction_executor::StateValue>
+                        recordStorage(m_localReadWriteSetStorage, m_records[index]);
+                    *receipt = co_await executeTransaction(
+                        recordStorage, blockHeader, *transaction, contextID);
+                }
+                ++index;
             }
 
             PARALLEL_SCHEDULER_LOG(DEBUG) << "Chunk " << m_chunkIndex << " execute finished";
         }
+
+        // Execute the chunk again on top of the merged results of the previous chunks. A
+        // transaction whose read set doesn't intersect with the previous writes is replayed from
+        // its records, the others are executed again
+        task::Task<std::tuple<size_t, size_t>> reexecute(protocol::BlockHeader const& blockHeader,
+            ChunkStorage& lastStorage, auto& writeSet, StateHashAccumulator* stateHash)
+        {
+            ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
+                ittapi::ITT_DOMAINS::instance().REEXECUTE_CHUNK);
+            PARALLEL_SCHEDULER_LOG(DEBUG) << "Chunk " << m_chunkIndex << " re-executing...";
+
+            MultiLayerStorage<ChunkStorage, void, Storage> reexecuteStorage(m_storage);
+            reexecuteStorage.newMutable();
+            auto view = reexecuteStorage.fork(true);
+            view.mutableStorage().swap(lastStorage);
+            ReadWriteSetStorage<decltype(view), transaction_executor::StateKey>
+                readWriteSetStorage(view);
+
+            std::unordered_set<transaction_executor::StateKey> dirtyKeys;
+            size_t reexecuteCount = 0;
+            size_t replayCount = 0;
+            for (auto&& [transactionAndReceipt, record] :
+                RANGES::views::zip(m_transactionAndReceiptsRange, m_records))
+            {
+                auto&& [contextID, transaction, receipt] = transactionAndReceipt;
+                auto dirty = RANGES::any_of(record.reads, [&](auto const& key) {
+                    return writeSet.hasWrite(key) || dirtyKeys.contains(key);
+                });
+                if (dirty)
+                {
+                    // Both the old and the new write set of the transaction may be seen by the
+                    // following transactions
+                    for (auto& [key, value] : record.writes)
+                    {
+                        dirtyKeys.emplace(key);
+                    }
+                    record.clear();
+                    ReadWriteRecordStorage<decltype(readWriteSetStorage),
+                        transaction_executor::StateKey, transaction_executor::StateValue>
+                        recordStorage(readWriteSetStorage, record);
+                    *receipt = co_await executeTransaction(
+                        recordStorage, blockHeader, *transaction, contextID);
+                    for (auto& [key, value] : record.writes)
+                    {
+                        dirtyKeys.emplace(key);
+                    }
+                    ++reexecuteCount;
+                }
+                else
+                {
+                    for (auto& [key, value] : record.writes)
+                    {
+                        if (value)
+                        {
+                            co_await storage2::writeOne(readWriteSetStorage, key, *value);
+                        }
+                        else
+                        {
+                            co_await storage2::removeOne(readWriteSetStorage, key);
+                        }
+                    }
+                    ++replayCount;
+                }
+            }
+            view.mutableStorage().swap(lastStorage);
+            writeSet.mergeWriteSet(readWriteSetStorage);
+            if (stateHash != nullptr)
+            {
+                std::unordered_set<transaction_executor::StateKey> writeKeySet;
+                for (auto const& record : m_records)
+                {
+                    for (auto const& [key, value] : record.writes)
+                    {
+                        writeKeySet.emplace(key);
+                    }
+                }
+                auto writeKeys =
+                    writeKeySet | RANGES::to<std::vector<transaction_executor::StateKey>>();
+                stateHash->merge(co_await stateHash->hashEntries(lastStorage, writeKeys));
+            }
+
+            PARALLEL_SCHEDULER_LOG(DEBUG)
+                << "Chunk " << m_chunkIndex << " re-execute finished, re-executed: "
+                << reexecuteCount << " replayed: " << replayCount;
+            co_return std::make_tuple(reexecuteCount, replayCount);
+        }
     };
 
 public:
@@ -103,31 +304,71 @@ public:
     SchedulerParallelImpl& operator=(const SchedulerParallelImpl&) = delete;
     SchedulerParallelImpl& operator=(SchedulerParallelImpl&&) noexcept = default;
 
-    SchedulerParallelImpl() : m_asyncTaskGroup(std::make_unique<tbb::task_group>()) {}
+    SchedulerParallelImpl()
+      : m_arenaPool(std::make_unique<transaction_executor::ExecutionArenaPool>()),
+        m_asyncTaskGroup(std::make_unique<tbb::task_group>())
+    {}
     ~SchedulerParallelImpl() noexcept { m_asyncTaskGroup->wait(); }
 
     void setChunkSize(size_t chunkSize) { m_chunkSize = chunkSize; }
-    void setMaxToken(size_t maxToken) { m_maxToken = maxToken; }
+    void setMaxToken(size_t maxToken)
+    {
+        m_maxToken = maxToken;
+        if (m_adaptivePolicy)
+        {
+            m_adaptivePolicy->setMaxToken(maxToken == 0 ? std::thread::hardware_concurrency() :
+                                                          maxToken);
+        }
+    }
 
-private:
-    friend task::Task<std::vector<protocol::TransactionReceipt::Ptr>> tag_invoke(
-        tag_t<execute> /*unused*/, SchedulerParallelImpl& scheduler, auto& storage, auto& executor,
-        protocol::BlockHeader const& blockHeader, RANGES::input_range auto const& transactions)
+    // Adjust chunk size and max token of each block from the conflict rate of the recent blocks
+    void setAdaptive(bool adaptive)
     {
-        ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
-            ittapi::ITT_DOMAINS::instance().PARALLEL_EXECUTE);
-        std::vector<protocol::TransactionReceipt::Ptr> receipts(RANGES::size(transactions));
+        if (adaptive)
+        {
+            m_adaptivePolicy.emplace(MIN_CHUNK_SIZE, MAX_CHUNK_SIZE,
+                m_maxToken == 0 ? std::thread::hardware_concurrency() : m_maxToken, m_chunkSize);
+        }
+        else
+        {
+            m_adaptivePolicy.reset();
+        }
+    }
 
-        size_t offset = 0;
-        size_t retryCount = 0;
-        while (offset < RANGES::size(transactions))
+    // Re-execute only the conflicting transactions of a chunk instead of retrying all the
+    // following chunks
+    void setConflictAware(bool conflictAware) { m_conflictAware = conflictAware; }
+    // Group the transactions by the conflict keys predicted by the executor before execution
+    void setPredict(bool predict) { m_predict = predict; }
+    // Batch read the predicted keys of every chunk before it executes, only worth it when the
+    // block storage has a cache layer to keep them
+    void setPrefetch(bool prefetch) { m_prefetch = prefetch; }
+    ExecuteStatistic const& lastStatistic() const { return m_lastStatistic; }
+
+    // Accumulate the state hash while merging the chunks, so that the caller needn't scan the
+    // block storage again, see lastStateHash()
+    void setStateHashImpl(crypto::Hash const* hashImpl) { m_stateHashImpl = hashImpl; }
+    // XOR of the entry hashes of the keys written by the last block, nullopt if not enabled
+    std::optional<crypto::HashType> const& lastStateHash() const { return m_lastStateHash; }
+
+private:
+    // Execute transactions[begin, end) optimistically, retry from the first conflicting chunk
+    static task::Task<void> executeOptimistic(SchedulerParallelImpl& scheduler, auto& storage,
+        auto& executor, protocol::BlockHeader const& blockHeader, auto const& transactions,
+        std::vector<protocol::TransactionReceipt::Ptr>& receipts,
+        std::vector<std::optional<std::vector<transaction_executor::StateKey>>> const& predictions,
+        size_t begin, size_t end, ExecuteStatistic& statistic, StateHashAccumulator* stateHash)
+    {
+        size_t offset = begin;
+        std::atomic_size_t chunkCount = 0;
+        std::atomic_int64_t chunkTime = 0;
+        while (offset < end)
         {
             ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
                 ittapi::ITT_DOMAINS::instance().SINGLE_PASS);
 
             auto currentTransactionAndReceipts =
-                RANGES::views::iota(offset, (size_t)RANGES::size(receipts)) |
-                RANGES::views::transform([&](auto index) {
+                RANGES::views::iota(offset, end) | RANGES::views::transform([&](auto index) {
                     return std::make_tuple(index, std::addressof(transactions[index]),
                         std::addressof(receipts[index]));
                 });
@@ -136,15 +377,14 @@ private:
             ReadWriteSetStorage<decltype(storage), transaction_executor::StateKey> writeSet(
                 storage);
             auto chunks =
-                currentTransactionAndReceipts | RANGES::views::chunk(scheduler.m_chunkSize);
+                currentTransactionAndReceipts | RANGES::views::chunk(statistic.chunkSize);
             using Chunk = SchedulerParallelImpl::ChunkStatus<std::decay_t<decltype(storage)>,
                 std::decay_t<decltype(executor)>, RANGES::range_value_t<decltype(chunks)>>;
 
             PARALLEL_SCHEDULER_LOG(DEBUG) << "Start new chunk executing... " << offset << " | "
                                           << RANGES::size(currentTransactionAndReceipts);
             ChunkStorage lastStorage;
-            tbb::parallel_pipeline(scheduler.m_maxToken == 0 ? std::thread::hardware_concurrency() :
-                                                               scheduler.m_maxToken,
+            tbb::parallel_pipeline(statistic.maxToken,
                 tbb::make_filter<void, std::unique_ptr<Chunk>>(tbb::filter_mode::serial_in_order,
                     [&](tbb::flow_control& control) -> std::unique_ptr<Chunk> {
                         if (chunkIndex >= RANGES::size(chunks))
@@ -153,8 +393,9 @@ private:
                             return {};
                         }
                         PARALLEL_SCHEDULER_LOG(DEBUG) << "Chunk: " << chunkIndex;
-                        auto chunk = std::make_unique<Chunk>(
-                            chunkIndex, lastChunkIndex, chunks[chunkIndex], executor, storage);
+                        auto chunk = std::make_unique<Chunk>(chunkIndex, lastChunkIndex,
+                            chunks[chunkIndex], executor, storage, scheduler.m_conflictAware,
+                            *scheduler.m_arenaPool);
                         ++chunkIndex;
                         return chunk;
                     }) &
@@ -166,7 +407,20 @@ private:
                             {
                                 return chunk;
                             }
+                            if (scheduler.m_prefetch)
+                            {
+                                task::tbb::syncWait(chunk->prefetch(predictions));
+                            }
+                            auto start = std::chrono::steady_clock::now();
                             task::tbb::syncWait(chunk->execute(blockHeader));
+                            if (stateHash != nullptr)
+                            {
+                                task::tbb::syncWait(chunk->hashEntries(*stateHash));
+                            }
+                            chunkTime += std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                             .count();
+                            ++chunkCount;
 
                             return chunk;
                         }) &
@@ -187,6 +441,19 @@ private:
                                 {
                                     PARALLEL_SCHEDULER_LOG(DEBUG)
                                         << "Detected RAW Intersection:" << index;
+                                    ++statistic.conflictChunkCount;
+                                    if (scheduler.m_conflictAware)
+                                    {
+                                        auto [reexecuteCount, replayCount] =
+                                            task::tbb::syncWait(chunk->reexecute(
+                                                blockHeader, lastStorage, writeSet, stateHash));
+                                        statistic.reexecuteCount += reexecuteCount;
+                                        statistic.replayCount += replayCount;
+                                        offset += (size_t)chunk->count();
+                                        scheduler.m_asyncTaskGroup->run(
+                                            [chunk = std::move(chunk)]() {});
+                                        return;
+                                    }
                                     lastChunkIndex = index;
                                     scheduler.m_asyncTaskGroup->run(
                                         [chunk = std::move(chunk)]() {});
@@ -210,6 +477,12 @@ private:
                                         ittapi::ITT_DOMAINS::instance().MERGE_CHUNK);
                                     task::tbb::syncWait(storage2::merge(
                                         chunk->localStorage().mutableStorage(), lastStorage));
+                                },
+                                [&]() {
+                                    if (stateHash != nullptr)
+                                    {
+                                        stateHash->merge(chunk->entryHashes());
+                                    }
                                 });
                             scheduler.m_asyncTaskGroup->run([chunk = std::move(chunk)]() {});
                         }));
@@ -221,11 +494,223 @@ private:
 
             scheduler.m_asyncTaskGroup->run(
                 [lastStorage = std::move(lastStorage), readWriteSet = std::move(writeSet)]() {});
-            ++retryCount;
+            ++statistic.retryCount;
+        }
+        statistic.chunkCount += chunkCount;
+        statistic.chunkTime += chunkTime;
+    }
+
+    // Execute each bin of independent transaction groups on a separate worker, return false if
+    // the executed read write sets of the workers intersect, which means the prediction is
+    // incomplete and nothing is written
+    static task::Task<bool> executePredicted(SchedulerParallelImpl& scheduler, auto& storage,
+        auto& executor, protocol::BlockHeader const& blockHeader, auto const& transactions,
+        std::vector<protocol::TransactionReceipt::Ptr>& receipts,
+        std::vector<std::optional<std::vector<transaction_executor::StateKey>>> const& predictions,
+        std::vector<std::vector<size_t>> const& bins, StateHashAccumulator* stateHash)
+    {
+        ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
+            ittapi::ITT_DOMAINS::instance().EXECUTE_PREDICTED);
+        using TransactionAndReceipt = std::tuple<size_t,
+            decltype(std::addressof(transactions[size_t{0}])), protocol::TransactionReceipt::Ptr*>;
+        using Worker = SchedulerParallelImpl::ChunkStatus<std::decay_t<decltype(storage)>,
+            std::decay_t<decltype(executor)>, std::vector<TransactionAndReceipt>>;
+
+        std::atomic_int64_t lastChunkIndex{std::numeric_limits<int64_t>::max()};
+        std::vector<std::unique_ptr<Worker>> workers;
+        workers.reserve(bins.size());
+        for (auto const& bin : bins)
+        {
+            workers.emplace_back(std::make_unique<Worker>(static_cast<int64_t>(workers.size()),
+                lastChunkIndex,
+                bin | RANGES::views::transform([&](size_t index) {
+                    return TransactionAndReceipt(index, std::addressof(transactions[index]),
+                        std::addressof(receipts[index]));
+                }) | RANGES::to<std::vector<TransactionAndReceipt>>(),
+                executor, storage, false, *scheduler.m_arenaPool));
+        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, workers.size(), 1),
+            [&](auto const& range) {
+                for (auto index = range.begin(); index != range.end(); ++index)
+                {
+                    if (scheduler.m_prefetch)
+                    {
+                        task::tbb::syncWait(workers[index]->prefetch(predictions));
+                    }
+                    task::tbb::syncWait(workers[index]->execute(blockHeader));
+                    if (stateHash != nullptr)
+                    {
+                        task::tbb::syncWait(workers[index]->hashEntries(*stateHash));
+                    }
+                }
+            });
+
+        // Validate the prediction, no key written by one worker may be touched by another
+        std::unordered_map<transaction_executor::StateKey, size_t> writers;
+        bool conflict = false;
+        for (size_t workerIndex = 0; workerIndex < workers.size(); ++workerIndex)
+        {
+            for (auto const& key : workers[workerIndex]->readWriteSetStorage().writeKeys())
+            {
+                auto [it, inserted] = writers.try_emplace(key, workerIndex);
+                conflict |= (!inserted && it->second != workerIndex);
+            }
+        }
+        for (size_t workerIndex = 0; workerIndex < workers.size(); ++workerIndex)
+        {
+            for (auto const& key : workers[workerIndex]->readWriteSetStorage().readKeys())
+            {
+                auto it = writers.find(key);
+                conflict |= (it != writers.end() && it->second != workerIndex);
+            }
+        }
+        if (conflict)
+        {
+            PARALLEL_SCHEDULER_LOG(DEBUG) << "Predicted groups conflict, fallback";
+            scheduler.m_asyncTaskGroup->run([workers = std::move(workers)]() {});
+            co_return false;
+        }
+
+        ChunkStorage lastStorage;
+        for (auto& worker : workers)
+        {
+            co_await storage2::merge(worker->localStorage().mutableStorage(), lastStorage);
+            if (stateHash != nullptr)
+            {
+                stateHash->merge(worker->entryHashes());
+            }
+        }
+        co_await storage2::merge(lastStorage, storage);
+        scheduler.m_asyncTaskGroup->run(
+            [workers = std::move(workers), lastStorage = std::move(lastStorage)]() {});
+        co_return true;
+    }
+
+    friend task::Task<std::vector<protocol::TransactionReceipt::Ptr>> tag_invoke(
+        tag_t<execute> /*unused*/, SchedulerParallelImpl& scheduler, auto& storage, auto& executor,
+        protocol::BlockHeader const& blockHeader, RANGES::input_range auto const& transactions)
+    {
+        ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
+            ittapi::ITT_DOMAINS::instance().PARALLEL_EXECUTE);
+        std::vector<protocol::TransactionReceipt::Ptr> receipts(RANGES::size(transactions));
+        size_t transactionCount = RANGES::size(transactions);
+
+        ExecuteStatistic statistic;
+        std::optional<StateHashAccumulator> stateHash;
+        scheduler.m_lastStateHash.reset();
+        if (scheduler.m_stateHashImpl != nullptr)
+        {
+            stateHash.emplace(*scheduler.m_stateHashImpl, blockHeader.version());
+        }
+        auto* stateHashPtr = stateHash ? std::addressof(*stateHash) : nullptr;
+
+        if (scheduler.m_adaptivePolicy)
+        {
+            statistic.chunkSize = scheduler.m_adaptivePolicy->chunkSize();
+            statistic.maxToken = scheduler.m_adaptivePolicy->maxToken(transactionCount);
+        }
+        else
+        {
+            statistic.chunkSize = scheduler.m_chunkSize;
+            statistic.maxToken = scheduler.m_maxToken == 0 ? std::thread::hardware_concurrency() :
+                                                             scheduler.m_maxToken;
+        }
+
+        // Predict the conflict keys from calldata, the transactions without prediction are
+        // executed optimistically
+        std::vector<std::optional<std::vector<transaction_executor::StateKey>>> predictions(
+            transactionCount);
+        if constexpr (requires {
+                          transaction_executor::predictConflictKeys(executor, transactions[0]);
+                      })
+        {
+            if (scheduler.m_predict || scheduler.m_prefetch)
+            {
+                ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
+                    ittapi::ITT_DOMAINS::instance().PREDICT_CONFLICT);
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, transactionCount),
+                    [&](auto const& range) {
+                        for (auto index = range.begin(); index != range.end(); ++index)
+                        {
+                            predictions[index] = transaction_executor::predictConflictKeys(
+                                executor, transactions[index]);
+                        }
+                    });
+            }
         }
 
+        size_t offset = 0;
+        size_t optimisticBegin = 0;
+        while (offset < transactionCount)
+        {
+            auto predicted = predictions[offset].has_value();
+            auto segmentEnd = offset + 1;
+            while (segmentEnd < transactionCount &&
+                   predictions[segmentEnd].has_value() == predicted)
+            {
+                ++segmentEnd;
+            }
+
+            // Short predicted segments are not worth the grouping
+            if (scheduler.m_predict && predicted && segmentEnd - offset >= statistic.chunkSize)
+            {
+                if (optimisticBegin < offset)
+                {
+                    co_await executeOptimistic(scheduler, storage, executor, blockHeader,
+                        transactions, receipts, predictions, optimisticBegin, offset, statistic,
+                        stateHashPtr);
+                }
+
+                auto bins =
+                    ConflictGraph<transaction_executor::StateKey>(predictions, offset, segmentEnd)
+                        .bins(statistic.maxToken);
+                if (co_await executePredicted(scheduler, storage, executor, blockHeader,
+                        transactions, receipts, predictions, bins, stateHashPtr))
+                {
+                    statistic.predictedCount += segmentEnd - offset;
+                    optimisticBegin = segmentEnd;
+                }
+                else
+                {
+                    ++statistic.predictionFallbackCount;
+                    optimisticBegin = offset;
+                }
+            }
+            offset = segmentEnd;
+        }
+        if (optimisticBegin < transactionCount)
+        {
+            co_await executeOptimistic(scheduler, storage, executor, blockHeader, transactions,
+                receipts, predictions, optimisticBegin, transactionCount, statistic, stateHashPtr);
+        }
+
+        if (scheduler.m_adaptivePolicy)
+        {
+            scheduler.m_adaptivePolicy->update(
+                statistic.chunkCount, statistic.conflictChunkCount, statistic.chunkTime);
+        }
+
+        PARALLEL_SCHEDULER_LOG(INFO)
+            << "Parallel scheduler execute finished, retry counts: " << statistic.retryCount
+            << " conflict chunks: " << statistic.conflictChunkCount
+            << " re-executed: " << statistic.reexecuteCount
+            << " replayed: " << statistic.replayCount
+            << " predicted: " << statistic.predictedCount
+            << " prediction fallbacks: " << statistic.predictionFallbackCount;
         PARALLEL_SCHEDULER_LOG(INFO)
-            << "Parallel scheduler execute finished, retry counts: " << retryCount;
+            << METRIC << "Parallel scheduler params, chunk size: " << statistic.chunkSize
+            << " max token: " << statistic.maxToken << " chunks: " << statistic.chunkCount
+            << " chunk time: " << statistic.chunkTime << "us"
+            << (scheduler.m_adaptivePolicy ?
+                       fmt::format(" conflict rate: {:.3f} next chunk size: {}",
+                           scheduler.m_adaptivePolicy->conflictRate(),
+                           scheduler.m_adaptivePolicy->chunkSize()) :
+                       std::string{});
+        scheduler.m_lastStatistic = statistic;
+        if (stateHash)
+        {
+            scheduler.m_lastStateHash = stateHash->hash();
+        }
 
         co_return receipts;
     }
@@ -0,0 +1,111 @@
+#pragma once
+#include "bcos-framework/storage/Entry.h"
+#include "bcos-framework/storage2/Storage.h"
+#include "bcos-framework/transaction-executor/TransactionExecutor.h"
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-task/Task.h>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::transaction_scheduler
+{
+
+// XOR of the entry hashes of every key written in a block, the same as scanning the block storage
+// at the end. Each chunk hashes its own entries in parallel, merging only replaces the hash of the
+// keys written again by the later chunks
+class StateHashAccumulator
+{
+public:
+    using EntryHashes =
+        std::vector<std::tuple<transaction_executor::StateKey, crypto::HashType>>;
+
+private:
+    crypto::Hash const& m_hashImpl;
+    uint32_t m_blockVersion;
+    std::unordered_map<transaction_executor::StateKey, crypto::HashType> m_keyHashes;
+    crypto::HashType m_hash;
+
+    crypto::HashType entryHash(
+        transaction_executor::StateKey const& key, transaction_executor::StateValue const* value) const
+    {
+        auto const& [tableName, keyName] = key;
+        if (value != nullptr)
+        {
+            return value->hash(tableName, keyName, m_hashImpl, m_blockVersion);
+        }
+        storage::Entry deleteEntry;
+        deleteEntry.setStatus(storage::Entry::DELETED);
+        return deleteEntry.hash(tableName, keyName, m_hashImpl, m_blockVersion);
+    }
+
+public:
+    StateHashAccumulator(crypto::Hash const& hashImpl, uint32_t blockVersion)
+      : m_hashImpl(hashImpl), m_blockVersion(blockVersion)
+    {}
+
+    // Hash all the entries of the storage
+    task::Task<EntryHashes> hashEntries(auto& storage) const
+    {
+        EntryHashes entryHashes;
+        auto it = co_await storage.seek(storage2::STORAGE_BEGIN);
+        while (co_await it.next())
+        {
+            auto const& key = co_await it.key();
+            if (co_await it.hasValue())
+            {
+                auto&& value = co_await it.value();
+                entryHashes.emplace_back(key, entryHash(key, std::addressof(value)));
+            }
+            else
+            {
+                entryHashes.emplace_back(key, entryHash(key, nullptr));
+            }
+        }
+        co_return entryHashes;
+    }
+
+    // Hash the entries of the keys, a key without value in the storage is taken as deleted
+    task::Task<EntryHashes> hashEntries(
+        auto& storage, RANGES::input_range auto const& keys) const
+    {
+        EntryHashes entryHashes;
+        auto it = co_await storage.read(keys);
+        auto keyIt = RANGES::begin(keys);
+        while (co_await it.next())
+        {
+            auto const& key = *keyIt;
+            if (co_await it.hasValue())
+            {
+                auto&& value = co_await it.value();
+                entryHashes.emplace_back(key, entryHash(key, std::addressof(value)));
+            }
+            else
+            {
+                entryHashes.emplace_back(key, entryHash(key, nullptr));
+            }
+            RANGES::advance(keyIt, 1);
+        }
+        co_return entryHashes;
+    }
+
+    // Entry hashes must be merged in the order the storages are merged
+    void merge(EntryHashes const& entryHashes)
+    {
+        for (auto const& [key, hash] : entryHashes)
+        {
+            auto [it, inserted] = m_keyHashes.try_emplace(key, hash);
+            if (!inserted)
+            {
+                m_hash ^= it->second;
+                it->second = hash;
+            }
+            m_hash ^= hash;
+        }
+    }
+
+    crypto::HashType hash() const { return m_hash; }
+};
+
+}  // namespace bcos::transaction_scheduler
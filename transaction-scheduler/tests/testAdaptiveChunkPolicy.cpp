@@ -0,0 +1,35 @@
+#include <bcos-transaction-scheduler/AdaptiveChunkPolicy.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos::transaction_scheduler;
+
+BOOST_AUTO_TEST_SUITE(TestAdaptiveChunkPolicy)
+
+BOOST_AUTO_TEST_CASE(shrinkAndGrow)
+{
+    AdaptiveChunkPolicy policy(32, 4096, 16, 256);
+    BOOST_CHECK_EQUAL(policy.chunkSize(), 256);
+    BOOST_CHECK_EQUAL(policy.maxToken(100000), 16);
+    BOOST_CHECK_EQUAL(policy.maxToken(512), 2);
+
+    // Half of the chunks conflict
+    policy.update(100, 50, 100 * 1000);
+    BOOST_CHECK_EQUAL(policy.chunkSize(), 128);
+    BOOST_CHECK_EQUAL(policy.maxToken(100000), 8);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        policy.update(100, 50, 100 * 1000);
+    }
+    BOOST_CHECK_EQUAL(policy.chunkSize(), 32);
+
+    // Embarrassingly parallel blocks
+    for (int i = 0; i < 20; ++i)
+    {
+        policy.update(100, 0, 100 * 1000);
+    }
+    BOOST_CHECK_EQUAL(policy.chunkSize(), 4096);
+    BOOST_CHECK_EQUAL(policy.maxToken(1000000), 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
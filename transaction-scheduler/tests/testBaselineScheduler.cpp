@@ -4,6 +4,7 @@
 #include "bcos-scheduler/test/mock/MockLedger.h"
 #include "bcos-tars-protocol/protocol/BlockFactoryImpl.h"
 #include "bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/BlockHeaderImpl.h"
 #include "bcos-tars-protocol/protocol/TransactionFactoryImpl.h"
 #include "bcos-tars-protocol/protocol/TransactionImpl.h"
 #include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
@@ -22,11 +23,14 @@ using namespace bcos::transaction_scheduler;
 
 struct MockExecutor
 {
+    std::atomic<protocol::BlockNumber> lastBlockNumber = -1;
+
     friend task::Task<protocol::TransactionReceipt::Ptr> tag_invoke(
         bcos::transaction_executor::tag_t<bcos::transaction_executor::execute> /*unused*/,
         MockExecutor& executor, auto& storage, protocol::BlockHeader const& blockHeader,
         protocol::Transaction const& transaction, int contextID)
     {
+        executor.lastBlockNumber = blockHeader.number();
         co_return std::shared_ptr<protocol::TransactionReceipt>();
     }
 };
@@ -68,9 +72,19 @@ struct MockLedger
         co_return;
     }
 
+    protocol::BlockNumber blockNumber = 0;
+
     task::Task<bcos::concepts::ledger::Status> getStatus()
     {
-        co_return bcos::concepts::ledger::Status{};
+        co_return bcos::concepts::ledger::Status{.blockNumber = blockNumber};
+    }
+
+    task::Task<protocol::BlockHeader::Ptr> getBlockHeader(protocol::BlockNumber number)
+    {
+        auto blockHeader = std::make_shared<bcostars::protocol::BlockHeaderImpl>(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        blockHeader->setNumber(number);
+        co_return blockHeader;
     }
 
     task::Task<ledger::LedgerConfig> getConfig()
@@ -205,4 +219,75 @@ BOOST_AUTO_TEST_CASE(scheduleBlock)
     // ledger::LedgerConfig::Ptr &&)> callback)
 }
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(pipeline)
+{
+    baselineScheduler.setMaxInflightBlocks(2);
+    baselineScheduler.registerBlockNumberNotifier([](bcos::protocol::BlockNumber) {});
+    baselineScheduler.registerTransactionNotifier(
+        [](bcos::protocol::BlockNumber, bcos::protocol::TransactionSubmitResultsPtr,
+            std::function<void(bcos::Error::Ptr)>) {});
+
+    std::vector<std::promise<std::tuple<bcos::Error::Ptr, bcos::protocol::BlockHeader::Ptr>>>
+        promises(3);
+    auto executeBlock = [&, this](protocol::BlockNumber number) {
+        auto block = std::make_shared<bcostars::protocol::BlockImpl>();
+        auto blockHeader = block->blockHeader();
+        blockHeader->setNumber(number);
+        blockHeader->setVersion(200);
+        blockHeader->calculateHash(*hashImpl);
+
+        bcos::bytes input;
+        block->appendTransaction(transactionFactory->createTransaction(
+            0, "to", input, "12345", 100, "chain", "group", 0));
+
+        auto& promise = promises[number - 500];
+        baselineScheduler.executeBlock(block, false,
+            [&promise](bcos::Error::Ptr&& error, bcos::protocol::BlockHeader::Ptr&& blockHeader,
+                bool sysBlock) {
+                promise.set_value(std::make_tuple(std::move(error), std::move(blockHeader)));
+            });
+        return promise.get_future();
+    };
+
+    // Two blocks execute without commit
+    auto [error500, header500] = executeBlock(500).get();
+    BOOST_CHECK(!error500);
+    auto [error501, header501] = executeBlock(501).get();
+    BOOST_CHECK(!error501);
+
+    // The third one waits for a free slot of the pipeline
+    auto future502 = executeBlock(502);
+    BOOST_CHECK(
+        future502.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+
+    // Committing the oldest block frees the slot
+    std::promise<bcos::Error::Ptr> commitPromise;
+    baselineScheduler.commitBlock(
+        header500, [&](bcos::Error::Ptr&& error, bcos::ledger::LedgerConfig::Ptr&& /*unused*/) {
+            commitPromise.set_value(std::move(error));
+        });
+    BOOST_CHECK(!commitPromise.get_future().get());
+
+    auto [error502, header502] = future502.get();
+    BOOST_CHECK(!error502);
+    BOOST_REQUIRE(header502);
+    BOOST_CHECK_EQUAL(header502->number(), 502);
+}
+
+BOOST_AUTO_TEST_CASE(callOnCurrentBlock)
+{
+    // Nothing committed yet, the call runs on the current block of the ledger
+    mockLedger.blockNumber = 10;
+
+    bcos::bytes input;
+    std::promise<bcos::Error::Ptr> promise;
+    baselineScheduler.call(
+        transactionFactory->createTransaction(0, "to", input, "12345", 100, "chain", "group", 0),
+        [&](bcos::Error::Ptr&& error, protocol::TransactionReceipt::Ptr&& /*unused*/) {
+            promise.set_value(std::move(error));
+        });
+    BOOST_CHECK(!promise.get_future().get());
+    BOOST_CHECK_EQUAL(mockExecutor.lastBlockNumber.load(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+#include "bcos-framework/storage2/MemoryStorage.h"
+#include "bcos-framework/transaction-executor/TransactionExecutor.h"
+#include <bcos-task/Wait.h>
+#include <bcos-transaction-scheduler/CallStorage.h>
+#include <bcos-transaction-scheduler/MultiLayerStorage.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::storage2;
+using namespace bcos::transaction_executor;
+using namespace bcos::transaction_scheduler;
+
+class TestCallStorageFixture
+{
+public:
+    using MutableStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::LOGICAL_DELETION)>;
+    using BackendStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::CONCURRENT),
+        std::hash<StateKey>>;
+
+    TestCallStorageFixture() : multiLayerStorage(backendStorage) {}
+
+    BackendStorage backendStorage;
+    MultiLayerStorage<MutableStorage, void, BackendStorage> multiLayerStorage;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCallStorage, TestCallStorageFixture)
+
+BOOST_AUTO_TEST_CASE(overlay)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        storage::Entry entry;
+        entry.set("snapshot value");
+        co_await storage2::writeOne(
+            backendStorage, StateKey{"test_table", "key1"}, std::move(entry));
+
+        auto snapshot = multiLayerStorage.fork(false);
+        CallStorage<decltype(snapshot), MutableStorage> call1(snapshot);
+        CallStorage<decltype(snapshot), MutableStorage> call2(snapshot);
+
+        auto value = co_await storage2::readOne(call1, StateKey{"test_table", "key1"});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "snapshot value");
+        BOOST_CHECK(!call1.hasWrites());
+
+        storage::Entry newEntry;
+        newEntry.set("call value");
+        co_await storage2::writeOne(call1, StateKey{"test_table", "key1"}, std::move(newEntry));
+        storage::Entry otherEntry;
+        otherEntry.set("other value");
+        co_await storage2::writeOne(call1, StateKey{"test_table", "key2"}, std::move(otherEntry));
+        BOOST_CHECK(call1.hasWrites());
+
+        value = co_await storage2::readOne(call1, StateKey{"test_table", "key1"});
+        BOOST_CHECK_EQUAL(value->get(), "call value");
+        value = co_await storage2::readOne(call1, StateKey{"test_table", "key2"});
+        BOOST_CHECK_EQUAL(value->get(), "other value");
+
+        // Writes of a call are invisible to the snapshot and the other calls
+        value = co_await storage2::readOne(call2, StateKey{"test_table", "key1"});
+        BOOST_CHECK_EQUAL(value->get(), "snapshot value");
+        BOOST_CHECK(!co_await storage2::readOne(call2, StateKey{"test_table", "key2"}));
+        value = co_await storage2::readOne(backendStorage, StateKey{"test_table", "key1"});
+        BOOST_CHECK_EQUAL(value->get(), "snapshot value");
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
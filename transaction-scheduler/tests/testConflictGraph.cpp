@@ -0,0 +1,30 @@
+#include <bcos-transaction-scheduler/ConflictGraph.h>
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+using namespace bcos::transaction_scheduler;
+
+BOOST_AUTO_TEST_SUITE(TestConflictGraph)
+
+BOOST_AUTO_TEST_CASE(groups)
+{
+    std::vector<std::optional<std::vector<std::string>>> predictions{
+        {{"a", "b"}}, {{"c"}}, {{"b", "d"}}, {{"e"}}, {{"d"}}, std::nullopt};
+
+    ConflictGraph<std::string> graph(predictions, 0, 5);
+    auto groups = graph.groups();
+    BOOST_REQUIRE_EQUAL(groups.size(), 3);
+    BOOST_CHECK((groups[0] == std::vector<size_t>{0, 2, 4}));
+    BOOST_CHECK((groups[1] == std::vector<size_t>{1}));
+    BOOST_CHECK((groups[2] == std::vector<size_t>{3}));
+
+    auto bins = graph.bins(2);
+    BOOST_REQUIRE_EQUAL(bins.size(), 2);
+    BOOST_CHECK((bins[0] == std::vector<size_t>{0, 2, 4}));
+    BOOST_CHECK((bins[1] == std::vector<size_t>{1, 3}));
+
+    ConflictGraph<std::string> subGraph(predictions, 3, 5);
+    BOOST_CHECK_EQUAL(subGraph.groups().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
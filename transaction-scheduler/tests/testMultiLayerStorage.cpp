@@ -39,6 +39,73 @@ public:
         storage2::ReadableStorage<decltype(multiLayerStorage.fork(true))>, "No match storage!");
 };
 
+class PrepareMergeBackendStorage : public TestMultiLayerStorageFixture::BackendStorage
+{
+public:
+    using MergeBatch = std::vector<std::tuple<StateKey, std::optional<StateValue>>>;
+    int commitCount = 0;
+    int failCommits = 0;
+
+    task::Task<void> prepareMerge(auto& from, MergeBatch& batch)
+    {
+        auto it = co_await from.seek(storage2::STORAGE_BEGIN);
+        while (co_await it.next())
+        {
+            std::optional<StateValue> value;
+            if (co_await it.hasValue())
+            {
+                value.emplace(co_await it.value());
+            }
+            batch.emplace_back(co_await it.key(), std::move(value));
+        }
+    }
+
+    task::Task<void> commitMerge(MergeBatch& batch)
+    {
+        if (failCommits > 0)
+        {
+            --failCommits;
+            BOOST_THROW_EXCEPTION(std::runtime_error("commit failed"));
+        }
+        auto& storage = static_cast<TestMultiLayerStorageFixture::BackendStorage&>(*this);
+        for (auto& [key, value] : batch)
+        {
+            if (value)
+            {
+                co_await storage2::writeOne(storage, key, std::move(*value));
+            }
+            else
+            {
+                co_await storage2::removeOne(storage, key);
+            }
+        }
+        ++commitCount;
+    }
+};
+
+// The snapshot copies the whole backend, enough for the tests
+class SnapshotBackendStorage : public TestMultiLayerStorageFixture::BackendStorage
+{
+public:
+    using Snapshot = TestMultiLayerStorageFixture::BackendStorage;
+
+    Snapshot snapshot()
+    {
+        Snapshot copy;
+        task::syncWait([&]() -> task::Task<void> {
+            auto it = co_await this->seek(storage2::STORAGE_BEGIN);
+            while (co_await it.next())
+            {
+                if (co_await it.hasValue())
+                {
+                    co_await storage2::writeOne(copy, co_await it.key(), co_await it.value());
+                }
+            }
+        }());
+        return copy;
+    }
+};
+
 BOOST_FIXTURE_TEST_SUITE(TestMultiLayerStorage, TestMultiLayerStorageFixture)
 
 BOOST_AUTO_TEST_CASE(noMutable)
@@ -152,6 +219,159 @@ BOOST_AUTO_TEST_CASE(merge)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(filterAndHitStatistic)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        multiLayerStorage.setEnableFilter(true);
+        multiLayerStorage.setEnableStatistic(true);
+        auto toKey = RANGES::views::transform([](int num) {
+            return StateKey{"test_table", fmt::format("key: {}", num)};
+        });
+        auto toValue = RANGES::views::transform([](int num) {
+            storage::Entry entry;
+            entry.set(fmt::format("value: {}", num));
+
+            return entry;
+        });
+
+        // Two immutable layers: [0, 100) at depth 1 and [100, 200) at depth 0
+        for (auto begin : {0, 100})
+        {
+            multiLayerStorage.newMutable();
+            auto view = multiLayerStorage.fork(true);
+            co_await view.write(RANGES::iota_view<int, int>(begin, begin + 100) | toKey,
+                RANGES::iota_view<int, int>(begin, begin + 100) | toValue);
+            view.release();
+            multiLayerStorage.pushMutableToImmutableFront();
+        }
+        storage::Entry backendEntry;
+        backendEntry.set("backend value");
+        co_await storage2::writeOne(
+            backendStorage, StateKey{"test_table", "key: 1000"}, std::move(backendEntry));
+
+        auto view = multiLayerStorage.fork(false);
+        auto keys = RANGES::iota_view<int, int>(0, 200) | toKey;
+        auto it = co_await view.read(keys);
+        int i = 0;
+        while (co_await it.next())
+        {
+            BOOST_CHECK_EQUAL((co_await it.value()).get(), fmt::format("value: {}", i));
+            ++i;
+        }
+        BOOST_CHECK_EQUAL(i, 200);
+
+        BOOST_REQUIRE(multiLayerStorage.layerHitStatistic() != nullptr);
+        auto const& statistic = *multiLayerStorage.layerHitStatistic();
+        BOOST_CHECK_EQUAL(statistic.mutableHits(), 0);
+        BOOST_CHECK_EQUAL(statistic.immutableHits(0), 100);
+        BOOST_CHECK_EQUAL(statistic.immutableHits(1), 100);
+
+        // Keys only in backend skip the immutable layers
+        for (int num = 0; num < 10; ++num)
+        {
+            auto value = co_await storage2::readOne(view, StateKey{"test_table", "key: 1000"});
+            BOOST_CHECK(value);
+        }
+        BOOST_CHECK_EQUAL(statistic.backendReads(), 10);
+        BOOST_CHECK_GT(statistic.filterSkips(), 0);
+
+        // The extra keys merged into the oldest layer pass its filter in the views forked before
+        MutableStorage extraStorage;
+        storage::Entry extraEntry;
+        extraEntry.set("extra value");
+        co_await storage2::writeOne(
+            extraStorage, StateKey{"test_table", "key: 2000"}, std::move(extraEntry));
+        co_await multiLayerStorage.mergeAndPopImmutableBack(extraStorage);
+        auto extraValue = co_await storage2::readOne(view, StateKey{"test_table", "key: 2000"});
+        BOOST_REQUIRE(extraValue);
+        BOOST_CHECK_EQUAL(extraValue->get(), "extra value");
+        BOOST_CHECK_EQUAL(statistic.immutableHits(1), 101);
+        BOOST_CHECK_EQUAL(statistic.backendReads(), 10);
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(backgroundMerge)
+{
+    task::syncWait([]() -> task::Task<void> {
+        PrepareMergeBackendStorage backend;
+        MultiLayerStorage<TestMultiLayerStorageFixture::MutableStorage, void,
+            PrepareMergeBackendStorage>
+            storage(backend);
+        storage.setBackgroundMerge(true);
+
+        for (auto num : {0, 1})
+        {
+            storage.newMutable();
+            auto view = storage.fork(true);
+            storage::Entry entry;
+            entry.set(fmt::format("value: {}", num));
+            co_await storage2::writeOne(
+                view, StateKey{"test_table", fmt::format("key: {}", num)}, std::move(entry));
+            view.release();
+            storage.pushMutableToImmutableFront();
+        }
+
+        TestMultiLayerStorageFixture::MutableStorage extraStorage;
+        storage::Entry extraEntry;
+        extraEntry.set("extra value");
+        co_await storage2::writeOne(
+            extraStorage, StateKey{"test_table", "key: 0"}, std::move(extraEntry));
+        co_await storage.mergeAndPopImmutableBack(extraStorage);
+        BOOST_CHECK_EQUAL(backend.commitCount, 1);
+
+        auto& backendStorage = static_cast<TestMultiLayerStorageFixture::BackendStorage&>(backend);
+        auto value = co_await storage2::readOne(backendStorage, StateKey{"test_table", "key: 0"});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "extra value");
+        BOOST_CHECK(!co_await storage2::readOne(backendStorage, StateKey{"test_table", "key: 1"}));
+
+        co_await storage.mergeAndPopImmutableBack();
+        BOOST_CHECK_EQUAL(backend.commitCount, 2);
+        value = co_await storage2::readOne(backendStorage, StateKey{"test_table", "key: 1"});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "value: 1");
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(backgroundMergeRetry)
+{
+    task::syncWait([]() -> task::Task<void> {
+        PrepareMergeBackendStorage backend;
+        MultiLayerStorage<TestMultiLayerStorageFixture::MutableStorage, void,
+            PrepareMergeBackendStorage>
+            storage(backend);
+        storage.setBackgroundMerge(true);
+
+        storage.newMutable();
+        auto view = storage.fork(true);
+        storage::Entry entry;
+        entry.set("value: 0");
+        co_await storage2::writeOne(view, StateKey{"test_table", "key: 0"}, std::move(entry));
+        view.release();
+        storage.pushMutableToImmutableFront();
+
+        // The failed merge keeps the layer and reports the error of the backend, the retry
+        // merges it in the foreground
+        backend.failCommits = 1;
+        BOOST_CHECK_THROW(co_await storage.mergeAndPopImmutableBack(), std::runtime_error);
+        BOOST_CHECK_NO_THROW(co_await storage.mergeAndPopImmutableBack());
+        BOOST_CHECK_EQUAL(backend.commitCount, 0);
+
+        auto& backendStorage = static_cast<TestMultiLayerStorageFixture::BackendStorage&>(backend);
+        auto value = co_await storage2::readOne(backendStorage, StateKey{"test_table", "key: 0"});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "value: 0");
+        BOOST_CHECK_THROW(
+            co_await storage.mergeAndPopImmutableBack(), NotExistsImmutableStorageError);
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_CASE(oneMutable)
 {
     multiLayerStorage.newMutable();
@@ -163,4 +383,44 @@ BOOST_AUTO_TEST_CASE(oneMutable)
     auto view4 = multiLayerStorage.fork(true);
 }
 
+BOOST_AUTO_TEST_CASE(forkCommittedSnapshot)
+{
+    task::syncWait([]() -> task::Task<void> {
+        SnapshotBackendStorage backend;
+        MultiLayerStorage<TestMultiLayerStorageFixture::MutableStorage, void,
+            SnapshotBackendStorage>
+            storage(backend);
+
+        auto writeBlock = [&](int num) -> task::Task<void> {
+            storage.newMutable();
+            auto view = storage.fork(true);
+            storage::Entry entry;
+            entry.set(fmt::format("value: {}", num));
+            co_await storage2::writeOne(
+                view, StateKey{"test_table", fmt::format("key: {}", num)}, std::move(entry));
+            view.release();
+            storage.pushMutableToImmutableFront();
+        };
+
+        co_await writeBlock(0);
+        // Block 0 is committing, the view keeps its layer over the backend pinned before it
+        auto committedView = storage.forkCommitted(true);
+        co_await storage.mergeAndPopImmutableBack();
+        co_await writeBlock(1);
+        co_await storage.mergeAndPopImmutableBack();
+
+        auto value = co_await storage2::readOne(committedView, StateKey{"test_table", "key: 0"});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "value: 0");
+        BOOST_CHECK(!co_await storage2::readOne(committedView, StateKey{"test_table", "key: 1"}));
+
+        auto latestView = storage.forkCommitted(false);
+        value = co_await storage2::readOne(latestView, StateKey{"test_table", "key: 1"});
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "value: 1");
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -48,4 +48,48 @@ BOOST_AUTO_TEST_CASE(readWriteSet)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(mergeWriteSet)
+{
+    task::syncWait([]() -> task::Task<void> {
+        Storage storage;
+        ReadWriteSetStorage<decltype(storage), int> writeSet(storage);
+
+        Storage chunkStorage;
+        ReadWriteSetStorage<decltype(chunkStorage), int> chunkSet(chunkStorage);
+        for (auto i : RANGES::views::iota(0, 10000))
+        {
+            co_await storage2::writeOne(chunkSet, i * 2, i);
+        }
+        co_await storage2::writeOne(chunkSet, 2, 1);
+        co_await storage2::readOne(chunkSet, 1);
+        writeSet.mergeWriteSet(chunkSet);
+
+        BOOST_CHECK_EQUAL(RANGES::distance(writeSet.writeKeys()), 10000);
+        BOOST_CHECK(writeSet.hasWrite(19998));
+        BOOST_CHECK(!writeSet.hasWrite(1));
+
+        Storage readStorage;
+        ReadWriteSetStorage<decltype(readStorage), int> readSet(readStorage);
+        co_await storage2::readOne(readSet, 3);
+        co_await storage2::readOne(readSet, 20001);
+        BOOST_CHECK(!writeSet.hasRAWIntersection(readSet));
+        co_await storage2::readOne(readSet, 4);
+        BOOST_CHECK(writeSet.hasRAWIntersection(readSet));
+
+        // The filter grows with the merged writes, the keys added before still hit
+        Storage moreStorage;
+        ReadWriteSetStorage<decltype(moreStorage), int> moreSet(moreStorage);
+        for (auto i : RANGES::views::iota(10000, 100000))
+        {
+            co_await storage2::writeOne(moreSet, i * 2, i);
+        }
+        writeSet.mergeWriteSet(moreSet);
+        BOOST_CHECK_EQUAL(RANGES::distance(writeSet.writeKeys()), 100000);
+        BOOST_CHECK(RANGES::all_of(RANGES::views::iota(0, 100000),
+            [&](int i) { return writeSet.hasWrite(i * 2); }));
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
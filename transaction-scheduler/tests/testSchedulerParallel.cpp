@@ -49,6 +49,23 @@ public:
     bcostars::protocol::TransactionReceiptFactoryImpl receiptFactory;
     MultiLayerStorage<MutableStorage, void, BackendStorage> multiLayerStorage;
     crypto::Hash::Ptr hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+
+    // The input of each transaction is its index, which the mock executors parse
+    static std::vector<std::unique_ptr<bcostars::protocol::TransactionImpl>> makeTransactions(
+        int count)
+    {
+        std::vector<std::unique_ptr<bcostars::protocol::TransactionImpl>> transactions;
+        transactions.reserve(count);
+        for (auto index : RANGES::views::iota(0, count))
+        {
+            auto& transaction =
+                transactions.emplace_back(std::make_unique<bcostars::protocol::TransactionImpl>(
+                    [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); }));
+            auto num = boost::lexical_cast<std::string>(index);
+            transaction->mutableInner().data.input.assign(num.begin(), num.end());
+        }
+        return transactions;
+    }
 };
 
 BOOST_FIXTURE_TEST_SUITE(TestSchedulerParallel, TestSchedulerParallelFixture)
@@ -162,4 +179,274 @@ BOOST_AUTO_TEST_CASE(conflict)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(conflictAware)
+{
+    task::syncWait([]() -> task::Task<void> {
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        auto transactions = makeTransactions(1000);
+        auto transactionRefs =
+            transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; });
+
+        // One transaction per chunk, then the default chunk size
+        for (auto chunkSize : {1LU, 0LU})
+        {
+            MockConflictExecutor executor;
+            SchedulerParallelImpl scheduler;
+            if (chunkSize != 0)
+            {
+                scheduler.setChunkSize(chunkSize);
+            }
+            scheduler.setMaxToken(std::thread::hardware_concurrency());
+            scheduler.setConflictAware(true);
+
+            constexpr static int INITIAL_VALUE = 100000;
+            BackendStorage backend;
+            for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+            {
+                storage::Entry entry;
+                entry.set(boost::lexical_cast<std::string>(INITIAL_VALUE));
+                co_await storage2::writeOne(
+                    backend, StateKey{"t_test", std::to_string(i)}, std::move(entry));
+            }
+            MultiLayerStorage<MutableStorage, void, BackendStorage> storage(backend);
+            storage.newMutable();
+            auto view = storage.fork(true);
+            co_await bcos::transaction_scheduler::execute(
+                scheduler, view, executor, blockHeader, transactionRefs);
+
+            // Conflicting chunks are re-executed in place, no more pass is needed, and every
+            // transaction of them is either re-executed or replayed
+            auto const& statistic = scheduler.lastStatistic();
+            BOOST_CHECK_EQUAL(statistic.retryCount, 1);
+            BOOST_CHECK_GT(statistic.conflictChunkCount, 0);
+            BOOST_CHECK_GE(statistic.reexecuteCount + statistic.replayCount,
+                statistic.conflictChunkCount);
+            BOOST_CHECK_LE(statistic.reexecuteCount + statistic.replayCount,
+                statistic.conflictChunkCount * statistic.chunkSize);
+            if (statistic.chunkSize == 1)
+            {
+                BOOST_CHECK_EQUAL(statistic.reexecuteCount + statistic.replayCount,
+                    statistic.conflictChunkCount);
+            }
+
+            for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+            {
+                auto entry = co_await storage2::readOne(
+                    storage.mutableStorage(), StateKey{"t_test", std::to_string(i)});
+                BOOST_CHECK_EQUAL(boost::lexical_cast<int>(entry->get()), INITIAL_VALUE);
+            }
+        }
+
+        co_return;
+    }());
+}
+
+template <bool completePrediction>
+struct MockPredictExecutor : public MockConflictExecutor
+{
+    friend std::optional<std::vector<StateKey>> tag_invoke(
+        bcos::transaction_executor::tag_t<
+            bcos::transaction_executor::predictConflictKeys> /*unused*/,
+        MockPredictExecutor& executor, protocol::Transaction const& transaction)
+    {
+        auto input = transaction.input();
+        auto inputNum =
+            boost::lexical_cast<int>(std::string_view((const char*)input.data(), input.size()));
+
+        std::vector<StateKey> keys;
+        keys.emplace_back("t_test", std::to_string(inputNum % MOCK_USER_COUNT));
+        if constexpr (completePrediction)
+        {
+            keys.emplace_back(
+                "t_test", std::to_string((inputNum + (MOCK_USER_COUNT / 2)) % MOCK_USER_COUNT));
+        }
+        return keys;
+    }
+};
+
+template <bool completePrediction>
+task::Task<SchedulerParallelImpl::ExecuteStatistic> executePredictTransfers(
+    TestSchedulerParallelFixture& fixture)
+{
+    MockPredictExecutor<completePrediction> executor;
+    SchedulerParallelImpl scheduler;
+    scheduler.setChunkSize(1);
+    scheduler.setMaxToken(8);
+    scheduler.setPredict(true);
+
+    fixture.multiLayerStorage.newMutable();
+    constexpr static int INITIAL_VALUE = 100000;
+    for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+    {
+        StateKey key{"t_test", boost::lexical_cast<std::string>(i)};
+        storage::Entry entry;
+        entry.set(boost::lexical_cast<std::string>(INITIAL_VALUE));
+        co_await storage2::writeOne(
+            fixture.multiLayerStorage.mutableStorage(), key, std::move(entry));
+    }
+
+    bcostars::protocol::BlockHeaderImpl blockHeader(
+        [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+    auto transactions = fixture.makeTransactions(1000);
+    auto transactionRefs =
+        transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; });
+    auto view = fixture.multiLayerStorage.fork(true);
+    co_await bcos::transaction_scheduler::execute(
+        scheduler, view, executor, blockHeader, transactionRefs);
+
+    for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+    {
+        StateKey key{"t_test", boost::lexical_cast<std::string>(i)};
+        auto entry = co_await storage2::readOne(fixture.multiLayerStorage.mutableStorage(), key);
+        BOOST_CHECK_EQUAL(boost::lexical_cast<int>(entry->get()), INITIAL_VALUE);
+    }
+
+    co_return scheduler.lastStatistic();
+}
+
+BOOST_AUTO_TEST_CASE(predicted)
+{
+    auto statistic = task::syncWait(executePredictTransfers<true>(*this));
+    BOOST_CHECK_EQUAL(statistic.predictedCount, 1000);
+    BOOST_CHECK_EQUAL(statistic.predictionFallbackCount, 0);
+}
+
+BOOST_AUTO_TEST_CASE(incompletePrediction)
+{
+    // Wrong predictions are detected after execution and the block falls back to optimistic
+    auto statistic = task::syncWait(executePredictTransfers<false>(*this));
+    BOOST_CHECK_EQUAL(statistic.predictedCount, 0);
+    BOOST_CHECK_EQUAL(statistic.predictionFallbackCount, 1);
+}
+
+class CountingBackendStorage : public TestSchedulerParallelFixture::BackendStorage
+{
+public:
+    std::atomic_size_t readCount = 0;
+    std::atomic_size_t batchReadCount = 0;
+
+    auto read(RANGES::input_range auto&& keys)
+    {
+        ++readCount;
+        if (RANGES::distance(keys) > 1)
+        {
+            ++batchReadCount;
+        }
+        return TestSchedulerParallelFixture::BackendStorage::read(
+            std::forward<decltype(keys)>(keys));
+    }
+};
+
+BOOST_AUTO_TEST_CASE(prefetch)
+{
+    task::syncWait([]() -> task::Task<void> {
+        using CacheStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+            memory_storage::Attribute(memory_storage::CONCURRENT | memory_storage::MRU),
+            std::hash<StateKey>>;
+        constexpr static auto TRANSACTION_COUNT = 1000;
+        constexpr static auto CHUNK_SIZE = 100;
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        auto transactions = makeTransactions(TRANSACTION_COUNT);
+        auto transactionRefs =
+            transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; });
+
+        for (auto prefetch : {false, true})
+        {
+            MockPredictExecutor<true> executor;
+            SchedulerParallelImpl scheduler;
+            scheduler.setChunkSize(CHUNK_SIZE);
+            scheduler.setMaxToken(8);
+            scheduler.setPrefetch(prefetch);
+
+            CountingBackendStorage backend;
+            for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+            {
+                storage::Entry entry;
+                entry.set("100000");
+                co_await storage2::writeOne(
+                    backend, StateKey{"t_test", std::to_string(i)}, std::move(entry));
+            }
+            CacheStorage cache;
+            MultiLayerStorage<TestSchedulerParallelFixture::MutableStorage, CacheStorage,
+                CountingBackendStorage>
+                storage(backend, cache);
+            storage.newMutable();
+            auto view = storage.fork(true);
+            co_await bcos::transaction_scheduler::execute(
+                scheduler, view, executor, blockHeader, transactionRefs);
+
+            if (prefetch)
+            {
+                // At most one batch read for each chunk, the transactions hit the cache
+                BOOST_CHECK_GT(backend.batchReadCount, 0);
+                BOOST_CHECK_LE(backend.readCount, TRANSACTION_COUNT / CHUNK_SIZE);
+            }
+            else
+            {
+                // A read for each user at least, one key at a time
+                BOOST_CHECK_EQUAL(backend.batchReadCount, 0);
+                BOOST_CHECK_GE(backend.readCount, MOCK_USER_COUNT);
+            }
+            for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+            {
+                auto entry = co_await storage2::readOne(
+                    storage.mutableStorage(), StateKey{"t_test", std::to_string(i)});
+                BOOST_REQUIRE(entry);
+                BOOST_CHECK_EQUAL(entry->get(), "100000");
+            }
+        }
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(stateHash)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+        blockHeader.setVersion((uint32_t)bcos::protocol::BlockVersion::V3_1_VERSION);
+        auto transactions = makeTransactions(1000);
+        auto transactionRefs =
+            transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; });
+
+        // Optimistic with re-execution, then predicted
+        for (auto predict : {false, true})
+        {
+            MockPredictExecutor<true> executor;
+            SchedulerParallelImpl scheduler;
+            scheduler.setChunkSize(1);
+            scheduler.setMaxToken(8);
+            scheduler.setConflictAware(true);
+            scheduler.setPredict(predict);
+            scheduler.setStateHashImpl(hashImpl.get());
+
+            BackendStorage backend;
+            for (auto i : RANGES::views::iota(0LU, MOCK_USER_COUNT))
+            {
+                storage::Entry entry;
+                entry.set("100000");
+                co_await storage2::writeOne(
+                    backend, StateKey{"t_test", std::to_string(i)}, std::move(entry));
+            }
+            MultiLayerStorage<MutableStorage, void, BackendStorage> storage(backend);
+            storage.newMutable();
+            auto view = storage.fork(true);
+            co_await bcos::transaction_scheduler::execute(
+                scheduler, view, executor, blockHeader, transactionRefs);
+
+            // Same as scanning the block storage
+            StateHashAccumulator scanHash(*hashImpl, blockHeader.version());
+            scanHash.merge(co_await scanHash.hashEntries(storage.mutableStorage()));
+            BOOST_REQUIRE(scheduler.lastStateHash());
+            BOOST_CHECK_EQUAL(scheduler.lastStateHash()->hex(), scanHash.hash().hex());
+            BOOST_CHECK_NE(scanHash.hash().hex(), crypto::HashType{}.hex());
+        }
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file